@@ -0,0 +1,164 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/String.h"
+#include "Containers/TArray.h"
+
+#include "Time/API/PlatformTime.h"
+
+#include <functional>
+
+/*
+* Declares and registers a benchmark. The body receives a BenchmarkContext called context, setup is done in the
+* body and the code that should be measured is passed to context.Measure
+*/
+#define BENCHMARK(name) \
+	static void STRING_CONCAT(Benchmark_, name)(BenchmarkContext& context); \
+	static BenchmarkRegistrar STRING_CONCAT(s_BenchmarkRegistrar_, name)(#name, STRING_CONCAT(Benchmark_, name)); \
+	static void STRING_CONCAT(Benchmark_, name)(BenchmarkContext& context)
+
+struct BenchmarkSettings
+{
+	uint32	WarmupRepetitions	= 3;
+	uint32	Repetitions			= 15;
+	float64	MinRepetitionTime	= 0.01;	// Seconds, the number of iterations is calibrated so that one repetition takes at least this long
+	LambdaEngine::String	Filter;
+	LambdaEngine::String	JSONPath;
+};
+
+/*
+* A value reported by a benchmark next to its timings, such as the number of bytes produced
+*/
+struct BenchmarkCounter
+{
+	LambdaEngine::String	Name;
+	float64	Value = 0.0;
+};
+
+/*
+* Statistics of a benchmark, times are in nanoseconds per iteration
+*/
+struct BenchmarkResult
+{
+	LambdaEngine::String	Name;
+	uint64	Iterations	= 0;
+	uint32	Repetitions	= 0;
+	float64	Min			= 0.0;
+	float64	Mean		= 0.0;
+	float64	Median		= 0.0;
+	float64	StdDev		= 0.0;
+	float64	P95			= 0.0;
+	LambdaEngine::TArray<BenchmarkCounter> Counters;
+	bool	Failed		= false;
+	LambdaEngine::String	Error;
+};
+
+/*
+* BenchmarkContext
+*	Passed to every benchmark, runs the measured code with warmup and repetitions
+*/
+class BenchmarkContext
+{
+public:
+	BenchmarkContext(const BenchmarkSettings& settings, BenchmarkResult& result);
+
+	/*
+	* Runs func in a loop. The number of iterations is calibrated first, then the loop is repeated WarmupRepetitions
+	* times without being recorded followed by Repetitions recorded repetitions. Should only be called once per benchmark
+	*/
+	template<typename TFunc>
+	void Measure(TFunc func)
+	{
+		// Calibrate by doubling the iterations until one repetition is long enough
+		uint64 iterations = 1;
+		for (;;)
+		{
+			const float64 seconds = RunIterations(func, iterations);
+			if (seconds >= m_Settings.MinRepetitionTime || iterations >= (1ull << 30))
+			{
+				break;
+			}
+
+			iterations *= 2;
+		}
+
+		for (uint32 i = 0; i < m_Settings.WarmupRepetitions; i++)
+		{
+			RunIterations(func, iterations);
+		}
+
+		LambdaEngine::TArray<float64> samples;
+		samples.Reserve(m_Settings.Repetitions);
+		for (uint32 i = 0; i < m_Settings.Repetitions; i++)
+		{
+			const float64 seconds = RunIterations(func, iterations);
+			samples.PushBack((seconds * 1000.0 * 1000.0 * 1000.0) / float64(iterations));
+		}
+
+		Finish(iterations, samples);
+	}
+
+	/*
+	* Reports a value next to the timings of the benchmark, setting the same name again replaces the value
+	*/
+	void SetCounter(const char* pName, float64 value);
+
+	/*
+	* Marks the benchmark as failed, used by benchmarks that check that a feature works before they measure it. A
+	* failed benchmark makes RunBenchmarks return false
+	*/
+	void Fail(const char* pError);
+
+	/*
+	* Prevents the compiler from optimizing away a value that is only computed for the benchmark
+	*/
+	template<typename T>
+	static FORCEINLINE void DoNotOptimize(const T& value)
+	{
+#ifdef LAMBDA_VISUAL_STUDIO
+		s_pSink = static_cast<const volatile void*>(&value);
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+private:
+	template<typename TFunc>
+	FORCEINLINE float64 RunIterations(TFunc& func, uint64 iterations)
+	{
+		const uint64 begin = LambdaEngine::PlatformTime::GetPerformanceCounter();
+		for (uint64 i = 0; i < iterations; i++)
+		{
+			func();
+		}
+
+		const uint64 end = LambdaEngine::PlatformTime::GetPerformanceCounter();
+		return float64(end - begin) / float64(LambdaEngine::PlatformTime::GetPerformanceFrequency());
+	}
+
+	void Finish(uint64 iterations, LambdaEngine::TArray<float64>& samples);
+
+private:
+	const BenchmarkSettings&	m_Settings;
+	BenchmarkResult&			m_Result;
+
+	static const volatile void* s_pSink;
+};
+
+using BenchmarkFunc = void(*)(BenchmarkContext&);
+
+/*
+* BenchmarkRegistrar
+*	Adds a benchmark to the global list during static initialization, use the BENCHMARK macro
+*/
+class BenchmarkRegistrar
+{
+public:
+	BenchmarkRegistrar(const char* pName, BenchmarkFunc func);
+};
+
+/*
+* Runs all registered benchmarks that match the filter and writes the results to the console and to JSON
+*	return - Returns true if all benchmarks ran without failing and the JSON-file could be written
+*/
+bool RunBenchmarks(const BenchmarkSettings& settings);
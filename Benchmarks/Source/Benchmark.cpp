@@ -0,0 +1,208 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+
+struct BenchmarkEntry
+{
+	const char*		pName;
+	BenchmarkFunc	Func;
+};
+
+const volatile void* BenchmarkContext::s_pSink = nullptr;
+
+static LambdaEngine::TArray<BenchmarkEntry>& GetBenchmarks()
+{
+	// Function static so that it is constructed before the first registrar runs
+	static LambdaEngine::TArray<BenchmarkEntry> benchmarks;
+	return benchmarks;
+}
+
+static void WriteEscapedString(FILE* pFile, const char* pString)
+{
+	for (const char* pCurrent = pString; *pCurrent != '\0'; pCurrent++)
+	{
+		if (*pCurrent == '"' || *pCurrent == '\\')
+		{
+			fputc('\\', pFile);
+		}
+
+		fputc(*pCurrent, pFile);
+	}
+}
+
+static bool WriteJSON(const BenchmarkSettings& settings, const LambdaEngine::TArray<BenchmarkResult>& results)
+{
+	FILE* pFile = fopen(settings.JSONPath.c_str(), "w");
+	if (!pFile)
+	{
+		printf("Failed to open '%s'\n", settings.JSONPath.c_str());
+		return false;
+	}
+
+	fprintf(pFile, "{\n\t\"warmup_repetitions\": %u,\n\t\"repetitions\": %u,\n\t\"unit\": \"ns\",\n\t\"benchmarks\": [\n", settings.WarmupRepetitions, settings.Repetitions);
+	for (uint32 i = 0; i < results.GetSize(); i++)
+	{
+		const BenchmarkResult& result = results[i];
+		fputs("\t\t{ \"name\": \"", pFile);
+		WriteEscapedString(pFile, result.Name.c_str());
+		fprintf(pFile, "\", \"iterations\": %llu, \"min\": %.3f, \"mean\": %.3f, \"median\": %.3f, \"stddev\": %.3f, \"p95\": %.3f",
+			(unsigned long long)result.Iterations,
+			result.Min,
+			result.Mean,
+			result.Median,
+			result.StdDev,
+			result.P95);
+
+		if (result.Failed)
+		{
+			fputs(", \"error\": \"", pFile);
+			WriteEscapedString(pFile, result.Error.c_str());
+			fputc('"', pFile);
+		}
+
+		if (!result.Counters.IsEmpty())
+		{
+			fputs(", \"counters\": { ", pFile);
+			for (uint32 j = 0; j < result.Counters.GetSize(); j++)
+			{
+				fputc('"', pFile);
+				WriteEscapedString(pFile, result.Counters[j].Name.c_str());
+				fprintf(pFile, "\": %.3f%s", result.Counters[j].Value, j + 1 < result.Counters.GetSize() ? ", " : " }");
+			}
+		}
+
+		fprintf(pFile, " }%s\n", i + 1 < results.GetSize() ? "," : "");
+	}
+
+	fputs("\t]\n}\n", pFile);
+	fclose(pFile);
+	return true;
+}
+
+/*
+* BenchmarkContext
+*/
+BenchmarkContext::BenchmarkContext(const BenchmarkSettings& settings, BenchmarkResult& result)
+	: m_Settings(settings),
+	m_Result(result)
+{
+}
+
+void BenchmarkContext::SetCounter(const char* pName, float64 value)
+{
+	for (BenchmarkCounter& counter : m_Result.Counters)
+	{
+		if (counter.Name == pName)
+		{
+			counter.Value = value;
+			return;
+		}
+	}
+
+	m_Result.Counters.PushBack({ pName, value });
+}
+
+void BenchmarkContext::Fail(const char* pError)
+{
+	m_Result.Failed	= true;
+	m_Result.Error	= pError;
+}
+
+void BenchmarkContext::Finish(uint64 iterations, LambdaEngine::TArray<float64>& samples)
+{
+	m_Result.Iterations		= iterations;
+	m_Result.Repetitions	= samples.GetSize();
+	if (samples.IsEmpty())
+	{
+		return;
+	}
+
+	std::sort(samples.GetData(), samples.GetData() + samples.GetSize());
+
+	float64 sum = 0.0;
+	for (float64 sample : samples)
+	{
+		sum += sample;
+	}
+
+	const uint32 count = samples.GetSize();
+	m_Result.Mean = sum / float64(count);
+
+	float64 variance = 0.0;
+	for (float64 sample : samples)
+	{
+		variance += (sample - m_Result.Mean) * (sample - m_Result.Mean);
+	}
+
+	m_Result.Min	= samples[0];
+	m_Result.Median	= (count % 2 == 0) ? (samples[count / 2 - 1] + samples[count / 2]) * 0.5 : samples[count / 2];
+	m_Result.StdDev	= count > 1 ? sqrt(variance / float64(count - 1)) : 0.0;
+	m_Result.P95	= samples[std::min(count - 1, uint32(ceil(float64(count) * 0.95)) - 1)];
+}
+
+/*
+* BenchmarkRegistrar
+*/
+BenchmarkRegistrar::BenchmarkRegistrar(const char* pName, BenchmarkFunc func)
+{
+	GetBenchmarks().PushBack({ pName, func });
+}
+
+bool RunBenchmarks(const BenchmarkSettings& settings)
+{
+	LambdaEngine::TArray<BenchmarkEntry> benchmarks = GetBenchmarks();
+	std::sort(benchmarks.GetData(), benchmarks.GetData() + benchmarks.GetSize(), [](const BenchmarkEntry& first, const BenchmarkEntry& second)
+	{
+		return strcmp(first.pName, second.pName) < 0;
+	});
+
+	LambdaEngine::TArray<BenchmarkResult> results;
+	bool hasFailed = false;
+
+	printf("%-48s %12s %12s %12s %12s %12s %12s\n", "Benchmark (ns/iteration)", "Iterations", "Min", "Mean", "Median", "StdDev", "P95");
+	for (const BenchmarkEntry& entry : benchmarks)
+	{
+		if (!settings.Filter.empty() && strstr(entry.pName, settings.Filter.c_str()) == nullptr)
+		{
+			continue;
+		}
+
+		BenchmarkResult result;
+		result.Name = entry.pName;
+
+		BenchmarkContext context(settings, result);
+		entry.Func(context);
+
+		printf("%-48s %12llu %12.2f %12.2f %12.2f %12.2f %12.2f\n",
+			result.Name.c_str(),
+			(unsigned long long)result.Iterations,
+			result.Min,
+			result.Mean,
+			result.Median,
+			result.StdDev,
+			result.P95);
+
+		for (const BenchmarkCounter& counter : result.Counters)
+		{
+			printf("    %-44s %12.2f\n", counter.Name.c_str(), counter.Value);
+		}
+
+		if (result.Failed)
+		{
+			printf("    FAILED: %s\n", result.Error.c_str());
+			hasFailed = true;
+		}
+
+		results.PushBack(result);
+	}
+
+	if (!settings.JSONPath.empty() && !WriteJSON(settings, results))
+	{
+		return false;
+	}
+
+	return !hasFailed;
+}
@@ -0,0 +1,142 @@
+#include "Benchmark.h"
+
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+
+using namespace LambdaEngine;
+
+constexpr const uint32 CONTAINER_ELEMENT_COUNT = 1024;
+
+/*
+* TArray
+*/
+BENCHMARK(TArray_PushBack_Growing)
+{
+	context.Measure([]()
+	{
+		TArray<uint32> array;
+		for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+		{
+			array.PushBack(i);
+		}
+
+		BenchmarkContext::DoNotOptimize(array.GetData());
+	});
+}
+
+BENCHMARK(TArray_PushBack_Reserved)
+{
+	context.Measure([]()
+	{
+		TArray<uint32> array;
+		array.Reserve(CONTAINER_ELEMENT_COUNT);
+		for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+		{
+			array.PushBack(i);
+		}
+
+		BenchmarkContext::DoNotOptimize(array.GetData());
+	});
+}
+
+BENCHMARK(TArray_Insert_Front)
+{
+	context.Measure([]()
+	{
+		TArray<uint32> array;
+		array.Reserve(CONTAINER_ELEMENT_COUNT / 4);
+		for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT / 4; i++)
+		{
+			array.Insert(array.begin(), i);
+		}
+
+		BenchmarkContext::DoNotOptimize(array.GetData());
+	});
+}
+
+BENCHMARK(TArray_Iterate)
+{
+	TArray<uint32> array;
+	for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+	{
+		array.PushBack(i);
+	}
+
+	context.Measure([&]()
+	{
+		uint64 sum = 0;
+		for (uint32 value : array)
+		{
+			sum += value;
+		}
+
+		BenchmarkContext::DoNotOptimize(sum);
+	});
+}
+
+/*
+* THashTable
+*/
+BENCHMARK(THashTable_Insert)
+{
+	context.Measure([]()
+	{
+		THashTable<uint32, uint32> table;
+		for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+		{
+			table[i * 2654435761u] = i;
+		}
+
+		BenchmarkContext::DoNotOptimize(table.size());
+	});
+}
+
+BENCHMARK(THashTable_Find_Hit)
+{
+	THashTable<uint32, uint32> table;
+	for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+	{
+		table[i * 2654435761u] = i;
+	}
+
+	uint32 key = 0;
+	context.Measure([&]()
+	{
+		auto it = table.find((key++ % CONTAINER_ELEMENT_COUNT) * 2654435761u);
+		BenchmarkContext::DoNotOptimize(it);
+	});
+}
+
+BENCHMARK(THashTable_Find_Miss)
+{
+	THashTable<uint32, uint32> table;
+	for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+	{
+		table[i * 2654435761u] = i;
+	}
+
+	uint32 key = 0;
+	context.Measure([&]()
+	{
+		auto it = table.find((key++ % CONTAINER_ELEMENT_COUNT) * 2654435761u + 1);
+		BenchmarkContext::DoNotOptimize(it);
+	});
+}
+
+BENCHMARK(THashTable_Find_String)
+{
+	THashTable<String, uint32> table;
+	TArray<String> keys;
+	for (uint32 i = 0; i < CONTAINER_ELEMENT_COUNT; i++)
+	{
+		keys.PushBack("Resource_" + std::to_string(i));
+		table[keys.GetBack()] = i;
+	}
+
+	uint32 key = 0;
+	context.Measure([&]()
+	{
+		auto it = table.find(keys[key++ % CONTAINER_ELEMENT_COUNT]);
+		BenchmarkContext::DoNotOptimize(it);
+	});
+}
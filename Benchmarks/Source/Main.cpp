@@ -0,0 +1,50 @@
+#include "Benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+* Usage: Benchmarks [--filter <substring>] [--json <file>] [--repetitions <count>] [--warmup <count>] [--min-time <seconds>]
+*/
+int main(int argc, const char* argv[])
+{
+	using namespace LambdaEngine;
+
+	BenchmarkSettings settings;
+	settings.JSONPath = "benchmarks.json";
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--filter") == 0 && hasValue)
+		{
+			settings.Filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--json") == 0 && hasValue)
+		{
+			settings.JSONPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--repetitions") == 0 && hasValue)
+		{
+			settings.Repetitions = uint32(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+		{
+			settings.WarmupRepetitions = uint32(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && hasValue)
+		{
+			settings.MinRepetitionTime = atof(argv[++i]);
+		}
+		else
+		{
+			printf("Usage: %s [--filter <substring>] [--json <file>] [--repetitions <count>] [--warmup <count>] [--min-time <seconds>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	PlatformTime::PreInit();
+
+	return RunBenchmarks(settings) ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#include "Benchmark.h"
+
+#include "Memory/API/Malloc.h"
+
+#include <stdlib.h>
+
+using namespace LambdaEngine;
+
+/*
+* Malloc, the CRT malloc is measured as a baseline
+*/
+BENCHMARK(Malloc_Baseline_CRT_64)
+{
+	context.Measure([]()
+	{
+		void* pMemory = malloc(64);
+		BenchmarkContext::DoNotOptimize(pMemory);
+		free(pMemory);
+	});
+}
+
+BENCHMARK(Malloc_Allocate_64)
+{
+	context.Measure([]()
+	{
+		void* pMemory = Malloc::Allocate(64);
+		BenchmarkContext::DoNotOptimize(pMemory);
+		Malloc::Free(pMemory);
+	});
+}
+
+BENCHMARK(Malloc_Allocate_4096)
+{
+	context.Measure([]()
+	{
+		void* pMemory = Malloc::Allocate(4096);
+		BenchmarkContext::DoNotOptimize(pMemory);
+		Malloc::Free(pMemory);
+	});
+}
+
+BENCHMARK(Malloc_Allocate_Aligned_64)
+{
+	context.Measure([]()
+	{
+		void* pMemory = Malloc::Allocate(64, 64);
+		BenchmarkContext::DoNotOptimize(pMemory);
+		Malloc::Free(pMemory);
+	});
+}
+
+BENCHMARK(Malloc_AllocateDbg_64)
+{
+	context.Measure([]()
+	{
+		void* pMemory = Malloc::AllocateDbg(64, __FILE__, __LINE__);
+		BenchmarkContext::DoNotOptimize(pMemory);
+		Malloc::Free(pMemory);
+	});
+}
+
+BENCHMARK(Malloc_Allocate_Batch_256x64)
+{
+	// Many live allocations at once behaves differently from a single allocate/free pair
+	void* allocations[256];
+	context.Measure([&]()
+	{
+		for (void*& pMemory : allocations)
+		{
+			pMemory = Malloc::Allocate(64);
+		}
+
+		BenchmarkContext::DoNotOptimize(allocations[255]);
+
+		for (void* pMemory : allocations)
+		{
+			Malloc::Free(pMemory);
+		}
+	});
+}
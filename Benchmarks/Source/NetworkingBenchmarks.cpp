@@ -0,0 +1,610 @@
+#include "Benchmark.h"
+
+#include "Networking/API/PacketPool.h"
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/PacketTranscoder.h"
+#include "Networking/API/PacketCompressor.h"
+#include "Networking/API/PacketTransceiver.h"
+#include "Networking/API/NetworkStatistics.h"
+#include "Networking/API/BinaryEncoder.h"
+#include "Networking/API/BinaryDecoder.h"
+#include "Networking/API/NetworkMessageSerializer.h"
+#include "Networking/API/PacketDispatcher.h"
+#include "Networking/API/SnapshotInterpolator.h"
+#include "Networking/API/LagCompensationHistory.h"
+#include "Networking/API/LoopbackSocketUDP.h"
+#include "Networking/API/IPAddress.h"
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/ClientUDP.h"
+#include "Networking/API/ServerUDP.h"
+#include "Networking/API/IClientUDPHandler.h"
+#include "Networking/API/IServerUDPHandler.h"
+#include "Networking/API/NetworkUtils.h"
+
+#include "Engine/EngineLoop.h"
+
+#include "Threading/API/Thread.h"
+
+#include <atomic>
+
+namespace LambdaEngine
+{
+	/*
+	* Gives the benchmarks access to the private parts of PacketTransceiver
+	*/
+	class PacketTransceiverBenchmark
+	{
+	public:
+		static void ProcessAcks(uint32 ack, uint32 ackBits, NetworkStatistics* pStatistics, TArray<uint32>& newAcks)
+		{
+			PacketTransceiver::ProcessAcks(ack, ackBits, pStatistics, newAcks);
+		}
+	};
+
+	/*
+	* Gives the benchmarks access to the fixed tick that EngineLoop normally runs for ClientUDP and ServerUDP
+	*/
+	class NetworkUtilsBenchmark : public NetworkUtils
+	{
+	public:
+		static void FixedTick(Timestamp delta)
+		{
+			NetworkUtils::FixedTick(delta);
+		}
+	};
+}
+
+using namespace LambdaEngine;
+
+constexpr const uint16 BENCHMARK_PACKETS_PER_DATAGRAM	= 8;
+constexpr const uint16 BENCHMARK_PACKET_PAYLOAD_SIZE	= 100;
+
+static void FillPackets(PacketPool& pool, std::queue<NetworkPacket*>& packets)
+{
+	static const char payload[BENCHMARK_PACKET_PAYLOAD_SIZE] = { };
+	for (uint16 i = 0; i < BENCHMARK_PACKETS_PER_DATAGRAM; i++)
+	{
+		NetworkPacket* pPacket = pool.RequestFreePacket();
+		pPacket->SetType(1);
+
+		BinaryEncoder encoder(pPacket);
+		encoder.WriteBuffer(payload, BENCHMARK_PACKET_PAYLOAD_SIZE);
+
+		packets.push(pPacket);
+	}
+}
+
+static void WriteMixedValues(NetworkPacket* pPacket)
+{
+	BinaryEncoder encoder(pPacket);
+	encoder.WriteUInt8(8);
+	encoder.WriteInt16(-16);
+	encoder.WriteUInt32(32);
+	encoder.WriteInt64(-64);
+	encoder.WriteFloat32(3.2f);
+	encoder.WriteFloat64(6.4);
+	encoder.WriteBool(true);
+	encoder.WriteString("PlayerName");
+}
+
+/*
+* PacketPool
+*/
+BENCHMARK(PacketPool_RequestFree)
+{
+	PacketPool pool(256);
+	context.Measure([&]()
+	{
+		NetworkPacket* pPacket = pool.RequestFreePacket();
+		BenchmarkContext::DoNotOptimize(pPacket);
+		pool.FreePacket(pPacket);
+	});
+}
+
+BENCHMARK(PacketPool_RequestFree_Batch_32)
+{
+	PacketPool pool(256);
+	TArray<NetworkPacket*> packets;
+	context.Measure([&]()
+	{
+		pool.RequestFreePackets(32, packets);
+		BenchmarkContext::DoNotOptimize(packets.GetData());
+		pool.FreePackets(packets);
+	});
+}
+
+/*
+* PacketTranscoder, the encode benchmark includes filling the packets since encoding returns them to the pool
+*/
+BENCHMARK(PacketTranscoder_EncodePackets_8x100)
+{
+	PacketPool pool(256);
+	std::set<uint32> reliableUIDsSent;
+	char buffer[MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header)];
+
+	context.Measure([&]()
+	{
+		std::queue<NetworkPacket*> packets;
+		FillPackets(pool, packets);
+
+		PacketTranscoder::Header header;
+		uint16 bytesWritten = 0;
+		PacketTranscoder::EncodePackets(buffer, sizeof(buffer), &pool, packets, reliableUIDsSent, bytesWritten, &header);
+		BenchmarkContext::DoNotOptimize(bytesWritten);
+	});
+}
+
+BENCHMARK(PacketTranscoder_DecodePackets_8x100)
+{
+	PacketPool pool(256);
+	std::set<uint32> reliableUIDsSent;
+	char buffer[MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header)];
+
+	std::queue<NetworkPacket*> packetsToEncode;
+	FillPackets(pool, packetsToEncode);
+
+	PacketTranscoder::Header encodeHeader;
+	uint16 bytesWritten = 0;
+	PacketTranscoder::EncodePackets(buffer, sizeof(buffer), &pool, packetsToEncode, reliableUIDsSent, bytesWritten, &encodeHeader);
+
+	TArray<NetworkPacket*> packets;
+	context.Measure([&]()
+	{
+		PacketTranscoder::Header header;
+		PacketTranscoder::DecodePackets(buffer, bytesWritten, &pool, packets, &header);
+		BenchmarkContext::DoNotOptimize(packets.GetData());
+		pool.FreePackets(packets);
+	});
+}
+
+/*
+* Encodes a datagram of entity updates the way a game server sends them, positions drift a little between entities
+* and most flags and velocities are zero
+*/
+static uint16 EncodeEntityUpdates(PacketPool& pool, char* pBuffer, uint16 bufferSize)
+{
+	std::queue<NetworkPacket*> packets;
+	for (uint16 i = 0; i < BENCHMARK_PACKETS_PER_DATAGRAM; i++)
+	{
+		NetworkPacket* pPacket = pool.RequestFreePacket();
+		pPacket->SetType(1);
+
+		BinaryEncoder encoder(pPacket);
+		for (uint32 entity = 0; entity < 3; entity++)
+		{
+			const uint32 entityID = i * 3 + entity;
+			encoder.WriteUInt32(entityID);
+			encoder.WriteFloat32(100.0f + float32(entityID) * 0.5f);
+			encoder.WriteFloat32(2.0f);
+			encoder.WriteFloat32(-40.0f + float32(entityID) * 0.25f);
+			encoder.WriteFloat32(0.0f);
+			encoder.WriteFloat32(0.0f);
+			encoder.WriteFloat32(0.0f);
+			encoder.WriteUInt16(100);
+			encoder.WriteUInt8(entityID % 3 == 0 ? 1 : 0);
+		}
+
+		packets.push(pPacket);
+	}
+
+	std::set<uint32> reliableUIDsSent;
+	PacketTranscoder::Header header;
+	header.Salt = 0x1234567890ABCDEF;
+	header.Sequence = 1000;
+	uint16 bytesWritten = 0;
+	PacketTranscoder::EncodePackets(pBuffer, bufferSize, &pool, packets, reliableUIDsSent, bytesWritten, &header);
+	return bytesWritten;
+}
+
+static void BenchmarkCompress(BenchmarkContext& context, ECompressionMode mode)
+{
+	PacketPool pool(64);
+	char datagram[MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header)];
+	char compressed[sizeof(datagram)];
+	const uint16 size = EncodeEntityUpdates(pool, datagram, sizeof(datagram));
+
+	uint16 compressedSize = 0;
+	context.Measure([&]()
+	{
+		compressedSize = PacketTranscoder::CompressDatagram(datagram, size, compressed, sizeof(compressed), mode);
+		BenchmarkContext::DoNotOptimize(compressedSize);
+	});
+
+	context.SetCounter("original_bytes", float64(size));
+	context.SetCounter("bytes_saved", compressedSize > 0 ? float64(size - compressedSize) : 0.0);
+}
+
+static void BenchmarkDecompress(BenchmarkContext& context, ECompressionMode mode)
+{
+	PacketPool pool(64);
+	char datagram[MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header)];
+	char compressed[sizeof(datagram)];
+	char decompressed[sizeof(datagram)];
+	const uint16 size = EncodeEntityUpdates(pool, datagram, sizeof(datagram));
+	const uint16 compressedSize = PacketTranscoder::CompressDatagram(datagram, size, compressed, sizeof(compressed), mode);
+
+	context.Measure([&]()
+	{
+		uint16 bytesWritten = 0;
+		PacketTranscoder::DecompressDatagram(compressed, compressedSize, decompressed, sizeof(decompressed), bytesWritten);
+		BenchmarkContext::DoNotOptimize(bytesWritten);
+	});
+
+	context.SetCounter("compressed_bytes", float64(compressedSize));
+}
+
+/*
+* Datagram compression, the counters show the bytes saved on a datagram of entity updates
+*/
+BENCHMARK(PacketTranscoder_CompressDatagram_LZ)
+{
+	BenchmarkCompress(context, COMPRESSION_MODE_LZ);
+}
+
+BENCHMARK(PacketTranscoder_CompressDatagram_Huffman)
+{
+	BenchmarkCompress(context, COMPRESSION_MODE_HUFFMAN);
+}
+
+BENCHMARK(PacketTranscoder_DecompressDatagram_LZ)
+{
+	BenchmarkDecompress(context, COMPRESSION_MODE_LZ);
+}
+
+BENCHMARK(PacketTranscoder_DecompressDatagram_Huffman)
+{
+	BenchmarkDecompress(context, COMPRESSION_MODE_HUFFMAN);
+}
+
+/*
+* BinaryEncoder and BinaryDecoder
+*/
+BENCHMARK(BinaryEncoder_MixedValues)
+{
+	PacketPool pool(16);
+	context.Measure([&]()
+	{
+		NetworkPacket* pPacket = pool.RequestFreePacket();
+		WriteMixedValues(pPacket);
+		BenchmarkContext::DoNotOptimize(pPacket->GetBufferSize());
+		pool.FreePacket(pPacket);
+	});
+}
+
+BENCHMARK(BinaryDecoder_MixedValues)
+{
+	PacketPool pool(16);
+	NetworkPacket* pPacket = pool.RequestFreePacket();
+	WriteMixedValues(pPacket);
+
+	context.Measure([&]()
+	{
+		BinaryDecoder decoder(pPacket);
+		BenchmarkContext::DoNotOptimize(decoder.ReadUInt8());
+		BenchmarkContext::DoNotOptimize(decoder.ReadInt16());
+		BenchmarkContext::DoNotOptimize(decoder.ReadUInt32());
+		BenchmarkContext::DoNotOptimize(decoder.ReadInt64());
+		BenchmarkContext::DoNotOptimize(decoder.ReadFloat32());
+		BenchmarkContext::DoNotOptimize(decoder.ReadFloat64());
+		BenchmarkContext::DoNotOptimize(decoder.ReadBool());
+		BenchmarkContext::DoNotOptimize(decoder.ReadString());
+	});
+
+	pool.FreePacket(pPacket);
+}
+
+/*
+* NetworkMessageSerializer and PacketDispatcher, the same values as above without the string
+*/
+struct BenchmarkMessage
+{
+	static constexpr const uint16 TYPE = 1;
+
+	uint8	UInt8	= 8;
+	int16	Int16	= -16;
+	uint32	UInt32	= 32;
+	int64	Int64	= -64;
+	float32	Float32	= 3.2f;
+	float64	Float64	= 6.4;
+	bool	Bool	= true;
+
+	NETWORK_MESSAGE_FIELDS(
+		&BenchmarkMessage::UInt8, &BenchmarkMessage::Int16, &BenchmarkMessage::UInt32, &BenchmarkMessage::Int64,
+		&BenchmarkMessage::Float32, &BenchmarkMessage::Float64, &BenchmarkMessage::Bool)
+};
+
+class BenchmarkMessageHandler
+{
+public:
+	void OnMessage(IClientUDP* pClient, const BenchmarkMessage& message)
+	{
+		UNREFERENCED_VARIABLE(pClient);
+		Sum += message.UInt32;
+	}
+
+public:
+	uint64 Sum = 0;
+};
+
+BENCHMARK(NetworkMessageSerializer_Encode)
+{
+	PacketPool pool(16);
+	const BenchmarkMessage message;
+	context.Measure([&]()
+	{
+		NetworkPacket* pPacket = pool.RequestFreePacket();
+		NetworkMessageSerializer::Encode(message, pPacket);
+		BenchmarkContext::DoNotOptimize(pPacket->GetBufferSize());
+		pool.FreePacket(pPacket);
+	});
+}
+
+BENCHMARK(NetworkMessageSerializer_Decode)
+{
+	PacketPool pool(16);
+	NetworkPacket* pPacket = pool.RequestFreePacket();
+	NetworkMessageSerializer::Encode(BenchmarkMessage(), pPacket);
+
+	context.Measure([&]()
+	{
+		BenchmarkMessage message;
+		NetworkMessageSerializer::Decode(pPacket, message);
+		BenchmarkContext::DoNotOptimize(message.Int64);
+	});
+
+	pool.FreePacket(pPacket);
+}
+
+BENCHMARK(PacketDispatcher_Dispatch)
+{
+	PacketPool pool(16);
+	NetworkPacket* pPacket = pool.RequestFreePacket();
+	pPacket->SetType(BenchmarkMessage::TYPE);
+	NetworkMessageSerializer::Encode(BenchmarkMessage(), pPacket);
+
+	BenchmarkMessageHandler handler;
+	PacketDispatcher dispatcher;
+	dispatcher.Register<BenchmarkMessage, BenchmarkMessageHandler, &BenchmarkMessageHandler::OnMessage>(&handler);
+
+	context.Measure([&]()
+	{
+		BenchmarkContext::DoNotOptimize(dispatcher.Dispatch(nullptr, pPacket));
+	});
+
+	BenchmarkContext::DoNotOptimize(handler.Sum);
+	pool.FreePacket(pPacket);
+}
+
+/*
+* SnapshotInterpolator
+*/
+constexpr const uint32 BENCHMARK_TRANSFORM_COUNT = 1024;
+
+static void FillTransforms(TArray<NetworkTransform>& from, TArray<NetworkTransform>& to, TArray<float32>& alphas)
+{
+	from.Resize(BENCHMARK_TRANSFORM_COUNT);
+	to.Resize(BENCHMARK_TRANSFORM_COUNT);
+	alphas.Resize(BENCHMARK_TRANSFORM_COUNT);
+	for (uint32 i = 0; i < BENCHMARK_TRANSFORM_COUNT; i++)
+	{
+		const float32 angle = float32(i) * 0.01f;
+		from[i].Position	= glm::vec3(float32(i), 0.0f, 0.0f);
+		from[i].Rotation	= glm::quat(std::cos(angle), 0.0f, std::sin(angle), 0.0f);
+		to[i].Position		= glm::vec3(float32(i), 1.0f, 0.0f);
+		to[i].Rotation		= glm::quat(std::cos(angle + 0.1f), 0.0f, std::sin(angle + 0.1f), 0.0f);
+		alphas[i]			= float32(i % 100) / 100.0f;
+	}
+}
+
+BENCHMARK(SnapshotInterpolator_InterpolateTransforms_1024)
+{
+	TArray<NetworkTransform> from;
+	TArray<NetworkTransform> to;
+	TArray<NetworkTransform> result(BENCHMARK_TRANSFORM_COUNT);
+	TArray<float32> alphas;
+	FillTransforms(from, to, alphas);
+
+	context.Measure([&]()
+	{
+		SnapshotInterpolator::InterpolateTransforms(from.GetData(), to.GetData(), alphas.GetData(), result.GetData(), BENCHMARK_TRANSFORM_COUNT);
+		BenchmarkContext::DoNotOptimize(result[0].Position.x);
+	});
+}
+
+/*
+* The same interpolation with glm, for comparison
+*/
+BENCHMARK(SnapshotInterpolator_InterpolateTransforms_1024_Scalar)
+{
+	TArray<NetworkTransform> from;
+	TArray<NetworkTransform> to;
+	TArray<NetworkTransform> result(BENCHMARK_TRANSFORM_COUNT);
+	TArray<float32> alphas;
+	FillTransforms(from, to, alphas);
+
+	context.Measure([&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_TRANSFORM_COUNT; i++)
+		{
+			const glm::quat toRotation = glm::dot(from[i].Rotation, to[i].Rotation) < 0.0f ? -to[i].Rotation : to[i].Rotation;
+			result[i].Position = glm::mix(from[i].Position, to[i].Position, alphas[i]);
+			result[i].Rotation = glm::normalize(from[i].Rotation + (toRotation - from[i].Rotation) * alphas[i]);
+		}
+		BenchmarkContext::DoNotOptimize(result[0].Position.x);
+	});
+}
+
+/*
+* LagCompensationHistory, a full history of 256 entities spread over a line that the ray passes through
+*/
+static void FillHistory(LagCompensationHistory& history, const LagCompensationHistoryDesc& desc)
+{
+	for (uint32 tick = 0; tick < desc.HistorySize; tick++)
+	{
+		for (uint32 i = 0; i < desc.MaxEntities; i++)
+		{
+			history.SetEntity(i, glm::vec3(float32(i) * 4.0f + float32(tick) * 0.1f, float32(i % 3), 0.0f), 1.0f);
+		}
+		history.RecordTick(Timestamp::MilliSeconds(16.0 * float64(tick + 1)));
+	}
+}
+
+BENCHMARK(LagCompensationHistory_RecordTick_256)
+{
+	LagCompensationHistory history;
+	FillHistory(history, LagCompensationHistoryDesc());
+
+	uint64 tick = LagCompensationHistoryDesc().HistorySize;
+	context.Measure([&]()
+	{
+		history.RecordTick(Timestamp::MilliSeconds(16.0 * float64(++tick)));
+	});
+}
+
+BENCHMARK(LagCompensationHistory_Raycast_256)
+{
+	const LagCompensationHistoryDesc desc;
+	LagCompensationHistory history(desc);
+	FillHistory(history, desc);
+
+	const Timestamp rewindTime = Timestamp::MilliSeconds(16.0 * float64(desc.HistorySize) / 2.0 + 5.0);
+	context.Measure([&]()
+	{
+		LagCompensationHit hit;
+		BenchmarkContext::DoNotOptimize(history.Raycast(rewindTime, glm::vec3(-10.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 10000.0f, UINT32_MAX, hit));
+		BenchmarkContext::DoNotOptimize(hit.Distance);
+	});
+}
+
+/*
+* PacketTransceiver
+*/
+BENCHMARK(PacketTransceiver_ProcessAcks)
+{
+	NetworkStatistics statistics;
+	TArray<uint32> newAcks;
+	uint32 ack = 0;
+
+	context.Measure([&]()
+	{
+		newAcks.Clear();
+		PacketTransceiverBenchmark::ProcessAcks(++ack, UINT32_MAX, &statistics, newAcks);
+		BenchmarkContext::DoNotOptimize(newAcks.GetData());
+	});
+}
+
+/*
+* LoopbackSocketUDP, one datagram sent and received on the same thread
+*/
+BENCHMARK(LoopbackSocketUDP_SendReceive_1024)
+{
+	LoopbackSocketUDP sender;
+	LoopbackSocketUDP receiver;
+	sender.Bind(IPEndPoint(IPAddress::ANY, 0));
+	receiver.Bind(IPEndPoint(IPAddress::ANY, 0));
+
+	const IPEndPoint destination(IPAddress::LOOPBACK, receiver.GetEndPoint().GetPort());
+	char buffer[MAXIMUM_PACKET_SIZE] = { };
+	IPEndPoint source;
+
+	context.Measure([&]()
+	{
+		int32 bytesSent = 0;
+		int32 bytesReceived = 0;
+		sender.SendTo(buffer, MAXIMUM_PACKET_SIZE, bytesSent, destination);
+		receiver.ReceiveFrom(buffer, MAXIMUM_PACKET_SIZE, bytesReceived, source);
+		BenchmarkContext::DoNotOptimize(bytesReceived);
+	});
+}
+
+/*
+* ClientUDP connecting to a ServerUDP over LoopbackSocketUDP. Fails if the handshake does not complete, the counter
+* is the time the handshake took
+*/
+class LoopbackClientHandler : public IClientUDPHandler
+{
+public:
+	virtual void OnConnectingUDP(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); }
+	virtual void OnConnectedUDP(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); IsConnected = true; }
+	virtual void OnDisconnectingUDP(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); }
+	virtual void OnDisconnectedUDP(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); }
+	virtual void OnPacketReceivedUDP(IClientUDP* pClient, NetworkPacket* pPacket) override { UNREFERENCED_VARIABLE(pClient); UNREFERENCED_VARIABLE(pPacket); }
+	virtual void OnLargePacketReceivedUDP(IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size) override { UNREFERENCED_VARIABLE(pClient); UNREFERENCED_VARIABLE(packetType); UNREFERENCED_VARIABLE(pData); UNREFERENCED_VARIABLE(size); }
+	virtual void OnLargePacketFailedUDP(IClientUDP* pClient, uint16 packetType) override { UNREFERENCED_VARIABLE(pClient); UNREFERENCED_VARIABLE(packetType); }
+	virtual void OnServerFullUDP(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); }
+
+public:
+	std::atomic_bool IsConnected = false;
+};
+
+class LoopbackServerHandler : public IServerUDPHandler
+{
+public:
+	virtual void OnClientConnected(IClientUDP* pClient) override { UNREFERENCED_VARIABLE(pClient); }
+	virtual IClientUDPRemoteHandler* CreateClientUDPHandler() override { return &RemoteHandler; }
+
+public:
+	// The server calls the remote handler from its receiver thread
+	LoopbackClientHandler RemoteHandler;
+};
+
+BENCHMARK(ClientUDP_ConnectLoopback)
+{
+	constexpr const uint16 port = 4450;
+	static const Timestamp TIMEOUT		= Timestamp::Seconds(2);
+	static const Timestamp TICK_DELTA	= Timestamp::MilliSeconds(1000.0 / 60.0);
+
+	if (!EngineLoop::PreInit(true) || !EngineLoop::Init())
+	{
+		context.Fail("The engine could not be initialized");
+		return;
+	}
+
+	// The handlers are used by the server threads until PostRelease has joined them
+	LoopbackServerHandler serverHandler;
+	LoopbackClientHandler clientHandler;
+
+	ServerUDP* pServer = ServerUDP::Create(&serverHandler, 1, 64, 10);
+	pServer->SetUseLoopback(true);
+
+	ClientUDP* pClient = ClientUDP::Create(&clientHandler, 64, 10);
+	pClient->SetUseLoopback(true);
+	pClient->SetPolled(true);
+
+	const Timestamp begin = EngineLoop::GetPreciseTimeSinceStart();
+	Timestamp lastTick = begin;
+	Timestamp now = begin;
+
+	bool isConnected = false;
+	if (pServer->Start(IPEndPoint(IPAddress::ANY, port)) && pClient->Connect(IPEndPoint(IPAddress::LOOPBACK, port)))
+	{
+		// Both sides have to finish the handshake, the fixed tick resends connect requests that arrive before the server is bound
+		while (!isConnected && now - begin < TIMEOUT)
+		{
+			pClient->Poll();
+			pServer->Flush();
+
+			if (now - lastTick >= TICK_DELTA)
+			{
+				NetworkUtilsBenchmark::FixedTick(TICK_DELTA);
+				lastTick = now;
+			}
+
+			isConnected = pClient->IsConnected() && clientHandler.IsConnected && serverHandler.RemoteHandler.IsConnected;
+			Thread::Sleep(1);
+			now = EngineLoop::GetPreciseTimeSinceStart();
+		}
+	}
+
+	context.SetCounter("connect_ms", (now - begin).AsMilliSeconds());
+	if (!isConnected)
+	{
+		context.Fail("ClientUDP did not connect to ServerUDP over loopback");
+	}
+
+	pClient->Release();
+	pServer->Release();
+
+	EngineLoop::Release();
+	EngineLoop::PostRelease();
+}
@@ -105,6 +105,19 @@ void Client::OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, LambdaEngine
     LOG_MESSAGE("OnPacketReceivedUDP(%s)", pPacket->ToString().c_str());
 }
 
+void Client::OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size)
+{
+    UNREFERENCED_VARIABLE(pClient);
+    UNREFERENCED_VARIABLE(pData);
+    LOG_MESSAGE("OnLargePacketReceivedUDP(%u, %u bytes)", packetType, size);
+}
+
+void Client::OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType)
+{
+    UNREFERENCED_VARIABLE(pClient);
+    LOG_WARNING("OnLargePacketFailedUDP(%u)", packetType);
+}
+
 void Client::OnServerFullUDP(LambdaEngine::IClientUDP* pClient)
 {
     UNREFERENCED_VARIABLE(pClient);
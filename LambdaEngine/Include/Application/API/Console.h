@@ -20,6 +20,11 @@ namespace LambdaEngine
 		
 		static void Show()	{ }
 		static void Close()	{ }
+
+		/*
+		* Uses the console that the process was started from instead of creating a new one, used by console applications
+		*/
+		static void Attach() { }
 		
 		static void Print(const char*, ...)				{ }
 		static void PrintLine(const char*, ...)			{ }
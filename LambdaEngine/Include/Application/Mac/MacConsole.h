@@ -16,6 +16,7 @@ namespace LambdaEngine
     public:
         static void Show();
         static void Close();
+        static void Attach();
         
         static void Print(const char* pFormat, ...);
         static void PrintLine(const char* pFormat, ...);
@@ -29,6 +30,7 @@ namespace LambdaEngine
         
     private:
         static CocoaConsoleWindow* s_pConsoleWindow;
+        static bool s_IsAttached;
     };
 
     typedef MacConsole PlatformConsole;
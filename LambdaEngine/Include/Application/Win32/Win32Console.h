@@ -12,6 +12,7 @@ namespace LambdaEngine
 	public:
 		static void Show();
 		static void Close();
+		static void Attach();
 
 		static void Print(const char*, ...);
 		static void PrintLine(const char* pFormat, ...);
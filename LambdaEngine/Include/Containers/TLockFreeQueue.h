@@ -0,0 +1,148 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include <atomic>
+#include <utility>
+
+namespace LambdaEngine
+{
+	/*
+	* TLockFreeQueue
+	*	Bounded multi-producer multi-consumer queue. Each cell carries a sequence number that tells producers
+	*	and consumers if the cell is free to write or ready to read, so neither side ever takes a lock.
+	*	The capacity is rounded up to the next power of two. TryPush fails instead of blocking when the
+	*	queue is full, and TryPop fails when the queue is empty.
+	*/
+	template<typename T>
+	class TLockFreeQueue
+	{
+		struct Cell
+		{
+			std::atomic<uint64>	Sequence;
+			T					Data;
+		};
+
+	public:
+		DECL_REMOVE_COPY(TLockFreeQueue);
+		DECL_REMOVE_MOVE(TLockFreeQueue);
+
+		TLockFreeQueue(uint32 capacity)
+			: m_pCells(nullptr),
+			m_Mask(0),
+			m_EnqueuePos(0),
+			m_DequeuePos(0)
+		{
+			uint32 size = 2;
+			while (size < capacity)
+			{
+				size <<= 1;
+			}
+
+			m_pCells	= DBG_NEW Cell[size];
+			m_Mask		= size - 1;
+
+			for (uint32 i = 0; i < size; i++)
+			{
+				m_pCells[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		~TLockFreeQueue()
+		{
+			SAFEDELETE_ARRAY(m_pCells);
+		}
+
+		template<typename TValue>
+		bool TryPush(TValue&& value)
+		{
+			Cell* pCell = nullptr;
+			uint64 position = m_EnqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				pCell = &m_pCells[position & m_Mask];
+
+				const uint64 sequence	= pCell->Sequence.load(std::memory_order_acquire);
+				const int64 difference	= int64(sequence) - int64(position);
+				if (difference == 0)
+				{
+					if (m_EnqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_EnqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			pCell->Data = std::forward<TValue>(value);
+			pCell->Sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool TryPop(T& value)
+		{
+			Cell* pCell = nullptr;
+			uint64 position = m_DequeuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				pCell = &m_pCells[position & m_Mask];
+
+				const uint64 sequence	= pCell->Sequence.load(std::memory_order_acquire);
+				const int64 difference	= int64(sequence) - int64(position + 1);
+				if (difference == 0)
+				{
+					if (m_DequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_DequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			value = std::move(pCell->Data);
+			pCell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+			return true;
+		}
+
+		/*
+		* return - An approximation of the number of elements in the queue, exact only when no other thread uses the queue
+		*/
+		FORCEINLINE uint32 GetSize() const
+		{
+			const uint64 enqueuePos = m_EnqueuePos.load(std::memory_order_relaxed);
+			const uint64 dequeuePos = m_DequeuePos.load(std::memory_order_relaxed);
+			return enqueuePos > dequeuePos ? uint32(enqueuePos - dequeuePos) : 0;
+		}
+
+		FORCEINLINE uint32 GetCapacity() const
+		{
+			return uint32(m_Mask + 1);
+		}
+
+		FORCEINLINE bool IsEmpty() const
+		{
+			return GetSize() == 0;
+		}
+
+	private:
+		Cell*	m_pCells;
+		uint64	m_Mask;
+
+		// Producers and consumers are kept on separate cache lines to avoid false sharing
+		alignas(64) std::atomic<uint64> m_EnqueuePos;
+		alignas(64) std::atomic<uint64> m_DequeuePos;
+	};
+}
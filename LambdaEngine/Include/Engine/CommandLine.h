@@ -0,0 +1,32 @@
+#pragma once
+#include "LambdaEngine.h"
+
+namespace LambdaEngine
+{
+	/*
+	* Gives the game access to the command line that the executable was started with. Options are written as
+	* --name or --name value
+	*/
+	class LAMBDA_API CommandLine
+	{
+	public:
+		DECL_STATIC_CLASS(CommandLine);
+
+		/*
+		* Called by the launcher before the engine is initialized
+		*/
+		static void Init(int32 argc, const char* const argv[]);
+
+		/*
+		* return - True if the option was passed
+		*/
+		static bool HasOption(const char* pName);
+
+		/*
+		* return - The argument after the option, or pDefault if the option was not passed or has no value
+		*/
+		static const char* GetString(const char* pName, const char* pDefault = nullptr);
+		static int32 GetInt32(const char* pName, int32 defaultValue);
+		static float32 GetFloat32(const char* pName, float32 defaultValue);
+	};
+}
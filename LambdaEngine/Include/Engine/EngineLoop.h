@@ -18,9 +18,11 @@ namespace LambdaEngine
 
 		/*
 		* Initializes modules that are needed in EngineLoop::Init()
-		*	return - Returns true if successfull
+		*	isHeadless	- Runs the engine without window, input, rendering, audio and resources. The loop then sleeps
+		*				  until the next fixed tick and exits on SIGINT or SIGTERM
+		*	return		- Returns true if successfull
 		*/
-		static bool PreInit();
+		static bool PreInit(bool isHeadless = false);
 
 		/*
 		* Initializes all engine modules
@@ -46,6 +48,57 @@ namespace LambdaEngine
 		static bool PostRelease();
 
         static Timestamp GetTimeSinceStart();
+
+		/*
+		* Reads the performance counter instead of returning the time at the start of the current frame. Same timeline as
+		* GetTimeSinceStart, used where an error of one frame matters, for example when synchronizing clocks
+		*/
+		static Timestamp GetPreciseTimeSinceStart();
+
+		/*
+		* Returns true if the engine was started without window, input, rendering and audio
+		*/
+		static bool IsHeadless();
+
+		/*
+		* Makes the loop exit after the current frame, the same as receiving SIGINT when running headless
+		*/
+		static void RequestExit();
+
+		/*
+		* Sets how many times per second FixedTick is called, the default is 60. The new rate is used from the next frame
+		*	ticksPerSecond - Must be larger than zero
+		*/
+		static void SetFixedTickRate(float64 ticksPerSecond);
+
+		/*
+		* Returns the time between two FixedTicks, safe to call from any thread
+		*/
+		static Timestamp GetFixedTimestep();
+
+		/*
+		* Returns the number of FixedTicks that have run since the loop started, safe to call from any thread
+		*/
+		static uint64 GetFixedTickCount();
+
+		/*
+		* Limits the number of frames per second, the loop sleeps and then spins for the rest of each frame.
+		* When running headless the loop always waits for the next fixed tick
+		*	framesPerSecond - Target framerate, zero disables the limit (Default)
+		*/
+		static void SetFrameRateLimit(float64 framesPerSecond);
+
+		/*
+		* Sets the maximum number of FixedTicks that run during one frame when the loop has fallen behind. Time that
+		* could not be caught up with is dropped. The default is 5
+		*/
+		static void SetMaxFixedTicksPerFrame(uint32 maxFixedTicks);
+
+		/*
+		* Returns how far between the last and the next fixed tick the current frame is, in the range [0, 1). Used in
+		* Game::Tick to interpolate between the two latest simulated states
+		*/
+		static float64 GetFixedTickAlpha();
         
 	private:
 		/*
@@ -56,9 +109,9 @@ namespace LambdaEngine
 		static bool Tick(Timestamp delta);
         
         /*
-        * Fixed engine tick, advances the whole engine one frame at a fixed framerate (Current every 16ms).
+        * Fixed engine tick, advances the whole engine one frame at a fixed framerate (See SetFixedTickRate).
         * Should only be called from run
-        *	delta - The time between this frame and the last frame
+        *	delta - The fixed timestep
         */
         static void FixedTick(Timestamp delta);
 	};
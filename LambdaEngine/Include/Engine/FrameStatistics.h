@@ -0,0 +1,93 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/String.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	/*
+	* Summary of the frames currently in the rolling window of FrameStatistics, all times are in milliseconds
+	*/
+	struct FrameStatisticsSummary
+	{
+		uint32	FrameCount			= 0;
+		float64	MinFrameTime		= 0.0;
+		float64	AvgFrameTime		= 0.0;
+		float64	MaxFrameTime		= 0.0;
+		float64	P50FrameTime		= 0.0;
+		float64	P95FrameTime		= 0.0;
+		float64	P99FrameTime		= 0.0;
+		uint32	Hitches				= 0;
+		uint32	CatchUpFrames		= 0;
+		uint32	MaxFixedTicks		= 0;
+	};
+
+	/*
+	* FrameStatistics
+	*	Collects the frametime of every frame that EngineLoop runs into a rolling window. Frames that takes
+	*	longer than the frame budget are counted as hitches, and frames that had to run more than one
+	*	fixed tick to catch up are counted as catch-up frames.
+	*/
+	class LAMBDA_API FrameStatistics
+	{
+		friend class EngineLoop;
+
+	public:
+		DECL_STATIC_CLASS(FrameStatistics);
+
+		/*
+		* Sets the budget that frames are measured against, a frame that takes longer is counted as a hitch
+		*	budget - Maximum allowed frametime, default is 1/30 s
+		*/
+		static void SetFrameBudget(Timestamp budget);
+		static Timestamp GetFrameBudget();
+
+		/*
+		* Calculates min, avg, max and percentiles over the rolling window
+		*	return - The summary of the frames in the current window
+		*/
+		static FrameStatisticsSummary GetSummary();
+
+		/*
+		* return - The total number of hitches since start, not only the ones in the rolling window
+		*/
+		static uint64 GetTotalHitches();
+		static uint64 GetTotalFrames();
+
+		/*
+		* Clears the rolling window and all counters
+		*/
+		static void Reset();
+
+		/*
+		* Renders an overlay with the summary, a frametime graph and a frametime histogram
+		*/
+		static void RenderStatisticsWithImGUI();
+
+		/*
+		* Writes every frame in the rolling window as a row in a CSV-file
+		*	filepath	- Path to the file that should be written
+		*	return		- Returns true if the file was written successfully
+		*/
+		static bool ExportFramesCSV(const String& filepath);
+
+		/*
+		* Appends the current summary as a single row to a CSV-file, a header is written if the file is new.
+		* Meant for automated performance runs where each run adds one line to the same file.
+		*	filepath	- Path to the file that should be appended to
+		*	label		- Label for the row, for example a build or commit identifier
+		*	return		- Returns true if the file was written successfully
+		*/
+		static bool AppendSummaryCSV(const String& filepath, const String& label);
+
+	private:
+		/*
+		* Registers a frame, called by EngineLoop once per frame
+		*	delta		- The time between this frame and the last frame
+		*	fixedTicks	- Number of fixed ticks that was executed during this frame
+		*/
+		static void RegisterFrame(Timestamp delta, uint32 fixedTicks);
+	};
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	class IPEndPoint;
+
+	/*
+	* Records a session into a binary file and plays it back deterministically. A recording contains the seed of Random,
+	* the frame delta and the keyboard and mouse state of every frame, and all datagrams received by every
+	* PacketTransceiver tagged with the frame they arrived in. During playback the recorded deltas and input replace the live ones, datagrams are handed
+	* to the same transceiver in the same frame and nothing is sent on the real sockets. Recording or playback should
+	* be started before the game is created so that the transceivers get the same stream IDs, and so that the salts and
+	* keys of the networking objects are generated from the restored seed
+	*/
+	class LAMBDA_API Replay
+	{
+		friend class EngineLoop;
+		friend class PacketTransceiver;
+
+	public:
+		DECL_STATIC_CLASS(Replay);
+
+		/*
+		* Starts recording from the next frame
+		*	pFilepath	- File to write the recording to
+		*	return		- Returns true if the file could be created
+		*/
+		static bool BeginRecording(const char* pFilepath);
+		static void EndRecording();
+
+		/*
+		* Loads a recording and plays it back from the next frame, the engine exits when the last frame has been played
+		*	pFilepath	- Recording to play
+		*	return		- Returns true if the file could be loaded
+		*/
+		static bool BeginPlayback(const char* pFilepath);
+		static void EndPlayback();
+
+		static bool IsRecording();
+		static bool IsPlaying();
+
+		/*
+		* Returns the index of the current frame in the recording or playback
+		*/
+		static uint32 GetFrameIndex();
+
+	private:
+		/*
+		* Called by EngineLoop at the start of a frame. Replaces delta with the recorded one during playback
+		*	return - Returns false when the playback has reached the end
+		*/
+		static bool BeginFrame(Timestamp& delta);
+
+		/*
+		* Called by EngineLoop after the platform events have been processed. Records the input state, or replaces it with
+		* the recorded state during playback
+		*/
+		static void SyncInput();
+
+		/*
+		* Gives a transceiver an ID that stays the same between recording and playback as long as transceivers are
+		* created in the same order
+		*/
+		static uint32 RegisterStream();
+
+		static void RecordDatagram(uint32 stream, const IPEndPoint& sender, const char* pBuffer, int32 size);
+
+		/*
+		* Waits a short while for the next recorded datagram of the stream that belongs to the current frame
+		*	return - Returns true if a datagram was written to pBuffer
+		*/
+		static bool PlaybackDatagram(uint32 stream, IPEndPoint& sender, char* pBuffer, int32 bufferSize, int32& size);
+	};
+}
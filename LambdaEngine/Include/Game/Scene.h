@@ -152,6 +152,7 @@ namespace LambdaEngine
 		uint32 AddAreaLight(const AreaLightObject& lightObject, const glm::mat4& transform = glm::mat4(1.0f));
 
 		void UpdateCamera(const Camera* pCamera);
+		void UpdateCamera(const CameraData& camera);
 
 		void UpdateMaterialProperties(GUID_Lambda materialGUID);
 
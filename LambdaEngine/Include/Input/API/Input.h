@@ -7,6 +7,8 @@ namespace LambdaEngine
 {
 	class LAMBDA_API Input : public EventHandler
 	{
+		friend class Replay;
+
 	private:
 		Input()		= default;
 		~Input()	= default;
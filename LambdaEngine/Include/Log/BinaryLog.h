@@ -0,0 +1,189 @@
+#pragma once
+#include "Log/Log.h"
+#include "Log/BinaryLogFormat.h"
+
+#include "Utilities/StringHash.h"
+
+#include <atomic>
+#include <type_traits>
+
+/*
+* Logs to the binary log. The format string is registered once per call site and only the raw arguments are
+* written for every entry, formatting happens later in the LogDecoder tool. Arguments must be integers, floats,
+* pointers or C-strings. When the binary log is not initialized the entry is printed with the text log instead.
+*	LOG_BINARY_RATE limits a call site to maxPerSecond entries, entries above the limit are counted and the count
+*	is written with the next entry that gets through. A limit of zero disables the rate limiting.
+*/
+#define LOG_BINARY_RATE(severity, maxPerSecond, format, ...) \
+	do \
+	{ \
+		constexpr uint32 binaryLogCallSiteID = LambdaEngine::HashString(format) ^ (LambdaEngine::HashString(__FILE__) * 31u) ^ (uint32(__LINE__) * 2654435761u); \
+		static LambdaEngine::BinaryLogCallSite binaryLogCallSite(binaryLogCallSiteID, severity, __FILE__, __LINE__, format, maxPerSecond); \
+		LambdaEngine::BinaryLog::Write(binaryLogCallSite, ##__VA_ARGS__); \
+	} while (false)
+
+#define LOG_BINARY(severity, format, ...)	LOG_BINARY_RATE(severity, 0, format, ##__VA_ARGS__)
+#define LOG_BINARY_INFO(format, ...)		LOG_BINARY(LambdaEngine::ELogSeverity::LOG_INFO, format, ##__VA_ARGS__)
+#define LOG_BINARY_WARNING(format, ...)		LOG_BINARY(LambdaEngine::ELogSeverity::LOG_WARNING, format, ##__VA_ARGS__)
+#define LOG_BINARY_ERROR(format, ...)		LOG_BINARY(LambdaEngine::ELogSeverity::LOG_ERROR, format, ##__VA_ARGS__)
+
+namespace LambdaEngine
+{
+	constexpr const uint32 BINARY_LOG_MAX_ARGUMENT_SIZE = 192;
+
+	/*
+	* BinaryLogCallSite
+	*	Static data for a single LOG_BINARY call site, created by the macro
+	*/
+	struct BinaryLogCallSite
+	{
+		constexpr BinaryLogCallSite(uint32 id, ELogSeverity severity, const char* pFile, uint32 line, const char* pFormat, uint32 maxPerSecond)
+			: ID(id),
+			Severity(severity),
+			pFile(pFile),
+			Line(line),
+			pFormat(pFormat),
+			MaxPerSecond(maxPerSecond),
+			WindowStart(0),
+			WindowCount(0),
+			Suppressed(0)
+		{
+		}
+
+		const uint32		ID;
+		const ELogSeverity	Severity;
+		const char* const	pFile;
+		const uint32		Line;
+		const char* const	pFormat;
+		const uint32		MaxPerSecond;
+
+		std::atomic<uint64>	WindowStart;
+		std::atomic<uint32>	WindowCount;
+		std::atomic<uint32>	Suppressed;
+	};
+
+	/*
+	* A single entry waiting to be written by the binary log thread
+	*/
+	struct BinaryLogRecord
+	{
+		const BinaryLogCallSite*	pCallSite		= nullptr;
+		uint64						Timestamp		= 0;
+		uint32						ThreadID		= 0;
+		uint32						Suppressed		= 0;
+		uint16						ArgumentSize	= 0;
+		uint8						Arguments[BINARY_LOG_MAX_ARGUMENT_SIZE];
+	};
+
+	/*
+	* BinaryLog
+	*	Writes log entries in a compact binary format on a background thread, see BinaryLogFormat.h for the layout
+	*/
+	class LAMBDA_API BinaryLog
+	{
+	public:
+		DECL_STATIC_CLASS(BinaryLog);
+
+		/*
+		* Opens the log file and starts the background thread
+		*	pFilepath	- Path to the binary log file, the file is overwritten
+		*	return		- Returns true if the file could be opened
+		*/
+		static bool Init(const char* pFilepath = "LambdaEngine.blog");
+
+		/*
+		* Writes all entries still in the queue, stops the background thread and closes the file
+		*/
+		static void Release();
+
+		static bool IsRunning();
+
+		template<typename... TArgs>
+		static void Write(BinaryLogCallSite& callSite, const TArgs&... args)
+		{
+			BinaryLogRecord record;
+			if (!BeginRecord(callSite, record))
+			{
+				return;
+			}
+
+			if (!IsRunning())
+			{
+				Log::Print(callSite.Severity, callSite.pFormat, args...);
+				return;
+			}
+
+			(WriteArgument(record, args), ...);
+			EndRecord(record);
+		}
+
+	private:
+		/*
+		* Applies the rate limit of the call site and fills in the header of the record
+		*	return - Returns false if the entry should be dropped
+		*/
+		static bool BeginRecord(BinaryLogCallSite& callSite, BinaryLogRecord& record);
+		static void EndRecord(const BinaryLogRecord& record);
+
+		template<typename T>
+		static void WriteArgument(BinaryLogRecord& record, const T& value)
+		{
+			using TType = std::decay_t<T>;
+			if constexpr (std::is_same_v<TType, char*> || std::is_same_v<TType, const char*>)
+			{
+				const char* pString = value ? value : "(null)";
+				uint16 length = 0;
+				while (pString[length] != '\0' && length < UINT16_MAX)
+				{
+					length++;
+				}
+
+				WriteBytes(record, EBinaryLogArgument::ARGUMENT_STRING, &length, sizeof(length));
+				WriteBytes(record, pString, length);
+			}
+			else if constexpr (std::is_pointer_v<TType>)
+			{
+				const uint64 address = uint64(reinterpret_cast<uintptr_t>(value));
+				WriteBytes(record, EBinaryLogArgument::ARGUMENT_POINTER, &address, sizeof(address));
+			}
+			else if constexpr (std::is_floating_point_v<TType>)
+			{
+				const float64 payload = float64(value);
+				WriteBytes(record, EBinaryLogArgument::ARGUMENT_FLOAT64, &payload, sizeof(payload));
+			}
+			else if constexpr (std::is_enum_v<TType>)
+			{
+				WriteArgument(record, static_cast<std::underlying_type_t<TType>>(value));
+			}
+			else if constexpr (std::is_signed_v<TType>)
+			{
+				const int64 payload = int64(value);
+				WriteBytes(record, EBinaryLogArgument::ARGUMENT_INT64, &payload, sizeof(payload));
+			}
+			else
+			{
+				static_assert(std::is_integral_v<TType>, "Argument type is not supported by the binary log");
+
+				const uint64 payload = uint64(value);
+				WriteBytes(record, EBinaryLogArgument::ARGUMENT_UINT64, &payload, sizeof(payload));
+			}
+		}
+
+		FORCEINLINE static void WriteBytes(BinaryLogRecord& record, EBinaryLogArgument type, const void* pPayload, uint32 size)
+		{
+			const uint8 tag = uint8(type);
+			WriteBytes(record, &tag, sizeof(tag));
+			WriteBytes(record, pPayload, size);
+		}
+
+		FORCEINLINE static void WriteBytes(BinaryLogRecord& record, const void* pData, uint32 size)
+		{
+			// Arguments that do not fit are cut, the decoder stops at the end of the argument data
+			const uint32 available = BINARY_LOG_MAX_ARGUMENT_SIZE - record.ArgumentSize;
+			size = size < available ? size : available;
+
+			memcpy(record.Arguments + record.ArgumentSize, pData, size);
+			record.ArgumentSize += uint16(size);
+		}
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Types.h"
+
+/*
+* Layout of the files written by BinaryLog. This header only depends on Types.h so that tools that decode
+* the log (see LogDecoder) can include it without linking against the engine.
+*
+* A file starts with a BinaryLogFileHeader, followed by blocks. Every block starts with a uint8 that holds
+* an EBinaryLogBlock. A call-site block is always written before the first entry that references it.
+*	BLOCK_CALL_SITE	- BinaryLogCallSiteHeader, followed by FileLength chars and FormatLength chars
+*	BLOCK_ENTRY		- BinaryLogEntryHeader, followed by ArgumentSize bytes of arguments
+*
+* Every argument starts with a uint8 that holds an EBinaryLogArgument followed by the payload. Integers,
+* floats and pointers are widened to 8 bytes. Strings are written as a uint16 length followed by the chars.
+*/
+
+namespace LambdaEngine
+{
+	constexpr const uint32 BINARY_LOG_MAGIC		= 0x474F4C42; // "BLOG"
+	constexpr const uint16 BINARY_LOG_VERSION	= 1;
+
+	enum class EBinaryLogBlock : uint8
+	{
+		BLOCK_CALL_SITE	= 0,
+		BLOCK_ENTRY		= 1,
+	};
+
+	enum class EBinaryLogArgument : uint8
+	{
+		ARGUMENT_INT64		= 0,
+		ARGUMENT_UINT64		= 1,
+		ARGUMENT_FLOAT64	= 2,
+		ARGUMENT_STRING		= 3,
+		ARGUMENT_POINTER	= 4,
+	};
+
+#pragma pack(push, 1)
+	struct BinaryLogFileHeader
+	{
+		uint32	Magic;
+		uint16	Version;
+		uint64	TimerFrequency;
+	};
+
+	struct BinaryLogCallSiteHeader
+	{
+		uint32	ID;
+		uint8	Severity;
+		uint32	Line;
+		uint16	FileLength;
+		uint16	FormatLength;
+	};
+
+	struct BinaryLogEntryHeader
+	{
+		uint32	ID;
+		uint32	ThreadID;
+		uint64	Timestamp;
+		uint32	Suppressed;
+		uint16	ArgumentSize;
+	};
+#pragma pack(pop)
+}
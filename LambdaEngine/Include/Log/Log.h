@@ -57,6 +57,26 @@ namespace LambdaEngine
 	class LAMBDA_API Log
 	{
 	public:
+		/*
+		* Starts the background thread that writes messages to the console and to the log file. Until Init is
+		* called, and after Release, messages are written synchronously on the calling thread
+		* 
+		* pFilepath - Path to the log file, older files are rotated to <name>.1.log, <name>.2.log etc.
+		* return	- Returns true if the background thread was started
+		*/
+		static bool Init(const char* pFilepath = "LambdaEngine.log");
+
+		/*
+		* Waits for messages that are being pushed by other threads, writes all messages still in the queue and stops the
+		* background thread. Safe to call while other threads are logging
+		*/
+		static void Release();
+
+		/*
+		* Blocks until the background thread has written all messages currently in the queue
+		*/
+		static void Flush();
+
 		/*
 		* Prints a message to the log
 		* 
@@ -86,6 +106,11 @@ namespace LambdaEngine
 		{
 			s_DebuggerOutputEnabled = enable;
 		}
+
+		FORCEINLINE static bool IsDebuggerOutputEnabled()
+		{
+			return s_DebuggerOutputEnabled;
+		}
 		
 	private:
 		static bool s_DebuggerOutputEnabled;
@@ -18,6 +18,12 @@ namespace LambdaEngine
 
 		static void PreInit();
 
+		/*
+		* Restarts the generator, used by Replay so that a playback generates the same salts and keys as the recording
+		*/
+		static void Seed(uint32 seed);
+		static uint32 GetSeed();
+
 		static int32   Int32(int32 min, int32 max);
 		static float32 Float32(float32 min, float32 max);
 
@@ -27,6 +33,7 @@ namespace LambdaEngine
 
 	private:
 		static std::default_random_engine s_Generator;
+		static uint32 s_Seed;
 	};
 }
 
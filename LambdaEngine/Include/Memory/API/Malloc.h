@@ -49,6 +49,12 @@ namespace LambdaEngine
 		
 		static void SetDebugFlags(uint16 debugFlags);
 
+		/*
+		* return - The number of allocations and frees made through Malloc since start
+		*/
+		static uint64 GetAllocationCount();
+		static uint64 GetFreeCount();
+
 	private:
 		static void* AllocateProtected(uint64 sizeInBytes);
 		static void* AlignAddress(void* pAddress, uint64 alignment);
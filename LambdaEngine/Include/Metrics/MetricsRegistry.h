@@ -0,0 +1,240 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/String.h"
+#include "Containers/TArray.h"
+
+#include "Time/API/Timestamp.h"
+
+#include <atomic>
+#include <functional>
+
+namespace LambdaEngine
+{
+	enum class EMetricType : uint8
+	{
+		METRIC_TYPE_COUNTER		= 0,
+		METRIC_TYPE_GAUGE		= 1,
+		METRIC_TYPE_HISTOGRAM	= 2,
+	};
+
+	/*
+	* Metric
+	*	Base of all metrics, metrics are created and owned by MetricsRegistry
+	*/
+	class LAMBDA_API Metric
+	{
+		friend class MetricsRegistry;
+
+	public:
+		DECL_REMOVE_COPY(Metric);
+		DECL_REMOVE_MOVE(Metric);
+
+		virtual ~Metric() = default;
+
+		FORCEINLINE const String& GetName() const
+		{
+			return m_Name;
+		}
+
+		FORCEINLINE const String& GetHelp() const
+		{
+			return m_Help;
+		}
+
+		FORCEINLINE EMetricType GetType() const
+		{
+			return m_Type;
+		}
+
+	protected:
+		Metric(const String& name, const String& help, EMetricType type)
+			: m_Name(name),
+			m_Help(help),
+			m_Type(type)
+		{
+		}
+
+	private:
+		String		m_Name;
+		String		m_Help;
+		EMetricType	m_Type;
+	};
+
+	/*
+	* MetricCounter
+	*	Value that only increases, exported as a total and as a rate per second
+	*/
+	class LAMBDA_API MetricCounter : public Metric
+	{
+		friend class MetricsRegistry;
+
+	public:
+		FORCEINLINE void Add(uint64 value = 1)
+		{
+			m_Value.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		FORCEINLINE uint64 GetValue() const
+		{
+			return m_Value.load(std::memory_order_relaxed);
+		}
+
+	private:
+		MetricCounter(const String& name, const String& help)
+			: Metric(name, help, EMetricType::METRIC_TYPE_COUNTER),
+			m_Value(0)
+		{
+		}
+
+	private:
+		std::atomic<uint64>		m_Value;
+		std::function<uint64()>	m_Sampler;
+	};
+
+	/*
+	* MetricGauge
+	*	Value that can go up and down
+	*/
+	class LAMBDA_API MetricGauge : public Metric
+	{
+		friend class MetricsRegistry;
+
+	public:
+		FORCEINLINE void Set(float64 value)
+		{
+			m_Value.store(value, std::memory_order_relaxed);
+		}
+
+		FORCEINLINE void Add(float64 value)
+		{
+			float64 current = m_Value.load(std::memory_order_relaxed);
+			while (!m_Value.compare_exchange_weak(current, current + value, std::memory_order_relaxed));
+		}
+
+		FORCEINLINE float64 GetValue() const
+		{
+			return m_Value.load(std::memory_order_relaxed);
+		}
+
+	private:
+		MetricGauge(const String& name, const String& help)
+			: Metric(name, help, EMetricType::METRIC_TYPE_GAUGE),
+			m_Value(0.0)
+		{
+		}
+
+	private:
+		std::atomic<float64>		m_Value;
+		std::function<float64()>	m_Sampler;
+	};
+
+	/*
+	* MetricHistogram
+	*	Counts observations in buckets with fixed upper bounds. Values above the last bound end up in an overflow bucket
+	*/
+	class LAMBDA_API MetricHistogram : public Metric
+	{
+		friend class MetricsRegistry;
+
+	public:
+		~MetricHistogram();
+
+		void Observe(float64 value);
+
+		/*
+		* Copies the current state of the histogram
+		*	bucketCounts	- Receives the number of observations per bucket, the last element is the overflow bucket
+		*	sum				- Receives the sum of all observations
+		*	return			- The total number of observations
+		*/
+		uint64 GetValues(TArray<uint64>& bucketCounts, float64& sum) const;
+
+		FORCEINLINE const TArray<float64>& GetUpperBounds() const
+		{
+			return m_UpperBounds;
+		}
+
+	private:
+		MetricHistogram(const String& name, const String& help, const TArray<float64>& upperBounds);
+
+	private:
+		TArray<float64>			m_UpperBounds;
+		std::atomic<uint64>*	m_pBucketCounts;
+		std::atomic<uint64>		m_Count;
+		std::atomic<float64>	m_Sum;
+	};
+
+	/*
+	* The value of a single metric at the time of a snapshot
+	*/
+	struct MetricSample
+	{
+		const Metric*	pMetric		= nullptr;
+		float64			Value		= 0.0;	// Total for counters, value for gauges and number of observations for histograms
+		float64			Rate		= 0.0;	// Change per second since the previous snapshot, for counters and histograms
+		float64			Sum			= 0.0;	// Sum of all observations for histograms
+		TArray<uint64>	BucketCounts;		// Observations per bucket for histograms
+	};
+
+	/*
+	* MetricsRegistry
+	*	Engine wide registry of metrics. Subsystems register their metrics once and keep the returned pointer, which
+	*	stays valid until Release. Once per snapshot interval the registry samples every metric and writes the
+	*	snapshot to the export files that have been set.
+	*/
+	class LAMBDA_API MetricsRegistry
+	{
+	public:
+		DECL_STATIC_CLASS(MetricsRegistry);
+
+		/*
+		* Registers a metric, registering a name that already exists with the same type returns the existing metric
+		*	name	- Name of the metric, should follow the Prometheus naming (lowercase, underscores and a unit suffix)
+		*	help	- Description of the metric
+		*	return	- The metric, or nullptr if the name is already used by a metric of another type
+		*/
+		static MetricCounter*	RegisterCounter(const String& name, const String& help);
+		static MetricGauge*		RegisterGauge(const String& name, const String& help);
+		static MetricHistogram*	RegisterHistogram(const String& name, const String& help, const TArray<float64>& upperBounds);
+
+		/*
+		* Registers a metric that is not updated by the subsystem, instead sampler is called when a snapshot is taken
+		*/
+		static MetricCounter*	RegisterSampledCounter(const String& name, const String& help, const std::function<uint64()>& sampler);
+		static MetricGauge*		RegisterSampledGauge(const String& name, const String& help, const std::function<float64()>& sampler);
+
+		/*
+		* Sets the file that the snapshots are written to in the Prometheus text format. The file is replaced
+		* atomically so that a scraper never reads a partially written file. An empty path disables the export.
+		*/
+		static void SetPrometheusExportPath(const String& filepath);
+
+		/*
+		* Sets the file that the snapshots are appended to as CSV rows (time, name, value, rate). An empty path disables the export.
+		*/
+		static void SetCSVExportPath(const String& filepath);
+
+		static void SetSnapshotInterval(Timestamp interval);
+
+		/*
+		* Takes a snapshot and exports it when the snapshot interval has passed, called once per frame by EngineLoop
+		*/
+		static void Tick();
+
+		/*
+		* Samples all metrics and exports the result
+		*/
+		static void TakeSnapshot();
+
+		/*
+		* return - A copy of the latest snapshot
+		*/
+		static TArray<MetricSample> GetSnapshot();
+
+		/*
+		* Deletes all metrics, pointers returned from the register functions are invalid after this call
+		*/
+		static void Release();
+	};
+}
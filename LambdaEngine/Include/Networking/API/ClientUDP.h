@@ -3,9 +3,13 @@
 #include "Networking/API/NetWorker.h"
 #include "Networking/API/IClientUDP.h"
 #include "Networking/API/PacketManager.h"
+#include "Networking/API/FragmentManager.h"
+#include "Networking/API/ClockSynchronizer.h"
 #include "Networking/API/IPacketListener.h"
 #include "Networking/API/PacketTransceiver.h"
 
+#include <array>
+
 namespace LambdaEngine
 {
 	class IClientUDPHandler;
@@ -18,6 +22,9 @@ namespace LambdaEngine
 	{
 		friend class NetworkUtils;
 
+		using PacketHandler			= void(ClientUDP::*)(NetworkPacket*);
+		using PacketHandlerTable	= std::array<PacketHandler, NetworkPacket::INTERNAL_TYPE_COUNT>;
+
 	public:
 		~ClientUDP();
 
@@ -26,6 +33,8 @@ namespace LambdaEngine
 		virtual bool IsConnected() override;
 		virtual bool SendUnreliable(NetworkPacket* packet) override;
 		virtual bool SendReliable(NetworkPacket* packet, IPacketListener* listener = nullptr) override;
+		virtual bool SendLarge(uint16 packetType, const char* pData, uint32 size) override;
+		virtual void SetChannelType(uint8 channel, EChannelType type) override;
 		virtual const IPEndPoint& GetEndPoint() const override;
 		virtual NetworkPacket* GetFreePacket(uint16 packetType) override;
 		virtual EClientState GetState() const override;
@@ -35,6 +44,36 @@ namespace LambdaEngine
 
 		void SetSimulateReceivingPacketLoss(float32 lossRatio);
 		void SetSimulateTransmittingPacketLoss(float32 lossRatio);
+		void SetSimulatedConditions(const NetworkConditions& conditions);
+
+		/*
+		* Uses an in-process LoopbackSocketUDP instead of an OS socket, takes effect the next time the client connects
+		*	useLoopback - True to only talk to other loopback sockets in the same process
+		*/
+		void SetUseLoopback(bool useLoopback);
+
+		/*
+		* Runs the client without its own transmitter and receiver threads, Poll has to be called regularly instead. Used
+		* to run many clients on a few threads, takes effect the next time the client connects
+		*/
+		void SetPolled(bool isPolled);
+
+		/*
+		* Receives the datagrams that have arrived and sends the queued packets without blocking. Only used by polled
+		* clients, must not be called from two threads at once or after Release
+		*	return - True if a datagram was received
+		*/
+		bool Poll();
+
+		/*
+		* Compresses the datagrams sent by this client, see PacketManager::SetCompressionMode
+		*/
+		void SetCompressionMode(ECompressionMode mode);
+
+		/*
+		* return - The estimated time and tick of the server, synchronized over TYPE_PING while connected
+		*/
+		const ClockSynchronizer* GetClockSynchronizer() const;
 
 	protected:
 		ClientUDP(IClientUDPHandler* pHandler, uint16 packetPoolSize, uint8 maximumTries);
@@ -55,7 +94,16 @@ namespace LambdaEngine
 	private:
 		void SendConnectRequest();
 		void SendDisconnectRequest();
+		void SendPing();
+		void HandleReceivedDatagram();
 		void HandleReceivedPacket(NetworkPacket* pPacket);
+		void HandleChallenge(NetworkPacket* pPacket);
+		void HandlePing(NetworkPacket* pPacket);
+		void HandleAccepted(NetworkPacket* pPacket);
+		void HandleDisconnect(NetworkPacket* pPacket);
+		void HandleServerFull(NetworkPacket* pPacket);
+		void HandleFragment(NetworkPacket* pPacket);
+		void HandleApplicationPacket(NetworkPacket* pPacket);
 		void TransmitPackets();
 		void Tick(Timestamp delta);
 
@@ -64,19 +112,28 @@ namespace LambdaEngine
 
 	private:
 		static void FixedTickStatic(Timestamp timestamp);
+		static PacketHandlerTable CreatePacketHandlers();
 
 	private:
 		ISocketUDP* m_pSocket;
 		PacketTransceiver m_Transciver;
 		PacketManager m_PacketManager;
+		FragmentManager m_FragmentManager;
+		ClockSynchronizer m_ClockSynchronizer;
 		SpinLock m_Lock;
 		IClientUDPHandler* m_pHandler;
 		EClientState m_State;
 		std::atomic_bool m_SendDisconnectPacket;
+		std::atomic_bool m_ChallengeAnswered;
+		Timestamp m_TimeSinceConnectRequest;
+		uint32 m_ConnectRequestsSent;
+		bool m_UseLoopback;
+		bool m_IsPolled;
 		char m_pSendBuffer[MAXIMUM_PACKET_SIZE];
 
 	private:
 		static std::set<ClientUDP*> s_Clients;
 		static SpinLock s_Lock;
+		static const PacketHandlerTable s_PacketHandlers;
 	};
 }
\ No newline at end of file
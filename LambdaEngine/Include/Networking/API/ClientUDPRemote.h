@@ -4,18 +4,25 @@
 #include "Networking/API/IClientUDP.h"
 #include "Networking/API/IPacketListener.h"
 #include "Networking/API/PacketManager.h"
+#include "Networking/API/FragmentManager.h"
+
+#include <array>
 
 namespace LambdaEngine
 {
 	class ServerUDP;
 	class IClientUDPRemoteHandler;
 	class PacketTransceiver;
+	class PacketArena;
 
 	class LAMBDA_API ClientUDPRemote : 
 		public IClientUDP,
 		protected IPacketListener
 	{
 		friend class ServerUDP;
+
+		using PacketHandler			= bool(ClientUDPRemote::*)(NetworkPacket*);
+		using PacketHandlerTable	= std::array<PacketHandler, NetworkPacket::INTERNAL_TYPE_COUNT>;
 		
 	public:
 		~ClientUDPRemote();
@@ -25,13 +32,15 @@ namespace LambdaEngine
 		virtual bool IsConnected() override;
 		virtual bool SendUnreliable(NetworkPacket* packet) override;
 		virtual bool SendReliable(NetworkPacket* packet, IPacketListener* listener = nullptr) override;
+		virtual bool SendLarge(uint16 packetType, const char* pData, uint32 size) override;
+		virtual void SetChannelType(uint8 channel, EChannelType type) override;
 		virtual const IPEndPoint& GetEndPoint() const override;
 		virtual NetworkPacket* GetFreePacket(uint16 packetType) override;
 		virtual EClientState GetState() const override;
 		virtual const NetworkStatistics* GetStatistics() const override;
 
 	protected:
-		ClientUDPRemote(uint16 packetPoolSize, uint8 maximumTries, const IPEndPoint& ipEndPoint, ServerUDP* pServer);
+		ClientUDPRemote(PacketArena* pPacketArena, uint16 packetQuota, uint8 maximumTries, const IPEndPoint& ipEndPoint, uint64 salt, ServerUDP* pServer);
 
 		virtual PacketManager* GetPacketManager() override;
 
@@ -43,16 +52,29 @@ namespace LambdaEngine
 		void OnDataReceived(PacketTransceiver* pTransciver);
 		void SendPackets(PacketTransceiver* pTransciver);
 		bool HandleReceivedPacket(NetworkPacket* pPacket);
+		bool HandleConnect(NetworkPacket* pPacket);
+		bool HandleChallenge(NetworkPacket* pPacket);
+		bool HandlePing(NetworkPacket* pPacket);
+		bool HandleDisconnect(NetworkPacket* pPacket);
+		bool HandleFragment(NetworkPacket* pPacket);
+		bool HandleApplicationPacket(NetworkPacket* pPacket);
 		void Tick(Timestamp delta);
 
+	private:
+		static PacketHandlerTable CreatePacketHandlers();
+
 	private:
 		ServerUDP* m_pServer;
 		PacketManager m_PacketManager;
+		FragmentManager m_FragmentManager;
 		SpinLock m_Lock;
 		IClientUDPRemoteHandler* m_pHandler;
 		EClientState m_State;
 		std::atomic_bool m_Release;
 		bool m_DisconnectedByRemote;
 		char m_pSendBuffer[MAXIMUM_PACKET_SIZE];
+
+	private:
+		static const PacketHandlerTable s_PacketHandlers;
 	};
 }
\ No newline at end of file
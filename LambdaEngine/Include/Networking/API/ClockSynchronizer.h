@@ -0,0 +1,117 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	class NetworkPacket;
+
+	/*
+	* ClockSynchronizer
+	*	Estimates the time and fixed tick of the server on a client. The client sends TYPE_PING with its send time t0,
+	*	the server answers with the time it received the ping t1, the time it answered t2 and its tick count. With t3 as
+	*	the time the answer arrived, every answer is one NTP sample with the offset ((t1 - t0) + (t2 - t3)) / 2, which is
+	*	exact when both directions take the same time. Samples that were delayed in one direction have a longer round
+	*	trip, so samples more than one standard deviation above the median round trip are rejected and the offsets of
+	*	the rest are averaged.
+	*
+	*	A new estimate is not applied at once. The offset is slewed by at most 5% of the elapsed time, so that the server
+	*	time seen by interpolation never jumps or runs backwards, unless it is off by more than 100 ms. All times are on
+	*	the timeline of EngineLoop::GetPreciseTimeSinceStart.
+	*/
+	class LAMBDA_API ClockSynchronizer
+	{
+	private:
+		struct Sample
+		{
+			int64 Offset;		// Nanoseconds
+			int64 RoundTrip;	// Nanoseconds
+			float64 TickOffset;	// Server tick count minus the server time in ticks
+		};
+
+		static constexpr const uint32 SAMPLE_COUNT = 16;
+
+	public:
+		ClockSynchronizer();
+		~ClockSynchronizer() = default;
+
+		/*
+		* Slews the offset and keeps the ping schedule, called from the fixed tick of the client
+		*	return - True if a ping should be sent
+		*/
+		bool Tick(Timestamp delta);
+
+		/*
+		* Called on the client when the answer to a ping arrives
+		*	return - False if the answer was malformed or too old to be used
+		*/
+		bool OnPongReceived(NetworkPacket* pPong);
+
+		/*
+		* return - True once enough samples have arrived for the estimate to be used
+		*/
+		bool IsSynchronized() const;
+
+		/*
+		* return - The estimated time since the server started
+		*/
+		Timestamp GetServerTime() const;
+
+		/*
+		* return - The estimated fixed tick of the server, the fraction is how far into the next tick the server is
+		*/
+		float64 GetServerTick() const;
+
+		/*
+		* return - The fixed timestep of the server
+		*/
+		Timestamp GetServerTimestep() const;
+
+		/*
+		* return - Server time minus client time in nanoseconds
+		*/
+		int64 GetOffset() const;
+
+		/*
+		* return - The mean round trip of the samples that the estimate is based on
+		*/
+		Timestamp GetRoundTrip() const;
+
+		void Reset();
+
+	private:
+		void UpdateEstimate();
+
+	public:
+		/*
+		* Writes the current time into a TYPE_PING packet on the client
+		*/
+		static void WritePing(NetworkPacket* pPing);
+
+		/*
+		* Answers a ping on the server
+		*	pPing		- The ping from the client
+		*	pPong		- A TYPE_PING packet that is sent back
+		*	receiveTime	- When the ping was received
+		*	return		- False if the ping was malformed
+		*/
+		static bool WritePong(NetworkPacket* pPing, NetworkPacket* pPong, Timestamp receiveTime);
+
+	private:
+		mutable SpinLock m_Lock;
+		Sample m_Samples[SAMPLE_COUNT];
+		uint32 m_SampleCount;
+		uint32 m_NextSample;
+		Timestamp m_TimeSincePing;
+		int64 m_Offset;
+		int64 m_TargetOffset;
+		int64 m_RoundTrip;
+		float64 m_TickOffset;
+		uint64 m_ServerTimestep;
+		bool m_IsSynchronized;
+	};
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	struct CongestionControllerDesc
+	{
+		uint32	InitialRate			= 64 * 1024;	// Bytes per second
+		uint32	MinRate				= 8 * 1024;
+		uint32	MaxRate				= 4 * 1024 * 1024;
+		float32	DecreaseFactor		= 0.7f;			// Rate multiplier on a loss event
+		float32	RetransmitShare		= 0.5f;			// Share of the rate that retransmits may use
+		float32	BurstWindowMS		= 10.0f;		// Bytes the pacer may send at once, expressed as time at the current rate. Never less than the time between flushes
+		float32	MaxQueueDelayMS		= 250.0f;		// Unreliable messages waiting longer than this at the current rate are dropped
+	};
+
+	/*
+	* CongestionController
+	*	Per connection AIMD send rate with a token bucket pacer. The rate grows by one datagram per round trip while
+	*	acks arrive without loss and is multiplied by DecreaseFactor at most once per round trip when messages time out.
+	*	The rate is also capped at twice the delivery rate measured from acks, so a connection that has been idle can not
+	*	burst at a rate the link has never carried. Retransmits draw from a separate bucket so that a burst of timeouts can
+	*	not turn into a retransmit storm.
+	*/
+	class LAMBDA_API CongestionController
+	{
+	public:
+		CongestionController(const CongestionControllerDesc& desc = CongestionControllerDesc());
+		~CongestionController() = default;
+
+		/*
+		* return - True if the pacer has tokens left, a datagram may overdraw the bucket and is paid back later
+		*/
+		bool CanSend(Timestamp timestamp);
+		void OnSent(uint32 bytes);
+
+		/*
+		* Takes bytes from the retransmit budget
+		*	return - False if the budget is spent, the retransmit should wait for the next tick
+		*/
+		bool TryRetransmit(uint32 bytes, Timestamp timestamp);
+
+		/*
+		* Called when a datagram has been acked
+		*	bytes	- Size of the acked datagram
+		*	rtt		- Current round trip time estimate
+		*/
+		void OnAcked(uint32 bytes, Timestamp rtt, Timestamp timestamp);
+
+		/*
+		* Called when messages have timed out
+		*/
+		void OnLoss(Timestamp rtt, Timestamp timestamp);
+
+		/*
+		* return - The number of bytes that can be queued before unreliable messages are dropped
+		*/
+		uint32 GetMaxQueuedBytes() const;
+
+		/*
+		* return - The current send rate in bytes per second
+		*/
+		uint32 GetSendRate() const;
+
+		/*
+		* return - The delivery rate measured from acks in bytes per second
+		*/
+		uint32 GetEstimatedBandwidth() const;
+
+		void Reset();
+
+	private:
+		void Refill(Timestamp timestamp);
+
+	private:
+		mutable SpinLock m_Lock;
+		CongestionControllerDesc m_Desc;
+		float64 m_Rate;
+		float64 m_Tokens;
+		float64 m_RetransmitTokens;
+		float64 m_EstimatedBandwidth;
+		uint64 m_DeliveredBytes;
+		Timestamp m_LastRefill;
+		Timestamp m_DeliveryWindowStart;
+		Timestamp m_LastIncrease;
+		Timestamp m_LastDecrease;
+	};
+}
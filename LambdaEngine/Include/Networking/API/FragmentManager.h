@@ -0,0 +1,138 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+
+#include "Networking/API/IPacketListener.h"
+#include "Networking/API/PacketTranscoder.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+#include <deque>
+#include <map>
+
+namespace LambdaEngine
+{
+	class PacketManager;
+
+	/*
+	* FragmentManager
+	*	Splits messages larger than a NetworkPacket into fragments that fit in one datagram together with all headers, and
+	*	reassembles them on the other side. Fragments are sent reliable on the last channel, which is set to
+	*	CHANNEL_TYPE_RELIABLE_UNORDERED, so every fragment is acked and resent on its own and a lost fragment never holds
+	*	back messages on other channels. At most one bandwidth-delay product of fragments, measured by the congestion
+	*	controller, is in flight at once so small messages do not queue up behind a bulk transfer.
+	*
+	*	The receiver grows a message as its fragments arrive instead of allocating the full size up front, and drops
+	*	messages that have not received a fragment for a while, so a peer can not hold on to more memory than it has
+	*	actually sent.
+	*/
+	class LAMBDA_API FragmentManager : public IPacketListener
+	{
+#pragma pack(push, 1)
+		struct FragmentHeader
+		{
+			uint32 MessageID	= 0;
+			uint32 MessageSize	= 0;
+			uint16 Index		= 0;
+			uint16 Count		= 0;
+			uint16 Type			= 0;
+		};
+#pragma pack(pop)
+
+		struct OutgoingMessage
+		{
+			uint32 ID				= 0;
+			uint16 Type				= 0;
+			uint16 NextFragment		= 0;
+			uint16 FragmentCount	= 0;
+			TArray<char> Data;
+		};
+
+		struct IncomingMessage
+		{
+			uint16 Type					= 0;
+			uint16 FragmentCount		= 0;
+			uint16 FragmentsReceived	= 0;
+			uint32 MessageSize			= 0;
+			Timestamp LastReceived		= 0;
+			TArray<char> Data;			// Grown as fragments arrive, MessageSize once complete
+		};
+
+		struct SendingMessage
+		{
+			uint16 Type			= 0;
+			uint64 BytesUnacked	= 0;
+		};
+
+	public:
+		static constexpr const uint8 FRAGMENT_CHANNEL			= MAXIMUM_NETWORK_CHANNELS - 1;
+		static constexpr const uint16 FRAGMENT_PAYLOAD_SIZE		= MAXIMUM_PACKET_SIZE - sizeof(PacketTranscoder::Header) - sizeof(NetworkPacket::Header) - sizeof(FragmentHeader);
+		static constexpr const uint32 MAXIMUM_MESSAGE_SIZE		= 16 * 1024 * 1024;
+
+	public:
+		/*
+		* pPacketManager	- Manager the fragments are sent with, its last channel is reserved for fragments
+		* pListener			- Receives resends and max tries of fragments, may be nullptr
+		*/
+		FragmentManager(PacketManager* pPacketManager, IPacketListener* pListener);
+		~FragmentManager() = default;
+
+		/*
+		* Copies a message and queues it for sending
+		*	return - False if the message is larger than MAXIMUM_MESSAGE_SIZE
+		*/
+		bool Send(uint16 packetType, const char* pData, uint32 size);
+
+		/*
+		* Sends queued fragments while the window allows it and drops incomplete messages that have timed out, called
+		* every tick
+		*/
+		void Tick();
+
+		/*
+		* Adds a received TYPE_FRAGMENT packet to its message
+		*	packetType	- Set to the type of the message when it is complete
+		*	data		- Set to the message when it is complete
+		*	return		- True if the fragment completed a message
+		*/
+		bool OnFragmentReceived(NetworkPacket* pPacket, uint16& packetType, TArray<char>& data);
+
+		void Reset();
+
+		/*
+		* Forgets the messages that have not been delivered in full, called when the connection closes
+		*	packetTypes - Filled with the type of each message in the order they were sent
+		*/
+		void TakeUndeliveredMessages(TArray<uint16>& packetTypes);
+
+		/*
+		* return - Bytes waiting to be sent or acked
+		*/
+		uint64 GetBytesQueued() const;
+
+		virtual void OnPacketDelivered(NetworkPacket* pPacket) override;
+		virtual void OnPacketResent(NetworkPacket* pPacket, uint8 retries) override;
+		virtual void OnPacketMaxTriesReached(NetworkPacket* pPacket, uint8 retries) override;
+
+	private:
+		void SendFragments();
+		void DeleteTimedOutMessages();
+		uint32 GetWindowSize() const;
+
+	private:
+		PacketManager* m_pPacketManager;
+		IPacketListener* m_pListener;
+		mutable SpinLock m_Lock;
+		std::deque<OutgoingMessage> m_Outgoing;
+		std::map<uint32, SendingMessage> m_Sending;
+		std::unordered_map<uint32, IncomingMessage> m_Incoming;
+		uint32 m_NextMessageID;
+		uint32 m_BytesInFlight;
+		uint64 m_BytesQueued;
+		uint64 m_BytesReassembling;	// Allocated by incomplete messages
+	};
+}
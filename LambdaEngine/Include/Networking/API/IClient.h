@@ -3,6 +3,7 @@
 #include "LambdaEngine.h"
 
 #include "Networking/API/IPEndPoint.h"
+#include "Networking/API/NetworkPacket.h"
 
 namespace LambdaEngine
 {
@@ -30,6 +31,20 @@ namespace LambdaEngine
 		virtual bool IsConnected() = 0;
 		virtual bool SendUnreliable(NetworkPacket* packet) = 0;
 		virtual bool SendReliable(NetworkPacket* packet, IPacketListener* listener = nullptr) = 0;
+
+		/*
+		* Sends a message of any size, it is copied and split into reliable fragments that are reassembled by the
+		* receiver and passed to IClientUDPRemoteHandler::OnLargePacketReceivedUDP. Messages that were not delivered when
+		* the connection closes are passed to IClientUDPRemoteHandler::OnLargePacketFailedUDP
+		*	return - False if not connected or if the message is too large
+		*/
+		virtual bool SendLarge(uint16 packetType, const char* pData, uint32 size) = 0;
+
+		/*
+		* Sets how messages sent on a channel are delivered, see PacketManager::SetChannelType. Should be set before
+		* connecting, the last channel is used by SendLarge and can not be changed
+		*/
+		virtual void SetChannelType(uint8 channel, EChannelType type) = 0;
 		virtual const IPEndPoint& GetEndPoint() const = 0;
 		virtual NetworkPacket* GetFreePacket(uint16 packetType) = 0;
 		virtual EClientState GetState() const = 0;
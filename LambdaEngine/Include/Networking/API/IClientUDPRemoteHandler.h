@@ -17,5 +17,16 @@ namespace LambdaEngine
 		virtual void OnDisconnectingUDP(IClientUDP* pClient) = 0;
 		virtual void OnDisconnectedUDP(IClientUDP* pClient) = 0;
 		virtual void OnPacketReceivedUDP(IClientUDP* pClient, NetworkPacket* pPacket) = 0;
+
+		/*
+		* Called when all fragments of a message sent with IClient::SendLarge have arrived, pData is only valid during the call
+		*/
+		virtual void OnLargePacketReceivedUDP(IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size) = 0;
+
+		/*
+		* Called when the connection closes for each message sent with IClient::SendLarge that was not delivered in full,
+		* before OnDisconnectedUDP
+		*/
+		virtual void OnLargePacketFailedUDP(IClientUDP* pClient, uint16 packetType) = 0;
 	};
 }
\ No newline at end of file
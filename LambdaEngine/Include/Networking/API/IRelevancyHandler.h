@@ -0,0 +1,25 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+namespace LambdaEngine
+{
+	class IClient;
+	class BinaryEncoder;
+
+	class LAMBDA_API IRelevancyHandler
+	{
+	public:
+		DECL_INTERFACE(IRelevancyHandler);
+
+		/*
+		* Called when an object enters or leaves the interest set of a client, before its first update or after its last
+		*/
+		virtual void OnObjectRelevancyChanged(IClient* pClient, uint32 objectID, bool isRelevant) = 0;
+
+		/*
+		* Writes the current state of an object, at most RelevancyManagerDesc::MaxUpdateSize bytes
+		*/
+		virtual void OnWriteObjectUpdate(IClient* pClient, uint32 objectID, BinaryEncoder& encoder) = 0;
+	};
+}
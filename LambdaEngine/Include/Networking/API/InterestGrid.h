@@ -0,0 +1,50 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+
+#include "Math/Math.h"
+
+namespace LambdaEngine
+{
+	/*
+	* InterestGrid
+	*	Uniform grid over the XZ-plane that buckets objects by position. Only cells that contain objects are stored, so
+	*	the world does not need bounds, and a query only touches the cells that overlap it.
+	*/
+	class LAMBDA_API InterestGrid
+	{
+	public:
+		InterestGrid(float32 cellSize);
+		~InterestGrid() = default;
+
+		void Insert(uint32 objectID, const glm::vec3& position);
+		void Remove(uint32 objectID, const glm::vec3& position);
+
+		/*
+		* Moves an object between cells, nothing is done if it stays in the same cell
+		*/
+		void Move(uint32 objectID, const glm::vec3& oldPosition, const glm::vec3& newPosition);
+
+		/*
+		* Appends the objects in every cell that overlaps the square around center, the caller filters by distance
+		*/
+		void Query(const glm::vec3& center, float32 radius, TArray<uint32>& objectIDs) const;
+
+		void Clear();
+
+		float32 GetCellSize() const;
+
+	private:
+		uint64 GetCellKey(const glm::vec3& position) const;
+
+	private:
+		static uint64 GetCellKey(int32 x, int32 z);
+
+	private:
+		float32 m_CellSize;
+		float32 m_InverseCellSize;
+		std::unordered_map<uint64, TArray<uint32>> m_Cells;
+	};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	class NetworkStatistics;
+
+	struct LagCompensationHistoryDesc
+	{
+		uint32	MaxEntities				= 256;
+		uint32	HistorySize				= 64;		// Recorded ticks, at 60 ticks per second this is about one second
+		float32	MaxRewindMS				= 500.0f;	// Older view times are clamped, so a client with a bad connection can not shoot far into the past
+		float32	InterpolationDelayMS	= 100.0f;	// How far behind the server clients render, see SnapshotInterpolator
+	};
+
+	struct LagCompensationHit
+	{
+		uint32 EntityIndex	= 0;
+		float32 Distance	= 0.0f;
+	};
+
+	/*
+	* LagCompensationHistory
+	*	Keeps the bounding spheres of the entities for the last HistorySize ticks so that hits can be validated against
+	*	the world as the shooting client saw it. Entities are kept in fixed slots, index i is the same entity in every
+	*	tick, and each tick is stored as four arrays of X, Y, Z and radius. A query finds the two ticks around the time,
+	*	interpolates the slots four at a time with SSE and tests them against the ray or sphere in the same pass, so a
+	*	query only reads two contiguous blocks of memory.
+	*
+	*	Not thread safe, queries should be made from the thread that records ticks.
+	*/
+	class LAMBDA_API LagCompensationHistory
+	{
+	public:
+		LagCompensationHistory(const LagCompensationHistoryDesc& desc = LagCompensationHistoryDesc());
+		~LagCompensationHistory() = default;
+
+		/*
+		* Sets the bounding sphere of an entity, used from the next call to RecordTick
+		*	entityIndex - Slot of the entity, below MaxEntities
+		*/
+		void SetEntity(uint32 entityIndex, const glm::vec3& center, float32 radius);
+		void RemoveEntity(uint32 entityIndex);
+
+		/*
+		* Stores the current bounding spheres as the world at time, called once per fixed tick
+		*	time - Must be later than the time of the previous tick
+		*/
+		void RecordTick(Timestamp time);
+
+		/*
+		* Estimates the time of the world the client saw when a message that arrives now was sent
+		*	return - now minus half the ping and the interpolation delay, clamped to MaxRewindMS
+		*/
+		Timestamp GetViewTime(const NetworkStatistics* pStatistics, Timestamp now) const;
+
+		/*
+		* Finds the closest entity hit by a ray in the world at time
+		*	direction		- Normalized
+		*	ignoreIndex		- An entity that can not be hit, usually the shooter, UINT32_MAX to test all
+		*	return			- False if nothing was hit
+		*/
+		bool Raycast(Timestamp time, const glm::vec3& origin, const glm::vec3& direction, float32 maxDistance, uint32 ignoreIndex, LagCompensationHit& hit) const;
+
+		/*
+		* Finds the entities overlapping a sphere in the world at time
+		*	entityIndices - Filled with the slots of the entities
+		*	return - The number of entities found
+		*/
+		uint32 OverlapSphere(Timestamp time, const glm::vec3& center, float32 radius, TArray<uint32>& entityIndices) const;
+
+		/*
+		* return - False if the entity did not exist at time
+		*/
+		bool GetEntity(Timestamp time, uint32 entityIndex, glm::vec3& center, float32& radius) const;
+
+		uint32 GetRecordedTickCount() const;
+
+		void Reset();
+
+	private:
+		/*
+		* Finds the ticks around time
+		*	return - False if no tick has been recorded
+		*/
+		bool FindFrames(Timestamp time, const float32*& pFrom, const float32*& pTo, float32& alpha) const;
+		const float32* GetFrame(uint32 index) const;
+
+	private:
+		LagCompensationHistoryDesc m_Desc;
+		uint32 m_Stride;				// Floats per component, MaxEntities rounded up to a multiple of four
+		TArray<float32> m_Current;		// One frame, [X][Y][Z][Radius] each m_Stride floats
+		TArray<float32> m_Frames;		// HistorySize frames laid out like m_Current
+		TArray<uint64> m_FrameTimes;
+		uint32 m_Head;					// Index of the oldest frame
+		uint32 m_FrameCount;
+	};
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Networking/API/ISocketUDP.h"
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/NetworkPacket.h"
+
+#include "Containers/TLockFreeQueue.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace LambdaEngine
+{
+	struct LoopbackDatagram
+	{
+		IPEndPoint	Sender;
+		int32		Size;
+		char		pData[MAXIMUM_PACKET_SIZE];
+	};
+
+	/*
+	* LoopbackSocketUDP
+	*	Memory backed UDP socket for running servers and clients inside the same process without touching the OS.
+	*	Sockets are addressed by port only, a datagram sent to any address with port X ends up at the loopback socket
+	*	bound to port X. Binding to port 0 assigns a free port from the ephemeral range. Every socket owns a lock free
+	*	queue of received datagrams, when the queue is full the datagram is dropped like a real socket buffer would.
+	*	The datagram buffers are pooled and shared by all loopback sockets.
+	*/
+	class LAMBDA_API LoopbackSocketUDP : public ISocketUDP
+	{
+	public:
+		LoopbackSocketUDP();
+		~LoopbackSocketUDP();
+
+		virtual bool Bind(const IPEndPoint& ipEndPoint) override;
+
+		/*
+		* Binds the socket to an ephemeral port if it is not bound yet. The destination is not stored since loopback
+		* datagrams are always sent with SendTo
+		*/
+		virtual bool Connect(const IPEndPoint& ipEndPoint) override;
+
+		virtual bool EnableBlocking(bool enable) override;
+		virtual bool IsNonBlocking() const override;
+
+		/*
+		* Unbinds the socket and wakes up a thread blocked in ReceiveFrom. Queued datagrams are discarded
+		*/
+		virtual bool Close() override;
+		virtual bool IsClosed() const override;
+
+		virtual const IPEndPoint& GetEndPoint() const override;
+
+		/*
+		* Copies the datagram into the receive queue of the socket bound to the port of ipEndPoint. Datagrams larger than
+		* MAXIMUM_PACKET_SIZE are rejected. Sending to a port nobody is bound to, or to a socket with a full queue, succeeds
+		* but the datagram is lost
+		*/
+		virtual bool SendTo(const char* pBuffer, uint32 bytesToSend, int32& bytesSent, const IPEndPoint& ipEndPoint) override;
+
+		/*
+		* In blocking mode the call waits at most a few milliseconds for a datagram so that the receiver thread can check
+		* if it should terminate
+		*	return - False if the socket is closed or no datagram arrived in time
+		*/
+		virtual bool ReceiveFrom(char* pBuffer, uint32 size, int32& bytesReceived, IPEndPoint& ipEndPoint) override;
+
+		virtual bool EnableBroadcast(bool enable) override;
+
+	public:
+		/*
+		* return - The number of datagrams dropped because a receive queue was full or the port was not bound
+		*/
+		static uint64 GetDroppedDatagrams();
+
+	private:
+		void Unbind();
+
+	private:
+		static LoopbackDatagram* AllocateDatagram();
+		static void FreeDatagram(LoopbackDatagram* pDatagram);
+
+	private:
+		IPEndPoint							m_IPEndPoint;
+		TLockFreeQueue<LoopbackDatagram*>	m_ReceiveQueue;
+		std::mutex							m_WaitMutex;
+		std::condition_variable				m_WaitCondition;
+		std::atomic_bool					m_IsWaiting;
+		std::atomic_bool					m_IsClosed;
+		std::atomic_bool					m_IsBound;
+		bool								m_IsNonBlocking;
+	};
+}
@@ -6,6 +6,8 @@
 
 #include "Networking/API/NetworkPacket.h"
 
+#include "Time/API/Timestamp.h"
+
 #include <atomic>
 
 namespace LambdaEngine
@@ -32,9 +34,22 @@ namespace LambdaEngine
 		void TerminateThreads();
 		bool ThreadsAreRunning() const;
 		bool ShouldTerminate() const;
-		void YieldTransmitter();
+
+		/*
+		* Waits for the next call to Flush
+		*	timeout - Wakes the transmitter after this time without a Flush, zero waits for a Flush
+		*/
+		void YieldTransmitter(Timestamp timeout = Timestamp(0));
 		void TerminateAndRelease();
 
+		/*
+		* Starts the worker without threads, OnThreadsStarted is called on the calling thread and the owner does the work
+		* of the transmitter and receiver itself. Once ShouldTerminate returns true the owner calls StopPolling
+		*/
+		bool StartPolling();
+		void StopPolling();
+		bool IsPolling() const;
+
 	private:
 		void ThreadTransmitter();
 		void ThreadReceiver();
@@ -57,6 +72,7 @@ namespace LambdaEngine
 		std::atomic_bool m_ReceiverStopped;
 		std::atomic_bool m_ThreadsTerminated;
 		std::atomic_bool m_Release;
+		std::atomic_bool m_IsPolling;
 
 	private:
 		static SpinLock s_LockStatic;
@@ -4,11 +4,40 @@
 
 namespace LambdaEngine
 {
+	class IPEndPoint;
+
+	/*
+	* NetworkChallenge
+	*	The server answers a connect request with a cookie instead of allocating a connection. The cookie is a keyed hash
+	*	of the sender and the current time window, and is sent as the salt of the server side of the connection. The
+	*	client proves that it received it by answering with Compute(clientSalt, cookie), which the server can verify
+	*	without having stored anything.
+	*/
 	class LAMBDA_API NetworkChallenge
 	{
 	public:
 		DECL_STATIC_CLASS(NetworkChallenge);
 
+		/*
+		* return - The answer a client sends back, never 0
+		*/
 		static uint64 Compute(uint64 clientSalt, uint64 serverSalt);
+
+		/*
+		* pKey			- 128 bit secret only known by the server
+		* timeWindow	- Index of the time window the cookie is valid in
+		* return		- The cookie, never 0
+		*/
+		static uint64 ComputeCookie(const uint64 pKey[2], const IPEndPoint& ipEndPoint, uint64 clientSalt, uint64 timeWindow);
+
+		/*
+		* Fills pKey with a new secret for ComputeCookie. The secret is drawn from std::random_device, which reads the
+		* OS entropy source, and not from Random, so it can not be predicted from or recorded in a replay seed
+		*	pKey - 128 bit secret, written by the function
+		*/
+		static void GenerateKey(uint64 pKey[2]);
+
+	private:
+		static uint64 SipHash(const uint64 pKey[2], const uint64* pWords, uint32 count);
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Networking/API/IPEndPoint.h"
+
+#include "Containers/TArray.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <functional>
+
+namespace LambdaEngine
+{
+	/*
+	* Conditions applied to outgoing datagrams. Each peer simulates its own direction, so configure both the server
+	* and the client to simulate a round trip
+	*/
+	struct NetworkConditions
+	{
+		float32	LatencyMS			= 0.0f;			// Constant one way delay
+		float32	JitterMS			= 0.0f;			// Random extra delay in [0, JitterMS], datagrams keep their order unless reordered
+		float32	LossRatio			= 0.0f;			// Loss in the good state of the Gilbert-Elliott model
+		float32	BurstLossRatio		= 0.0f;			// Loss in the bad state
+		float32	BurstEnterRatio		= 0.0f;			// Chance per datagram to go from the good to the bad state
+		float32	BurstExitRatio		= 1.0f;			// Chance per datagram to go from the bad to the good state
+		float32	DuplicationRatio	= 0.0f;			// Chance that a datagram is delivered twice
+		float32	ReorderRatio		= 0.0f;			// Chance that a datagram is held back and overtaken by the following ones
+		float32	ReorderDelayMS		= 20.0f;		// How long a reordered datagram is held back
+		uint32	BandwidthKbps		= 0;			// Bottleneck bandwidth, 0 means unlimited
+		uint32	QueueLimitBytes		= 64 * 1024;	// Bytes waiting for the bottleneck before datagrams are tail dropped
+		uint32	Seed				= 0;			// Seed of the random generator, 0 picks a random seed
+
+		FORCEINLINE bool IsEnabled() const
+		{
+			return LatencyMS > 0.0f || JitterMS > 0.0f || LossRatio > 0.0f || BurstEnterRatio > 0.0f ||
+				DuplicationRatio > 0.0f || ReorderRatio > 0.0f || BandwidthKbps > 0;
+		}
+	};
+
+	typedef std::function<void(const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint)> SendDatagramFunc;
+
+	/*
+	* NetworkConditionSimulator
+	*	Delays, drops, duplicates and reorders datagrams to simulate a WAN link. Every destination has a link of its
+	*	own with the same conditions, so the bandwidth cap, the bottleneck queue and the burst loss state of one
+	*	client on a server do not affect the others. Datagrams that survive are stored in a queue ordered by delivery
+	*	time and handed to the send function by Flush once the time has passed.
+	*/
+	class LAMBDA_API NetworkConditionSimulator
+	{
+		struct DelayedDatagram
+		{
+			IPEndPoint		EndPoint;
+			TArray<char>	Data;
+		};
+
+		struct Link
+		{
+			bool	InBurst				= false;
+			uint64	LinkFreeTime		= 0;
+			uint64	LastDeliveryTime	= 0;
+		};
+
+	public:
+		NetworkConditionSimulator();
+		~NetworkConditionSimulator() = default;
+
+		void SetConditions(const NetworkConditions& conditions);
+		NetworkConditions GetConditions() const;
+
+		bool IsEnabled() const;
+
+		/*
+		* Applies the conditions to a datagram and queues the copies that should be delivered
+		*	pBuffer		- The datagram
+		*	bytes		- Size of the datagram
+		*	ipEndPoint	- The destination
+		*	timestamp	- The current time
+		*/
+		void Submit(const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint, Timestamp timestamp);
+
+		/*
+		* Sends all datagrams with a delivery time before timestamp
+		*/
+		void Flush(Timestamp timestamp, const SendDatagramFunc& sendFunc);
+
+		/*
+		* return - False if no datagrams are queued
+		*/
+		bool GetNextDeliveryTime(Timestamp& timestamp) const;
+
+		/*
+		* Drops all queued datagrams and resets the link state
+		*/
+		void Reset();
+
+		/*
+		* Forgets the link to a destination, called when a client disconnects. Queued datagrams are still delivered
+		*/
+		void RemoveLink(const IPEndPoint& ipEndPoint);
+
+		uint64 GetDroppedDatagrams() const;
+
+	private:
+		bool ShouldDrop(Link& link);
+		float32 Random01();
+		void Enqueue(uint64 deliveryTime, const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint);
+
+	private:
+		mutable SpinLock m_Lock;
+		NetworkConditions m_Conditions;
+		std::minstd_rand m_Generator;
+		std::multimap<uint64, DelayedDatagram> m_Queue;
+		std::unordered_map<IPEndPoint, Link, IPEndPointHasher> m_Links;
+		uint64 m_DroppedDatagrams;
+	};
+}
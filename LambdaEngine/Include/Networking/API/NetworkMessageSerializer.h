@@ -0,0 +1,117 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/IClient.h"
+
+#include <tuple>
+#include <type_traits>
+
+/*
+* Declares the fields of a network message in the order they are serialized, used inside the message struct together
+* with a static constexpr uint16 TYPE. Fields must be trivially copyable, which makes the size of every message known
+* at compile time
+*
+*	struct PlayerMoveMessage
+*	{
+*		static constexpr const uint16 TYPE = 1;
+*		uint32		EntityID;
+*		glm::vec3	Position;
+*		NETWORK_MESSAGE_FIELDS(&PlayerMoveMessage::EntityID, &PlayerMoveMessage::Position)
+*	};
+*/
+#define NETWORK_MESSAGE_FIELDS(...) \
+	static constexpr auto GetNetworkFields() { return std::make_tuple(__VA_ARGS__); }
+
+namespace LambdaEngine
+{
+	/*
+	* NetworkMessageSerializer
+	*	Encodes and decodes messages declared with NETWORK_MESSAGE_FIELDS. The field list is expanded at compile time
+	*	into one copy per field, so there are no branches or virtual calls per field and the size is a constant
+	*/
+	class NetworkMessageSerializer
+	{
+	public:
+		DECL_STATIC_CLASS(NetworkMessageSerializer);
+
+		/*
+		* return - The exact number of bytes a message occupies in a packet
+		*/
+		template<typename TMessage>
+		static constexpr uint16 GetSize()
+		{
+			return std::apply([](auto... pFields) { return uint16((0 + ... + GetFieldSize(pFields))); }, TMessage::GetNetworkFields());
+		}
+
+		/*
+		* Appends a message to a packet
+		*	return - False if the message does not fit
+		*/
+		template<typename TMessage>
+		static bool Encode(const TMessage& message, NetworkPacket* pPacket)
+		{
+			constexpr uint16 size = GetSize<TMessage>();
+			static_assert(size <= MAXIMUM_PACKET_SIZE, "Message is larger than a packet");
+
+			if (pPacket->GetBufferSize() + size > MAXIMUM_PACKET_SIZE)
+				return false;
+
+			char* pBuffer = pPacket->GetBuffer() + pPacket->GetBufferSize();
+			std::apply([&](auto... pFields) { (WriteField(pBuffer, message.*pFields), ...); }, TMessage::GetNetworkFields());
+			pPacket->AppendBytes(size);
+			return true;
+		}
+
+		/*
+		* Reads a message from a packet
+		*	offset - Where in the buffer of the packet the message starts
+		*	return - False if the packet is too small
+		*/
+		template<typename TMessage>
+		static bool Decode(const NetworkPacket* pPacket, TMessage& message, uint16 offset = 0)
+		{
+			constexpr uint16 size = GetSize<TMessage>();
+			if (offset + size > pPacket->GetBufferSize())
+				return false;
+
+			const char* pBuffer = pPacket->GetBufferReadOnly() + offset;
+			std::apply([&](auto... pFields) { (ReadField(pBuffer, message.*pFields), ...); }, TMessage::GetNetworkFields());
+			return true;
+		}
+
+		/*
+		* Takes a free packet of TMessage::TYPE from the client and encodes the message into it
+		*/
+		template<typename TMessage>
+		static NetworkPacket* CreatePacket(IClient* pClient, const TMessage& message)
+		{
+			NetworkPacket* pPacket = pClient->GetFreePacket(TMessage::TYPE);
+			Encode(message, pPacket);
+			return pPacket;
+		}
+
+	private:
+		template<typename TMessage, typename TField>
+		static constexpr uint16 GetFieldSize(TField TMessage::*)
+		{
+			static_assert(std::is_trivially_copyable_v<TField>, "Network message fields must be trivially copyable");
+			return uint16(sizeof(TField));
+		}
+
+		template<typename TField>
+		static FORCEINLINE void WriteField(char*& pBuffer, const TField& value)
+		{
+			memcpy(pBuffer, &value, sizeof(TField));
+			pBuffer += sizeof(TField);
+		}
+
+		template<typename TField>
+		static FORCEINLINE void ReadField(const char*& pBuffer, TField& value)
+		{
+			memcpy(&value, pBuffer, sizeof(TField));
+			pBuffer += sizeof(TField);
+		}
+	};
+}
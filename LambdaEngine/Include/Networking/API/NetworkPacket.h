@@ -4,13 +4,27 @@
 #include "Containers/String.h"
 
 #define MAXIMUM_PACKET_SIZE 1024
+#define MAXIMUM_NETWORK_CHANNELS 8
 
 namespace LambdaEngine
 {
+	/*
+	* How the messages of a channel are delivered. Each channel has its own sequence numbers, so a lost message only
+	* holds back later messages of the same channel
+	*/
+	enum EChannelType : uint8
+	{
+		CHANNEL_TYPE_RELIABLE_ORDERED,		// Delivered once, in the order they were sent
+		CHANNEL_TYPE_RELIABLE_UNORDERED,	// Delivered once, as soon as they arrive
+		CHANNEL_TYPE_UNRELIABLE_SEQUENCED,	// May be lost, messages older than the newest received are dropped
+		CHANNEL_TYPE_UNRELIABLE,			// May be lost, duplicated or reordered
+	};
+
 	class LAMBDA_API NetworkPacket
 	{
 		friend class PacketTranscoder;
 		friend class PacketPool;
+		friend class PacketArena;
 		friend class PacketManager;
 		friend class PacketManager2;
 
@@ -22,6 +36,9 @@ namespace LambdaEngine
 			uint16 Type = 0;
 			uint32 UID = 0;
 			uint32 ReliableUID = 0;
+			uint32 ChannelSequence = 0;
+			uint8 Channel = 0;
+			uint8 ChannelType = CHANNEL_TYPE_UNRELIABLE;
 		};
 #pragma pack(pop)
 
@@ -37,8 +54,14 @@ namespace LambdaEngine
 			TYPE_ACCEPTED				= UINT16_MAX - 7,
 			TYPE_NETWORK_ACK			= UINT16_MAX - 8,
 			TYPE_NETWORK_DISCOVERY		= UINT16_MAX - 9,
+			TYPE_FRAGMENT				= UINT16_MAX - 10,
 		};
 
+		/*
+		* The engine types are counted down from UINT16_MAX, UINT16_MAX - type is an index below this for engine types
+		*/
+		static constexpr const uint16 INTERNAL_TYPE_COUNT = 11;
+
 	public:
 		~NetworkPacket();
 
@@ -61,6 +84,13 @@ namespace LambdaEngine
 		bool IsReliable() const;
 		uint32 GetReliableUID() const;
 
+		/*
+		* Selects the channel the packet is sent on, the type of the channel is set with PacketManager::SetChannelType
+		*	channel - Index below MAXIMUM_NETWORK_CHANNELS, 0 is used if not set
+		*/
+		NetworkPacket* SetChannel(uint8 channel);
+		uint8 GetChannel() const;
+
 		std::string ToString() const;
 
 	private:
@@ -43,7 +43,7 @@ namespace LambdaEngine
 		uint32 GetMessagesReceived() const;
 
 		/*
-		* return - The number of physical packets lost
+		* return - The number of physical packets sent that left the ack window without being acked
 		*/
 		uint32 GetPacketsLost()	const;
 
@@ -52,6 +52,11 @@ namespace LambdaEngine
 		*/
 		float64 GetPacketLossRate()	const;
 
+		/*
+		* return - The number of physical packets sent by the remote side that never arrived
+		*/
+		uint32 GetIncomingPacketsLost() const;
+
 		/*
 		* return - The total number of bytes sent
 		*/
@@ -63,10 +68,20 @@ namespace LambdaEngine
 		uint32 GetBytesReceived() const;
 
 		/*
-		* return - The avarage roun trip time of the 10 latest physical packets
+		* return - The smoothed round trip time (SRTT in RFC 6298)
 		*/
 		const Timestamp& GetPing() const;
 
+		/*
+		* return - The round trip time variation (RTTVAR in RFC 6298)
+		*/
+		const Timestamp& GetRTTVariance() const;
+
+		/*
+		* return - The timeout before a reliable message sent for the first time is resent (RTO in RFC 6298)
+		*/
+		const Timestamp& GetRetransmissionTimeout() const;
+
 		/*
 		* return - The unique salt representing this side of the connection
 		*/
@@ -103,7 +118,8 @@ namespace LambdaEngine
 		uint32 RegisterReliableMessageSent();
 		void RegisterPacketReceived(uint32 messages, uint32 bytes);
 		void RegisterReliableMessageReceived();
-		void RegisterPacketLoss();
+		void RegisterPacketsLost(uint32 packets);
+		void RegisterIncomingPacketsLost(uint32 packets);
 		void RegisterBytesSent(uint32 bytes);
 		void SetRemoteSalt(uint64 salt);
 
@@ -114,6 +130,7 @@ namespace LambdaEngine
 
 	private:
 		uint32 m_PacketsLost;
+		uint32 m_IncomingPacketsLost;
 		uint32 m_PacketsSent;
 		uint32 m_MessagesSent;
 		uint32 m_ReliableMessagesSent;
@@ -123,6 +140,9 @@ namespace LambdaEngine
 		uint32 m_BytesReceived;
 
 		Timestamp m_Ping;
+		Timestamp m_RTTVariance;
+		Timestamp m_RetransmissionTimeout;
+		bool m_HasRTTSample;
 		Timestamp m_TimestampLastSent;
 		Timestamp m_TimestampLastReceived;
 
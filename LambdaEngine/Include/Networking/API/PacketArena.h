@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+
+#include "Threading/API/SpinLock.h"
+
+namespace LambdaEngine
+{
+	class NetworkPacket;
+	class MetricGauge;
+
+	/*
+	* PacketArena
+	*	Packet memory shared by all PacketPools of a server. Packets are allocated in chunks the first time they are
+	*	needed and are never released back to the OS, so memory follows the peak traffic instead of the client count.
+	*/
+	class LAMBDA_API PacketArena
+	{
+	public:
+		/*
+		* maxPackets	- The most packets the arena will ever allocate
+		* chunkSize		- The number of packets allocated at once when the arena runs dry
+		*/
+		PacketArena(uint32 maxPackets, uint16 chunkSize = 64);
+		~PacketArena();
+
+		/*
+		* Moves up to nrOfPackets free packets into packetsReturned, allocates a new chunk if needed
+		*	return - The number of packets added to packetsReturned
+		*/
+		uint32 RequestPackets(uint32 nrOfPackets, TArray<NetworkPacket*>& packetsReturned);
+		void FreePackets(NetworkPacket* const* ppPackets, uint32 nrOfPackets);
+
+		uint32 GetMaxPackets() const;
+		uint32 GetAllocatedPackets() const;
+		uint32 GetFreePackets() const;
+
+	private:
+		bool AllocateChunk();
+
+	private:
+		TArray<NetworkPacket*> m_Chunks;
+		TArray<NetworkPacket*> m_PacketsFree;
+		uint32 m_MaxPackets;
+		uint32 m_AllocatedPackets;
+		uint16 m_ChunkSize;
+		mutable SpinLock m_Lock;
+		MetricGauge* m_pPacketsGauge;
+	};
+}
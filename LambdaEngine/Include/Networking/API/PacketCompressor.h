@@ -0,0 +1,59 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+namespace LambdaEngine
+{
+	enum ECompressionMode : uint8
+	{
+		COMPRESSION_MODE_NONE		= 0,
+		COMPRESSION_MODE_LZ			= 1,	// Byte oriented LZ77 in the style of LZ4, fast and good at repeated structs
+		COMPRESSION_MODE_HUFFMAN	= 2,	// Static Huffman code, good at small values that do not repeat
+		COMPRESSION_MODE_COUNT		= 3,
+	};
+
+	/*
+	* PacketCompressor
+	*	Codecs for the payload of a datagram. Both codecs work on a single datagram without state shared between
+	*	datagrams, so a lost datagram never affects the decoding of another. The Huffman code is static and must be the
+	*	same on every peer, it can be trained from captured traffic with CountFrequencies and SetHuffmanFrequencies.
+	*/
+	class LAMBDA_API PacketCompressor
+	{
+	public:
+		DECL_STATIC_CLASS(PacketCompressor);
+
+		/*
+		* Compresses a buffer
+		*	return - Bytes written to pDestination, 0 if the data did not become smaller or did not fit
+		*/
+		static uint16 Compress(ECompressionMode mode, const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize);
+
+		/*
+		* Decompresses a buffer
+		*	decompressedSize - The exact size of the data before it was compressed
+		*	return - False if the data is malformed
+		*/
+		static bool Decompress(ECompressionMode mode, const char* pSource, uint16 sourceSize, char* pDestination, uint16 decompressedSize);
+
+		/*
+		* Rebuilds the static Huffman code. Should be called with the same frequencies on every peer before any
+		* connection is made, the default code favours zeros, small integers and float exponents. The new code is
+		* swapped in atomically, so it is safe to call while other threads are coding. Every Huffman payload starts
+		* with an ID of the code and payloads from a peer with another code fail to decompress
+		*	pFrequencies - Number of times each byte value occurs, zeros are allowed
+		*/
+		static void SetHuffmanFrequencies(const uint32 pFrequencies[256]);
+
+		/*
+		* Adds the byte values of a buffer to pFrequencies, used to train the Huffman code from captured datagrams
+		*/
+		static void CountFrequencies(const char* pData, uint32 size, uint32 pFrequencies[256]);
+
+	private:
+		static uint16 CompressLZ(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 destinationSize);
+		static bool DecompressLZ(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 decompressedSize);
+		static uint16 CompressHuffman(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 destinationSize);
+		static bool DecompressHuffman(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 decompressedSize);
+	};
+}
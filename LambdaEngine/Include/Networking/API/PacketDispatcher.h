@@ -0,0 +1,81 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+#include "Networking/API/NetworkMessageSerializer.h"
+
+namespace LambdaEngine
+{
+	class IClientUDP;
+	class NetworkPacket;
+
+	/*
+	* PacketDispatcher
+	*	Table of handlers indexed by packet type, replaces a chain of type comparisons with one lookup and one call
+	*	through a function pointer. Message handlers are registered with their message type and context class, and the
+	*	generated function decodes the message and calls the member function directly.
+	*
+	*	Only types below MAXIMUM_DISPATCH_TYPES can be registered, which leaves the engine types at the top of the range
+	*	to the clients. Registration is not thread safe and should be done before connecting.
+	*/
+	class LAMBDA_API PacketDispatcher
+	{
+	public:
+		/*
+		* return - False if the packet could not be handled, for example if it was too small for its message
+		*/
+		using DispatchFunc = bool(*)(void* pContext, IClientUDP* pClient, NetworkPacket* pPacket);
+
+		static constexpr const uint16 MAXIMUM_DISPATCH_TYPES = 256;
+
+	private:
+		struct Entry
+		{
+			DispatchFunc Func	= nullptr;
+			void* pContext		= nullptr;
+		};
+
+	public:
+		PacketDispatcher() = default;
+		~PacketDispatcher() = default;
+
+		/*
+		* Registers a member function that receives decoded messages of TMessage::TYPE
+		*	pContext - The object the handler is called on
+		*
+		*	dispatcher.Register<PlayerMoveMessage, Server, &Server::OnPlayerMove>(this);
+		*/
+		template<typename TMessage, typename TContext, void(TContext::*Handler)(IClientUDP*, const TMessage&)>
+		bool Register(TContext* pContext)
+		{
+			return RegisterFunc(TMessage::TYPE, pContext, &DispatchMessage<TMessage, TContext, Handler>);
+		}
+
+		/*
+		* Registers a function that receives the packet as it is
+		*/
+		bool RegisterFunc(uint16 packetType, void* pContext, DispatchFunc func);
+		void Unregister(uint16 packetType);
+
+		/*
+		* Calls the handler of the type of the packet
+		*	return - False if no handler is registered for the type or if the handler failed
+		*/
+		bool Dispatch(IClientUDP* pClient, NetworkPacket* pPacket) const;
+
+	private:
+		template<typename TMessage, typename TContext, void(TContext::*Handler)(IClientUDP*, const TMessage&)>
+		static bool DispatchMessage(void* pContext, IClientUDP* pClient, NetworkPacket* pPacket)
+		{
+			TMessage message;
+			if (!NetworkMessageSerializer::Decode(pPacket, message))
+				return false;
+
+			(static_cast<TContext*>(pContext)->*Handler)(pClient, message);
+			return true;
+		}
+
+	private:
+		Entry m_Entries[MAXIMUM_DISPATCH_TYPES];
+	};
+}
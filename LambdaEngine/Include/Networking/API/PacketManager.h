@@ -6,17 +6,23 @@
 #include "Containers/TSet.h"
 #include "Containers/THashTable.h"
 
+#include "Networking/API/NetworkPacket.h"
 #include "Networking/API/NetworkStatistics.h"
 #include "Networking/API/PacketPool.h"
 #include "Networking/API/IPEndPoint.h"
+#include "Networking/API/CongestionController.h"
+#include "Networking/API/PacketCompressor.h"
 
 #include "Threading/API/SpinLock.h"
 
+#include <map>
+
 namespace LambdaEngine
 {
 	class NetworkPacket;
 	class IPacketListener;
 	class PacketTransceiver;
+	class PacketArena;
 
 	class LAMBDA_API PacketManager
 	{
@@ -26,7 +32,12 @@ namespace LambdaEngine
 			NetworkPacket* Packet		= nullptr;
 			IPacketListener* Listener	= nullptr;
 			Timestamp LastSent			= 0;
+			Timestamp Timeout			= 0;
 			uint8 Retries				= 0;
+			bool IsInFlight				= false;	// Transmitted and not yet timed out
+			bool IsLost					= false;	// Timed out and waiting for retransmit budget
+			bool IsQueued				= false;	// In the send queues, the packet can not be freed until it is transmitted
+			bool IsAcked				= false;	// Acked while queued for a resend, freed by Flush
 		};
 
 		struct Bundle
@@ -35,8 +46,35 @@ namespace LambdaEngine
 			Timestamp Timestamp = 0;
 		};
 
+		struct SentDatagram
+		{
+			uint32 Sequence			= 0;
+			uint32 Bytes			= 0;
+			Timestamp Timestamp		= 0;
+			bool HasRetransmits		= false;	// Karn's rule, acks of retransmits are not used as RTT samples
+		};
+
+		struct SendChannel
+		{
+			EChannelType Type			= CHANNEL_TYPE_RELIABLE_ORDERED;
+			uint32 ReliableSequence		= 0;
+			uint32 UnreliableSequence	= 0;
+		};
+
+		struct ReceiveChannel
+		{
+			uint32 LastOrdered = 0;
+			std::map<uint32, NetworkPacket*> PendingOrdered;
+			uint32 LastUnordered = 0;
+			std::set<uint32> ReceivedUnordered;
+			uint32 LastSequenced = 0;
+		};
+
+		static constexpr const uint32 SENT_DATAGRAM_HISTORY = 256;
+
 	public:
-		PacketManager(uint16 poolSize, int32 maxRetries, float32 resendRTTMultiplier = 2.0f);
+		PacketManager(uint16 poolSize, int32 maxRetries);
+		PacketManager(PacketArena* pArena, uint16 packetQuota, int32 maxRetries);
 		~PacketManager();
 
 		uint32 EnqueuePacketReliable(NetworkPacket* pPacket, IPacketListener* pListener = nullptr);
@@ -51,19 +89,44 @@ namespace LambdaEngine
 		PacketPool* GetPacketPool();
 		const NetworkStatistics* GetStatistics() const;
 		const IPEndPoint& GetEndPoint() const;
+		const CongestionController* GetCongestionController() const;
 
 		void SetEndPoint(const IPEndPoint& ipEndPoint);
 
+		/*
+		* Replaces the random salt of this side of the connection, used by the server to adopt the handshake cookie
+		*/
+		void SetSalt(uint64 salt);
+
+		/*
+		* Sets how messages sent on a channel are delivered. Reliable messages on a CHANNEL_TYPE_UNRELIABLE_SEQUENCED
+		* channel are delivered in order, and unreliable messages on a reliable channel are not sequenced.
+		* Should be set before connecting, all channels default to CHANNEL_TYPE_RELIABLE_ORDERED. The last channel is
+		* used by FragmentManager
+		*/
+		void SetChannelType(uint8 channel, EChannelType type);
+		EChannelType GetChannelType(uint8 channel) const;
+
+		/*
+		* Compresses outgoing datagrams of this connection, incoming datagrams are decompressed whatever mode the remote
+		* uses. Defaults to COMPRESSION_MODE_NONE
+		*/
+		void SetCompressionMode(ECompressionMode mode);
+		ECompressionMode GetCompressionMode() const;
+
 		void Reset();
 
 	private:
 		uint32 EnqueuePacket(NetworkPacket* pPacket, uint32 reliableUID);
 		void FindPacketsToReturn(const TArray<NetworkPacket*>& packetsReceived, TArray<NetworkPacket*>& packetsReturned);
-		void UntangleReliablePackets(TArray<NetworkPacket*>& packetsReturned);
+		void UntangleReliablePackets(ReceiveChannel& channel, TArray<NetworkPacket*>& packetsReturned);
 		void HandleAcks(const TArray<uint32>& acks);
 		void GetReliableUIDsFromAcks(const TArray<uint32>& acks, TArray<uint32>& ackedReliableUIDs);
 		void GetReliableMessageInfosFromUIDs(const TArray<uint32>& ackedReliableUIDs, TArray<MessageInfo>& ackedReliableMessages);
 		void RegisterRTT(Timestamp rtt);
+		void RegisterAckedDatagrams(const TArray<uint32>& acks);
+		void TransmitBundle(PacketTransceiver* pTransceiver, std::queue<NetworkPacket*>& packets, Timestamp timestamp);
+		void DropQueuedUnreliablePackets();
 		void DeleteOldBundles();
 		void ResendOrDeleteMessages();
 
@@ -72,13 +135,19 @@ namespace LambdaEngine
 		PacketPool m_PacketPool;
 		IPEndPoint m_IPEndPoint;
 		std::queue<NetworkPacket*> m_MessagesToSend[2];
+		std::queue<NetworkPacket*> m_PacedMessages;
+		std::queue<NetworkPacket*> m_ControlMessages;
+		std::atomic_uint32_t m_PacedBytes;
+		CongestionController m_CongestionController;
+		SentDatagram m_SentDatagrams[SENT_DATAGRAM_HISTORY];
 		std::unordered_map<uint32, MessageInfo> m_MessagesWaitingForAck;
-		std::set<NetworkPacket*> m_ReliableMessagesReceived;
+		SendChannel m_SendChannels[MAXIMUM_NETWORK_CHANNELS];
+		ReceiveChannel m_ReceiveChannels[MAXIMUM_NETWORK_CHANNELS];
 		std::unordered_map<uint32, Bundle> m_Bundles;
 		std::atomic_int m_QueueIndex;
 		Timestamp m_Timer;
-		float32 m_ResendRTTMultiplier;
 		int32 m_MaxRetries;
+		std::atomic<ECompressionMode> m_CompressionMode;
 		SpinLock m_LockMessagesToSend;
 		SpinLock m_LockBundles;
 	};
@@ -10,11 +10,22 @@
 namespace LambdaEngine
 {
 	class NetworkPacket;
+	class MetricGauge;
+	class PacketArena;
 
 	class LAMBDA_API PacketPool
 	{
 	public:
+		/*
+		* Allocates all packets up front
+		*/
 		PacketPool(uint16 size);
+
+		/*
+		* Borrows packets from a shared arena the first time they are needed and returns them on Reset
+		*	quota - The most packets this pool may hold
+		*/
+		PacketPool(PacketArena* pArena, uint16 quota);
 		~PacketPool();
 
 		NetworkPacket* RequestFreePacket();
@@ -31,10 +42,15 @@ namespace LambdaEngine
 	private:
 		void Request(NetworkPacket* pPacket);
 		void Free(NetworkPacket* pPacket);
+		void Grow(uint16 nrOfPackets);
 
 	private:
 		TArray<NetworkPacket*> m_Packets;
 		TArray<NetworkPacket*> m_PacketsFree;
 		SpinLock m_Lock;
+		PacketArena* m_pArena;
+		uint16 m_Quota;
+		MetricGauge* m_pPacketsGauge;
+		MetricGauge* m_pPacketsInUseGauge;
 	};
 }
\ No newline at end of file
@@ -7,20 +7,32 @@
 #include "Networking/API/NetworkPacket.h"
 #include "Networking/API/IPEndPoint.h"
 #include "Networking/API/PacketTranscoder.h"
+#include "Networking/API/NetworkConditionSimulator.h"
 
 namespace LambdaEngine
 {
 	class NetworkPacket;
 	class NetworkStatistics;
 	class ISocketUDP;
+	class MetricCounter;
 
 	class LAMBDA_API PacketTransceiver
 	{
+		friend class PacketTransceiverBenchmark;
+
 	public:
 		PacketTransceiver();
 		~PacketTransceiver();
 
-		int32 Transmit(PacketPool* pPacketPool, std::queue<NetworkPacket*>& packets, std::set<uint32>& reliableUIDsSent, const IPEndPoint& ipEndPoint, NetworkStatistics* pStatistics);
+		/*
+		* Encodes as many packets as fit in one datagram and sends it
+		*	compression - Applied to the datagram if it makes it smaller, the receiver reads the mode from the header
+		*/
+		int32 Transmit(PacketPool* pPacketPool, std::queue<NetworkPacket*>& packets, std::set<uint32>& reliableUIDsSent, const IPEndPoint& ipEndPoint, NetworkStatistics* pStatistics, ECompressionMode compression = COMPRESSION_MODE_NONE);
+
+		/*
+		* Receives a datagram and decompresses it if the sender compressed it
+		*/
 		bool ReceiveBegin(IPEndPoint& sender);
 		bool ReceiveEnd(PacketPool* pPacketPool, TArray<NetworkPacket*>& packets, TArray<uint32>& newAcks, NetworkStatistics* pStatistics);
 
@@ -29,17 +41,60 @@ namespace LambdaEngine
 		void SetSimulateReceivingPacketLoss(float32 lossRatio);
 		void SetSimulateTransmittingPacketLoss(float32 lossRatio);
 
+		/*
+		* Simulates latency, jitter, burst loss, duplication, reordering and a bandwidth cap on outgoing datagrams.
+		* Ignored in production builds
+		*/
+		void SetSimulatedConditions(const NetworkConditions& conditions);
+		NetworkConditions GetSimulatedConditions() const;
+
+		/*
+		* Every destination has its own simulated link, this forgets the link of a destination that has disconnected
+		*/
+		void RemoveSimulatedLink(const IPEndPoint& ipEndPoint);
+
+		/*
+		* Sends the simulated datagrams whose delivery time has passed, called by Transmit but should also be called
+		* when nothing is transmitted
+		*	return - The time until the next simulated datagram is due, zero if none are queued. The transmitter should
+		*			 wake up after this time
+		*/
+		Timestamp FlushSimulatedDatagrams();
+
+		/*
+		* Parses the header and first message of the datagram received by the last ReceiveBegin, without decoding it
+		*/
+		bool PeekFirstPacket(PacketTranscoder::Header& header, NetworkPacket::Header& packetHeader, const char*& pPayload) const;
+
+		/*
+		* Sends an already encoded datagram, bypassing PacketManagers and the condition simulator
+		*/
+		bool SendDatagram(const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint);
+
 	private:
+
 		static bool ValidateHeaderSalt(PacketTranscoder::Header* header, NetworkStatistics* pStatistics);
 		static void ProcessSequence(uint32 sequence, NetworkStatistics* pStatistics);
 		static void ProcessAcks(uint32 ack, uint32 ackBits, NetworkStatistics* pStatistics, TArray<uint32>& newAcks);
+		static uint32 ShiftSequenceBits(uint32& sequenceBits, uint32 latestSequence, uint32 delta);
 
 	private:
 		ISocketUDP* m_pSocket;
 		int32 m_BytesReceived;
+		const char* m_pDatagram;
+		uint16 m_DatagramSize;
 		float32 m_ReceivingLossRatio;
 		float32 m_TransmittingLossRatio;
 		char m_pSendBuffer[MAXIMUM_PACKET_SIZE];
 		char m_pReceiveBuffer[UINT16_MAX];
+		char m_pCompressBuffer[MAXIMUM_PACKET_SIZE];
+		char m_pDecompressBuffer[MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header)];
+		MetricCounter* m_pPacketsSentCounter;
+		MetricCounter* m_pPacketsReceivedCounter;
+		MetricCounter* m_pBytesSentCounter;
+		MetricCounter* m_pBytesReceivedCounter;
+		MetricCounter* m_pBytesSavedCounter;
+		uint32 m_ReplayStream;
+		NetworkConditionSimulator m_ConditionSimulator;
 	};
 }
\ No newline at end of file
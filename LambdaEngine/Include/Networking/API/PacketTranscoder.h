@@ -5,6 +5,9 @@
 #include "Containers/TArray.h"
 #include "Containers/TSet.h"
 
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/PacketCompressor.h"
+
 namespace LambdaEngine
 {
 	class NetworkPacket;
@@ -22,6 +25,7 @@ namespace LambdaEngine
 			uint32 Ack = 0;
 			uint32 AckBits = 0;
 			uint8  Packets = 0;
+			uint8  Compression = COMPRESSION_MODE_NONE;
 		};
 #pragma pack(pop)
 
@@ -31,6 +35,27 @@ namespace LambdaEngine
 		static bool EncodePackets(char* buffer, uint16 bufferSize, PacketPool* pPacketPool, std::queue<NetworkPacket*>& packetsToEncode, std::set<uint32>& reliableUIDsSent, uint16& bytesWritten, Header* pHeader);
 		static bool DecodePackets(const char* buffer, uint16 bufferSize, PacketPool* pPacketPool, TArray<NetworkPacket*>& packetsDecoded, Header* pHeader);
 
+		/*
+		* Reads the header and the first message of a datagram without taking packets from a pool
+		*	ppPayload - Set to the payload of the first message inside buffer
+		*	return - False if the datagram is malformed or empty
+		*/
+		static bool PeekFirstPacket(const char* buffer, uint16 bufferSize, Header* pHeader, NetworkPacket::Header* pPacketHeader, const char** ppPayload);
+
+		/*
+		* Compresses everything after the header of an encoded datagram, the header is kept readable so that the sender
+		* can be identified and is followed by the uncompressed size of the datagram
+		*	return - Size of the compressed datagram, 0 if it did not become smaller
+		*/
+		static uint16 CompressDatagram(const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize, ECompressionMode mode);
+
+		/*
+		* Restores a datagram written by CompressDatagram
+		*	bytesWritten - Set to the size of the uncompressed datagram
+		*	return - False if the datagram is malformed or does not fit in pDestination
+		*/
+		static bool DecompressDatagram(const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize, uint16& bytesWritten);
+
 	private:
 		static uint16 WritePacket(char* buffer, NetworkPacket* pPacket);
 		static uint16 ReadPacket(const char* buffer, NetworkPacket* pPacket);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+
+#include "Networking/API/InterestGrid.h"
+
+#include "Time/API/Timestamp.h"
+
+namespace LambdaEngine
+{
+	class IClient;
+	class IRelevancyHandler;
+	class NetworkPacket;
+
+	struct RelevancyManagerDesc
+	{
+		float32	CellSize		= 32.0f;
+		float32	ViewRadius		= 128.0f;		// Used for clients until SetClientView is called
+		uint32	BytesPerSecond	= 16 * 1024;	// Update budget of every client
+		uint16	PacketType		= 0;			// Type of the packets carrying the updates
+		uint16	MaxUpdateSize	= 64;			// Largest update written by IRelevancyHandler::OnWriteObjectUpdate
+	};
+
+	/*
+	* RelevancyManager
+	*	Decides which replicated objects every client receives updates for. Objects are kept in an InterestGrid and the
+	*	interest set of a client is the objects within its view radius. Every tick the priority of each object in the set
+	*	is added to an accumulator, scaled by distance, and the objects with the highest accumulated priority are written
+	*	until the byte budget of the client is spent. Written objects start over from zero, so low priority objects are
+	*	delayed but never starved. The cost of a tick grows with the number of relevant objects rather than with
+	*	objects times clients.
+	*
+	*	Updates are sent unreliable, each packet of PacketType holds a sequence of [uint32 ObjectID][uint16 Size][Size bytes].
+	*	Not thread safe, should be ticked from the same thread that registers objects and clients.
+	*/
+	class LAMBDA_API RelevancyManager
+	{
+		struct ReplicatedObject
+		{
+			glm::vec3 Position	= glm::vec3(0.0f);
+			float32 Priority	= 0.0f;
+			bool IsRegistered	= false;
+		};
+
+		struct InterestEntry
+		{
+			uint32 ObjectID			= 0;
+			float32 Accumulated		= 0.0f;
+		};
+
+		struct ClientInterest
+		{
+			glm::vec3 Position			= glm::vec3(0.0f);
+			float32 ViewRadius			= 0.0f;
+			float32 Budget				= 0.0f;
+			TArray<InterestEntry> Interest;		// Sorted by ObjectID
+		};
+
+	public:
+		RelevancyManager(IRelevancyHandler* pHandler, const RelevancyManagerDesc& desc = RelevancyManagerDesc());
+		~RelevancyManager() = default;
+
+		/*
+		* priority - Accumulated per second, an object with twice the priority is updated twice as often
+		* return - The ID of the object, IDs of unregistered objects are reused
+		*/
+		uint32 RegisterObject(const glm::vec3& position, float32 priority);
+		void UnregisterObject(uint32 objectID);
+		void SetObjectPosition(uint32 objectID, const glm::vec3& position);
+		void SetObjectPriority(uint32 objectID, float32 priority);
+
+		void AddClient(IClient* pClient);
+		void RemoveClient(IClient* pClient);
+		void SetClientView(IClient* pClient, const glm::vec3& position, float32 viewRadius);
+
+		/*
+		* Updates the interest sets and sends the most important updates to every client
+		*	delta - Time since the last tick
+		*/
+		void Tick(Timestamp delta);
+
+		/*
+		* return - The number of objects in the interest set of a client
+		*/
+		uint32 GetRelevantObjectCount(IClient* pClient) const;
+
+	private:
+		void UpdateInterest(IClient* pClient, ClientInterest& client);
+		void SendUpdates(IClient* pClient, ClientInterest& client);
+
+	private:
+		IRelevancyHandler* m_pHandler;
+		RelevancyManagerDesc m_Desc;
+		InterestGrid m_Grid;
+		TArray<ReplicatedObject> m_Objects;
+		TArray<uint32> m_FreeObjectIDs;
+		std::unordered_map<IClient*, ClientInterest> m_Clients;
+		TArray<uint32> m_QueryResult;
+		TArray<InterestEntry> m_NewInterest;
+		TArray<InterestEntry*> m_SendOrder;
+		Timestamp m_Delta;
+	};
+}
@@ -3,6 +3,7 @@
 #include "Networking/API/NetWorker.h"
 #include "Networking/API/IServer.h"
 #include "Networking/API/PacketTransceiver.h"
+#include "Networking/API/PacketArena.h"
 
 #include "Containers/THashTable.h"
 
@@ -31,9 +32,23 @@ namespace LambdaEngine
 
 		void SetSimulateReceivingPacketLoss(float32 lossRatio);
 		void SetSimulateTransmittingPacketLoss(float32 lossRatio);
+		void SetSimulatedConditions(const NetworkConditions& conditions);
+
+		/*
+		* Uses an in-process LoopbackSocketUDP instead of an OS socket, takes effect the next time the server is started
+		*	useLoopback - True to only talk to other loopback sockets in the same process
+		*/
+		void SetUseLoopback(bool useLoopback);
+
+		/*
+		* Compresses the datagrams sent by this server, see PacketManager::SetCompressionMode. Applies to connections made after the call
+		*/
+		void SetCompressionMode(ECompressionMode mode);
+
+		const PacketArena* GetPacketArena() const;
 
 	protected:
-		ServerUDP(IServerUDPHandler* pHandler, uint8 maxClients, uint16 packetPerClient, uint8 maximumTries);
+		ServerUDP(IServerUDPHandler* pHandler, uint16 maxClients, uint16 packetPerClient, uint8 maximumTries);
 
 		virtual bool OnThreadsStarted() override;
 		virtual void RunTranmitter() override;
@@ -45,7 +60,9 @@ namespace LambdaEngine
 	private:
 		void Transmit(const IPEndPoint& ipEndPoint, const char* data, int32 bytesToWrite);
 		IClientUDPRemoteHandler* CreateClientUDPHandler();
-		ClientUDPRemote* GetOrCreateClient(const IPEndPoint& sender, bool& newConnection);
+		ClientUDPRemote* GetClient(const IPEndPoint& sender);
+		bool VerifyHandshake(const IPEndPoint& sender, uint64& salt);
+		void SendCookie(const IPEndPoint& sender, uint64 cookie);
 		void OnClientDisconnected(ClientUDPRemote* client, bool sendDisconnectPacket);
 		void SendDisconnect(ClientUDPRemote* client);
 		void SendServerFull(ClientUDPRemote* client);
@@ -53,7 +70,7 @@ namespace LambdaEngine
 		void Tick(Timestamp delta);
 
 	public:
-		static ServerUDP* Create(IServerUDPHandler* pHandler, uint8 maxClients, uint16 packetPoolSize, uint8 maximumTries);
+		static ServerUDP* Create(IServerUDPHandler* pHandler, uint16 maxClients, uint16 packetPoolSize, uint8 maximumTries);
 
 	private:
 		static void FixedTickStatic(Timestamp timestamp);
@@ -65,10 +82,14 @@ namespace LambdaEngine
 		SpinLock m_Lock;
 		SpinLock m_LockClients;
 		uint16 m_PacketsPerClient;
-		uint8 m_MaxClients;
+		uint64 m_CookieKey[2];
+		PacketArena m_PacketArena;
+		uint16 m_MaxClients;
 		uint8 m_MaxTries;
 		float m_PacketLoss;
 		std::atomic_bool m_Accepting;
+		bool m_UseLoopback;
+		ECompressionMode m_CompressionMode;
 		IServerUDPHandler* m_pHandler;
 		std::unordered_map<IPEndPoint, ClientUDPRemote*, IPEndPointHasher> m_Clients;
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "LambdaEngine.h"
+#include "Containers/TArray.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <unordered_map>
+
+namespace LambdaEngine
+{
+	class NetworkStatistics;
+
+	/*
+	* The replicated part of a transform. The padding after the position lets it be loaded as four floats
+	*/
+	struct NetworkTransform
+	{
+		glm::vec3 Position	= glm::vec3(0.0f);
+		float32 Padding		= 0.0f;
+		glm::quat Rotation	= glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	};
+
+	static_assert(sizeof(NetworkTransform) == 8 * sizeof(float32), "NetworkTransform must be eight tightly packed floats");
+
+	struct SnapshotInterpolatorDesc
+	{
+		float32	SnapshotRate		= 20.0f;	// Snapshots per second sent by the server, one interval is always part of the delay
+		float32	JitterMultiplier	= 3.0f;		// Times the jitter that is added to the delay
+		float32	MinDelayMS			= 0.0f;
+		float32	MaxDelayMS			= 500.0f;
+		float32	MaxExtrapolationMS	= 100.0f;	// How far past the newest snapshot an entity is moved before it stops
+	};
+
+	/*
+	* SnapshotInterpolator
+	*	Jitter buffer for entity transforms on a client. Snapshots are stored per entity in a ring buffer ordered by the
+	*	server time they were taken at, and entities are rendered at the server time minus a playout delay so that there
+	*	is almost always a snapshot on both sides of the render time. The delay is one snapshot interval plus a multiple
+	*	of the jitter, which is the larger of the interarrival jitter of the snapshots (RFC 3550) and half the round trip
+	*	variance from NetworkStatistics. Changes to the delay are slewed, faster up than down, so that the render time
+	*	always moves forward.
+	*
+	*	When the render time passes the newest snapshot the entity is extrapolated from the last two, at most
+	*	MaxExtrapolationMS. Snapshots can be added from the receiver thread while the game thread interpolates.
+	*/
+	class LAMBDA_API SnapshotInterpolator
+	{
+		struct Snapshot
+		{
+			uint64 Time;
+			NetworkTransform Transform;
+		};
+
+		static constexpr const uint32 SNAPSHOT_BUFFER_SIZE = 32;
+
+		struct SnapshotBuffer
+		{
+			Snapshot Snapshots[SNAPSHOT_BUFFER_SIZE];
+			uint32 Head		= 0;	// Index of the oldest snapshot
+			uint32 Count	= 0;
+		};
+
+	public:
+		SnapshotInterpolator(const SnapshotInterpolatorDesc& desc = SnapshotInterpolatorDesc());
+		~SnapshotInterpolator() = default;
+
+		/*
+		* Stores a snapshot of an entity, snapshots may arrive out of order
+		*	snapshotTime	- Server time the snapshot was taken at
+		*	arrivalTime		- Estimated server time when the snapshot arrived, see ClockSynchronizer::GetServerTime
+		*/
+		void AddSnapshot(uint32 entityID, Timestamp snapshotTime, const NetworkTransform& transform, Timestamp arrivalTime);
+		void RemoveEntity(uint32 entityID);
+
+		/*
+		* Moves the render time and the playout delay, called once per frame before interpolating
+		*	serverTime	- Estimated server time, see ClockSynchronizer::GetServerTime
+		*	pStatistics	- Statistics of the connection the snapshots arrive on, can be nullptr
+		*/
+		void Tick(Timestamp delta, Timestamp serverTime, const NetworkStatistics* pStatistics);
+
+		/*
+		* return - False if there are no snapshots of the entity
+		*/
+		bool Interpolate(uint32 entityID, NetworkTransform& transform);
+
+		/*
+		* Interpolates every entity that has snapshots
+		*	entityIDs	- Filled with the IDs of the entities
+		*	transforms	- Filled with the transform of each entity in entityIDs
+		*/
+		void InterpolateAll(TArray<uint32>& entityIDs, TArray<NetworkTransform>& transforms);
+
+		Timestamp GetRenderTime() const;
+		Timestamp GetPlayoutDelay() const;
+		Timestamp GetJitter() const;
+
+		void Reset();
+
+	private:
+		bool Sample(SnapshotBuffer& buffer, NetworkTransform& from, NetworkTransform& to, float32& alpha);
+
+	public:
+		/*
+		* Linear interpolation of positions and normalized linear interpolation of rotations with SSE, an alpha above one
+		* extrapolates. Rotations take the shortest path
+		*	pFrom, pTo	- Arrays of count transforms
+		*	pAlphas		- Array of count interpolation factors
+		*	pResult		- Array of count transforms, may be the same as pFrom or pTo
+		*/
+		static void InterpolateTransforms(const NetworkTransform* pFrom, const NetworkTransform* pTo, const float32* pAlphas, NetworkTransform* pResult, uint32 count);
+
+	private:
+		static Snapshot& GetSnapshot(SnapshotBuffer& buffer, uint32 index);
+
+	private:
+		mutable SpinLock m_Lock;
+		SnapshotInterpolatorDesc m_Desc;
+		std::unordered_map<uint32, SnapshotBuffer> m_Entities;
+		uint64 m_RenderTime;
+		float64 m_PlayoutDelay;		// Seconds
+		float64 m_Jitter;			// Seconds
+		int64 m_LastTransitTime;
+		uint64 m_LastSnapshotTime;
+		TArray<NetworkTransform> m_From;
+		TArray<NetworkTransform> m_To;
+		TArray<float32> m_Alphas;
+	};
+}
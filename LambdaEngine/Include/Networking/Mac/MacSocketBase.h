@@ -65,16 +65,16 @@ namespace LambdaEngine
       
         virtual bool EnableBlocking(bool enable) override
         {
-            u_long tempNonBlocking = (u_long)enable;
-            if (ioctl(m_Socket, FIONBIO, &tempNonBlocking) != SOCKET_ERROR)
+            u_long tempNonBlocking = enable ? 0 : 1;
+            if (ioctl(m_Socket, FIONBIO, &tempNonBlocking) == SOCKET_ERROR)
             {
                 int32 error = errno;
-                LOG_ERROR_CRIT("Failed to change blocking mode to [%sBlocking] ", enable ? "Non " : "");
+                LOG_ERROR_CRIT("Failed to change blocking mode to [%sBlocking] ", enable ? "" : "Non ");
                 PrintLastError(error);
                 return false;
             }
             
-            m_NonBlocking = enable;
+            m_NonBlocking = !enable;
             return true;
         };
 
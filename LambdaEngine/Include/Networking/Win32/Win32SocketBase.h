@@ -86,14 +86,15 @@ namespace LambdaEngine
 		*/
 		virtual bool EnableBlocking(bool enable) override
 		{
-			if (ioctlsocket(m_Socket, FIONBIO, &((u_long)enable)) != NO_ERROR)
+			u_long nonBlocking = enable ? 0 : 1;
+			if (ioctlsocket(m_Socket, FIONBIO, &nonBlocking) != NO_ERROR)
 			{
-				LOG_ERROR_CRIT("Failed to change blocking mode to [%sBlocking] ", enable ? "Non " : "");
+				LOG_ERROR_CRIT("Failed to change blocking mode to [%sBlocking] ", enable ? "" : "Non ");
 				PrintLastError();
 				return false;
 			}
 			
-			m_NonBlocking = enable;
+			m_NonBlocking = !enable;
 			return true;
 		};
 
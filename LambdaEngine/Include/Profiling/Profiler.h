@@ -0,0 +1,98 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/String.h"
+
+#ifndef LAMBDA_ENABLE_PROFILER
+	#ifdef LAMBDA_PRODUCTION
+		#define LAMBDA_ENABLE_PROFILER 0
+	#else
+		#define LAMBDA_ENABLE_PROFILER 1
+	#endif
+#endif
+
+#if LAMBDA_ENABLE_PROFILER
+	#define PROFILE_SCOPE(name)		LambdaEngine::ProfileScope STRING_CONCAT(profileScope, __LINE__)(name)
+	#define PROFILE_FUNCTION()		PROFILE_SCOPE(__FUNCTION__)
+	#define PROFILE_THREAD(name)	LambdaEngine::Profiler::SetThreadName(name)
+#else
+	#define PROFILE_SCOPE(name)
+	#define PROFILE_FUNCTION()
+	#define PROFILE_THREAD(name)
+#endif
+
+namespace LambdaEngine
+{
+	/*
+	* Profiler
+	*	Instrumented CPU-profiler. Every thread that records a zone during a capture gets its own ring buffer that only
+	*	that thread writes to, which means that recording a zone never takes a lock. Zones are only recorded
+	*	while a capture is active and can be exported in the Chrome Trace Event format (chrome://tracing)
+	*/
+	class LAMBDA_API Profiler
+	{
+	public:
+		DECL_STATIC_CLASS(Profiler);
+
+		/*
+		* Starts recording zones on all threads. Zones recorded before this call are discarded from the export
+		*/
+		static void BeginCapture();
+
+		/*
+		* Stops recording zones and waits for threads that are writing one. The zones recorded since the last call to
+		* BeginCapture can now be exported
+		*/
+		static void EndCapture();
+
+		static bool IsCapturing();
+
+		/*
+		* Writes all zones from the last capture to a file in the Chrome Trace Event JSON format, the capture has to be
+		* ended first
+		*	filepath	- Path to the file that should be written
+		*	return		- Returns true if the file was written successfully
+		*/
+		static bool ExportChromeTrace(const String& filepath);
+
+		/*
+		* Sets the name that the calling thread will have in the exported trace
+		*	pName - Name of the thread, must be a string-literal or outlive the profiler
+		*/
+		static void SetThreadName(const char* pName);
+
+		/*
+		* Records a finished zone on the calling thread. Should not be called directly, use PROFILE_SCOPE
+		*	pName	- Name of the zone, must be a string-literal or outlive the profiler
+		*	begin	- PlatformTime::GetPerformanceCounter when the zone was entered
+		*	end		- PlatformTime::GetPerformanceCounter when the zone was exited
+		*/
+		static void RecordZone(const char* pName, uint64 begin, uint64 end);
+
+		/*
+		* Releases the ring buffers of all threads that have exited, threads that are still alive release theirs when
+		* they exit
+		*/
+		static void Release();
+	};
+
+#if LAMBDA_ENABLE_PROFILER
+	/*
+	* ProfileScope
+	*	Records the time between construction and destruction as a zone. Use the PROFILE_SCOPE macro.
+	*/
+	class LAMBDA_API ProfileScope
+	{
+	public:
+		DECL_REMOVE_COPY(ProfileScope);
+		DECL_REMOVE_MOVE(ProfileScope);
+
+		ProfileScope(const char* pName);
+		~ProfileScope();
+
+	private:
+		const char*	m_pName;
+		uint64		m_Begin;
+	};
+#endif
+}
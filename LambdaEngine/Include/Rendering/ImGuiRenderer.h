@@ -8,6 +8,8 @@
 
 #include "ICustomRenderer.h"
 
+#include <mutex>
+
 struct ImGuiContext;
 
 namespace LambdaEngine
@@ -137,5 +139,8 @@ namespace LambdaEngine
 
 		THashTable<String, TArray<DescriptorSet*>>					m_TextureResourceNameDescriptorSetsMap;
 		THashTable<GUID_Lambda, THashTable<GUID_Lambda, uint64>>	m_ShadersIDToPipelineStateIDMap;
+
+		// Input events arrive on the main thread while the frame can be built on the render thread, the lock is held from NewFrame until PrepareRender
+		std::mutex				m_InputMutex;
 	};
 }
@@ -275,6 +275,12 @@ namespace LambdaEngine
 		bool GetResourceBuffers(const char* pResourceName, Buffer* const ** pppBuffers, uint32* pBufferCount)							const;
 		bool GetResourceAccelerationStructure(const char* pResourceName, const AccelerationStructure** ppAccelerationStructure)		const;
 
+		/*
+		* Resizes the window relative render stages and resources. Called from OnWindowResized, or with the size from
+		* the FramePacket on the render thread while RenderThread is running
+		*/
+		void SetWindowSize(uint16 width, uint16 height);
+
 		virtual void OnWindowResized(TSharedRef<Window> window, uint16 width, uint16 height, EResizeType type) override;
 
 	private:
@@ -0,0 +1,111 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+#include "Game/Scene.h"
+
+#include "Time/API/Timestamp.h"
+
+#include <functional>
+
+namespace LambdaEngine
+{
+	struct FramePacketTransform
+	{
+		uint32		InstanceIndex;
+		glm::mat4	Transform;
+	};
+
+	/*
+	* Everything the render thread needs from the game thread to render one frame. The game thread fills the packet
+	* returned by RenderThread::GetGamePacket and hands it over with RenderThread::Submit
+	*/
+	struct FramePacket
+	{
+		Timestamp						Delta				= Timestamp(0);
+		uint64							FrameIndex			= 0;
+		CameraData						Camera;
+		bool							HasDirectionalLight	= false;
+		DirectionalLight				DirectionalLight;
+		TArray<FramePacketTransform>	DirtyTransforms;
+		bool							HasWindowSize		= false;
+		uint16							WindowWidth			= 0;
+		uint16							WindowHeight		= 0;
+
+		FORCEINLINE void UpdateTransform(uint32 instanceIndex, const glm::mat4& transform)
+		{
+			DirtyTransforms.PushBack({ instanceIndex, transform });
+		}
+
+		FORCEINLINE void SetDirectionalLight(const struct DirectionalLight& directionalLight)
+		{
+			DirectionalLight	= directionalLight;
+			HasDirectionalLight	= true;
+		}
+
+		/*
+		* Window resizes are handled on the game thread, the render thread resizes the RenderGraph with the last size
+		*/
+		FORCEINLINE void SetWindowSize(uint16 width, uint16 height)
+		{
+			WindowWidth		= width;
+			WindowHeight	= height;
+			HasWindowSize	= true;
+		}
+
+		/*
+		* Applies the camera, light and dirty transforms to the scene, should be called on the render thread
+		*/
+		void ApplyToScene(Scene* pScene) const;
+
+		/*
+		* Clears the per frame changes, the camera is kept
+		*/
+		void Reset();
+	};
+
+	typedef std::function<void(const FramePacket&)> RenderFunc;
+
+	/*
+	* Optional render thread. Frame N is rendered on the render thread while the game thread simulates frame N + 1.
+	* The packets are double buffered, Submit only blocks if the render thread has not finished the previous frame
+	*/
+	class LAMBDA_API RenderThread
+	{
+	public:
+		DECL_STATIC_CLASS(RenderThread);
+
+		/*
+		* Starts the render thread
+		*	renderFunc	- Called on the render thread once per submitted packet. Everything that records commands,
+		*				  uses ImGui or modifies the scene must happen here while the thread is running
+		*	return		- Returns true if successful
+		*/
+		static bool Init(const RenderFunc& renderFunc);
+
+		/*
+		* Waits for the last submitted frame and stops the render thread
+		*/
+		static void Release();
+
+		/*
+		* Hands the game packet over to the render thread and gives the game thread the packet of the previous frame
+		*	delta - The frame time that is stored in the packet
+		*/
+		static void Submit(Timestamp delta);
+
+		/*
+		* Blocks until the render thread has finished all submitted frames, used before the game thread touches
+		* render resources directly (E.g. reloading shaders)
+		*/
+		static void Flush();
+
+		/*
+		* Returns the packet that the game thread writes to this frame
+		*/
+		static FramePacket& GetGamePacket();
+
+		static bool IsRunning();
+	};
+}
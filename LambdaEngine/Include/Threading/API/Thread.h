@@ -11,6 +11,8 @@
 
 #include "Containers/TArray.h"
 
+#include "Time/API/Timestamp.h"
+
 namespace LambdaEngine
 {
 	class LAMBDA_API Thread
@@ -20,7 +22,11 @@ namespace LambdaEngine
 	public:
 		~Thread();
 
-		void Wait();
+		/*
+		* Blocks the calling thread, if it is this thread, until Notify is called
+		*	timeout - Returns after this time even if Notify has not been called, zero waits without a timeout
+		*/
+		void Wait(Timestamp timeout = Timestamp(0));
 		void Notify();
 
 	private:
@@ -20,5 +20,12 @@ namespace LambdaEngine
 		*/
 		static uint64	GetPerformanceCounter()		{ return 0; }
 		static uint64	GetPerformanceFrequency()	{ return 1; }
+
+		/*
+		* Requests a finer resolution of the system timer so that sleeping threads wake up closer to the requested time.
+		* Each call to BeginHighResolutionTimer must be matched with a call to EndHighResolutionTimer
+		*/
+		static void		BeginHighResolutionTimer()	{ }
+		static void		EndHighResolutionTimer()	{ }
 	};
 }
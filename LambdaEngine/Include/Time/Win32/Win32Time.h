@@ -5,6 +5,8 @@
 
 #include "Windows.h"
 
+#include <timeapi.h>
+
 namespace LambdaEngine
 {
 	class Win32Time : public Time
@@ -30,6 +32,16 @@ namespace LambdaEngine
 			return uint64(s_Frequency.QuadPart);
 		}
 
+		static FORCEINLINE void BeginHighResolutionTimer()
+		{
+			::timeBeginPeriod(1);
+		}
+
+		static FORCEINLINE void EndHighResolutionTimer()
+		{
+			::timeEndPeriod(1);
+		}
+
 	private:
 		inline static LARGE_INTEGER s_Frequency = { 1 };
 	};
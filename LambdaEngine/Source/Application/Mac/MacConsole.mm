@@ -8,9 +8,12 @@
 
 #include "Threading/Mac/MacMainThread.h"
 
+#include <stdio.h>
+
 namespace LambdaEngine
 {
     CocoaConsoleWindow* MacConsole::s_pConsoleWindow = nullptr;
+    bool MacConsole::s_IsAttached = false;
 
     void MacConsole::Show()
     {
@@ -34,6 +37,11 @@ namespace LambdaEngine
         }
     }
     
+    void MacConsole::Attach()
+    {
+        s_IsAttached = true;
+    }
+    
     void MacConsole::Close()
     {
         if (s_pConsoleWindow != nullptr)
@@ -86,6 +94,10 @@ namespace LambdaEngine
                 MacApplication::PeekEvents();
             }, false);
         }
+        else if (s_IsAttached)
+        {
+            vfprintf(stdout, pFormat, args);
+        }
     }
 
     void MacConsole::VPrintLine(const char* pFormat, va_list args)
@@ -107,6 +119,11 @@ namespace LambdaEngine
                 MacApplication::PeekEvents();
             }, false);
         }
+        else if (s_IsAttached)
+        {
+            vfprintf(stdout, pFormat, args);
+            fputc('\n', stdout);
+        }
     }
     
     void MacConsole::Clear()
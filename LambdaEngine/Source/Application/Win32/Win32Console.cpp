@@ -28,6 +28,17 @@ namespace LambdaEngine
 		}
 	}
 
+	void Win32Console::Attach()
+	{
+		std::scoped_lock<SpinLock> lock(g_ConsoleLock);
+
+		HANDLE outputHandle = ::GetStdHandle(STD_OUTPUT_HANDLE);
+		if (outputHandle != INVALID_HANDLE_VALUE)
+		{
+			s_OutputHandle = outputHandle;
+		}
+	}
+
 	void Win32Console::Close()
 	{
 		std::scoped_lock<SpinLock> lock(g_ConsoleLock);
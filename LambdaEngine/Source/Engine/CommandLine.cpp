@@ -0,0 +1,58 @@
+#include "Engine/CommandLine.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+namespace LambdaEngine
+{
+	static int32				g_ArgCount	= 0;
+	static const char* const*	g_ppArgs	= nullptr;
+
+	static int32 FindOption(const char* pName)
+	{
+		for (int32 i = 1; i < g_ArgCount; i++)
+		{
+			const char* pArg = g_ppArgs[i];
+			if (pArg[0] == '-' && pArg[1] == '-' && strcmp(pArg + 2, pName) == 0)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	void CommandLine::Init(int32 argc, const char* const argv[])
+	{
+		g_ArgCount	= argc;
+		g_ppArgs	= argv;
+	}
+
+	bool CommandLine::HasOption(const char* pName)
+	{
+		return FindOption(pName) >= 0;
+	}
+
+	const char* CommandLine::GetString(const char* pName, const char* pDefault)
+	{
+		const int32 index = FindOption(pName);
+		if (index < 0 || index + 1 >= g_ArgCount)
+		{
+			return pDefault;
+		}
+
+		return g_ppArgs[index + 1];
+	}
+
+	int32 CommandLine::GetInt32(const char* pName, int32 defaultValue)
+	{
+		const char* pValue = GetString(pName);
+		return pValue ? int32(atoi(pValue)) : defaultValue;
+	}
+
+	float32 CommandLine::GetFloat32(const char* pName, float32 defaultValue)
+	{
+		const char* pValue = GetString(pName);
+		return pValue ? float32(atof(pValue)) : defaultValue;
+	}
+}
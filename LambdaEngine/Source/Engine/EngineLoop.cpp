@@ -1,6 +1,14 @@
 #include "Engine/EngineLoop.h"
 
 #include "Log/Log.h"
+#include "Log/BinaryLog.h"
+
+#include "Engine/FrameStatistics.h"
+#include "Engine/Replay.h"
+
+#include "Profiling/Profiler.h"
+
+#include "Metrics/MetricsRegistry.h"
 
 #include "Time/API/PlatformTime.h"
 #include "Time/API/Clock.h"
@@ -24,53 +32,153 @@
 
 #include "Rendering/RenderSystem.h"
 
+#include <atomic>
+#include <csignal>
+#include <thread>
+
 namespace LambdaEngine
 {
-	static Clock g_Clock;
+	static Clock						g_Clock;
+	static uint64						g_StartCounter			= PlatformTime::GetPerformanceCounter();	// The total time of g_Clock starts when it is constructed
+	static std::atomic_uint64_t			g_FixedTickCount		= 0;
+	static MetricHistogram*				g_pFrameTimeHistogram	= nullptr;
+	static bool							g_IsHeadless			= false;
+	static volatile std::sig_atomic_t	g_ExitRequested			= 0;
+	static std::atomic_uint64_t			g_FixedTimestep			= Timestamp::Seconds(1.0 / 60.0).AsNanoSeconds();	// Nanoseconds, read by network threads
+	static Timestamp					g_FrameTimeLimit		= Timestamp(0);
+	static uint32						g_MaxFixedTicksPerFrame	= 5;
+	static float64						g_FixedTickAlpha		= 0.0;
+
+	static void OnExitSignal(int signal)
+	{
+		UNREFERENCED_VARIABLE(signal);
+		g_ExitRequested = 1;
+	}
+
+	/*
+	* Sleeps until the performance counter reaches deadline. The OS scheduler can oversleep, so the last two
+	* milliseconds are spent yielding instead of sleeping
+	*/
+	static void SleepUntil(uint64 deadline)
+	{
+		const uint64 frequency		= PlatformTime::GetPerformanceFrequency();
+		const uint64 spinThreshold	= frequency / 500;
+
+		uint64 now = PlatformTime::GetPerformanceCounter();
+		while (now < deadline)
+		{
+			const uint64 remaining = deadline - now;
+			if (remaining > spinThreshold)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(((remaining - spinThreshold) * 1000000) / frequency));
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+
+			now = PlatformTime::GetPerformanceCounter();
+		}
+	}
 
 	void EngineLoop::Run()
 	{
-		Clock			fixedClock;
-		const Timestamp timestep	= Timestamp::Seconds(1.0 / 60.0);
-		Timestamp		accumulator = Timestamp(0);
+		Timestamp accumulator = Timestamp(0);
 		
+		PROFILE_THREAD("Main Thread");
+
 		g_Clock.Reset();
 		
 		bool isRunning = true;
 		while (isRunning)
 		{
 			g_Clock.Tick();
+			const uint64 frameStart = PlatformTime::GetPerformanceCounter();
 			
-			// Update
-			Timestamp delta = g_Clock.GetDeltaTime();
-			isRunning = Tick(delta);
-			
-			// Fixed update
+			Timestamp		delta		= g_Clock.GetDeltaTime();
+			const Timestamp timestep	= Timestamp::NanoSeconds(g_FixedTimestep.load(std::memory_order_relaxed));
+
+			// During playback the recorded delta is used so that the same number of fixed ticks run every frame
+			if (!Replay::BeginFrame(delta))
+			{
+				break;
+			}
+
+			// Fixed update, runs before the update so that the interpolation alpha is valid during Game::Tick
+			uint32 fixedTicks = 0;
 			accumulator += delta;
 			while (accumulator >= timestep)
 			{
-				fixedClock.Tick();
-				FixedTick(fixedClock.GetDeltaTime());
+				if (fixedTicks >= g_MaxFixedTicksPerFrame)
+				{
+					// Drop the time we could not catch up with, otherwise every following frame gets slower (Spiral of death)
+					LOG_BINARY_RATE(ELogSeverity::LOG_WARNING, 1, "[EngineLoop]: Fell behind by %llu fixed ticks, skipping them", accumulator.AsNanoSeconds() / timestep.AsNanoSeconds());
+					accumulator = Timestamp::NanoSeconds(accumulator.AsNanoSeconds() % timestep.AsNanoSeconds());
+					break;
+				}
+
+				FixedTick(timestep);
+				g_FixedTickCount.fetch_add(1, std::memory_order_release);
 				
 				accumulator -= timestep;
+				fixedTicks++;
+			}
+
+			g_FixedTickAlpha = accumulator.AsSeconds() / timestep.AsSeconds();
+
+			// Update
+			isRunning = Tick(delta);
+
+			// Statistics always use the measured frametime, also during playback
+			const Timestamp frameTime = g_Clock.GetDeltaTime();
+			FrameStatistics::RegisterFrame(frameTime, fixedTicks);
+			g_pFrameTimeHistogram->Observe(frameTime.AsSeconds());
+
+			if (isRunning)
+			{
+				// Nothing is presented when running headless, so there is no reason to run faster than the fixed tickrate
+				Timestamp untilNextFrame = g_IsHeadless ? (timestep - accumulator) : g_FrameTimeLimit;
+				if (untilNextFrame.AsNanoSeconds() > 0)
+				{
+					const uint64 ticks = (untilNextFrame.AsNanoSeconds() * PlatformTime::GetPerformanceFrequency()) / 1000000000ull;
+					SleepUntil(frameStart + ticks);
+				}
 			}
 		}
 	}
 
 	bool EngineLoop::Tick(Timestamp delta)
 	{
-		Input::Tick();
+		PROFILE_FUNCTION();
+
+		if (!g_IsHeadless)
+		{
+			Input::Tick();
+		}
 
 		Thread::Join();
+
+		MetricsRegistry::Tick();
 		
 		PlatformNetworkUtils::Tick(delta);
 
-		if (!CommonApplication::Get()->Tick())
+		if (g_ExitRequested)
 		{
+			LOG_INFO("[EngineLoop]: Exit requested, shutting down");
 			return false;
 		}
 
-		AudioSystem::Tick();
+		if (!g_IsHeadless)
+		{
+			if (!CommonApplication::Get()->Tick())
+			{
+				return false;
+			}
+
+			AudioSystem::Tick();
+		}
+
+		Replay::SyncInput();
 
 		// Tick game
 		Game::Get()->Tick(delta);
@@ -80,28 +188,63 @@ namespace LambdaEngine
 
 	void EngineLoop::FixedTick(Timestamp delta)
 	{
+		PROFILE_FUNCTION();
+
 		// Tick game
 		Game::Get()->FixedTick(delta);
 		
 		NetworkUtils::FixedTick(delta);
 	}
 
-	bool EngineLoop::PreInit()
+	void EngineLoop::RequestExit()
 	{
+		g_ExitRequested = 1;
+	}
+
+	bool EngineLoop::PreInit(bool isHeadless)
+	{
+		g_IsHeadless = isHeadless;
+
 #ifdef LAMBDA_DEVELOPMENT
-		PlatformConsole::Show();
+		if (!g_IsHeadless)
+		{
+			PlatformConsole::Show();
+		}
 
 		Log::SetDebuggerOutputEnabled(true);
 
 		Malloc::SetDebugFlags(MEMORY_DEBUG_FLAGS_OVERFLOW_PROTECT | MEMORY_DEBUG_FLAGS_LEAK_CHECK);
 #endif
 
-		if (!CommonApplication::PreInit())
+		if (g_IsHeadless)
 		{
-			return false;
+			// Headless builds are console applications, so the console the process was started from is used
+			PlatformConsole::Attach();
+
+			std::signal(SIGINT, OnExitSignal);
+			std::signal(SIGTERM, OnExitSignal);
+		}
+		else
+		{
+			if (!CommonApplication::PreInit())
+			{
+				return false;
+			}
 		}
 
 		PlatformTime::PreInit();
+		PlatformTime::BeginHighResolutionTimer();
+
+		if (!Log::Init())
+		{
+			return false;
+		}
+
+		// Entries fall back to the text log, so a binary log that can not be opened is not fatal
+		if (!BinaryLog::Init())
+		{
+			LOG_WARNING("[EngineLoop]: Binary logging is disabled");
+		}
 			  
 		Random::PreInit();
 
@@ -112,12 +255,23 @@ namespace LambdaEngine
 	{
 		Thread::Init();
 
-		if (!Input::Init())
+		g_pFrameTimeHistogram = MetricsRegistry::RegisterHistogram("lambda_frame_time_seconds", "Time between two frames", { 0.004, 0.008, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25 });
+		MetricsRegistry::RegisterSampledCounter("lambda_memory_allocations_total", "Number of allocations made through Malloc", []() { return Malloc::GetAllocationCount(); });
+		MetricsRegistry::RegisterSampledCounter("lambda_memory_frees_total", "Number of frees made through Malloc", []() { return Malloc::GetFreeCount(); });
+
+		if (!PlatformNetworkUtils::Init())
 		{
 			return false;
 		}
 
-		if (!PlatformNetworkUtils::Init())
+		// A headless engine only runs the simulation and networking
+		if (g_IsHeadless)
+		{
+			LOG_INFO("[EngineLoop]: Running headless, skipping window, input, rendering, audio and resources");
+			return true;
+		}
+
+		if (!Input::Init())
 		{
 			return false;
 		}
@@ -147,6 +301,11 @@ namespace LambdaEngine
 	
 	bool EngineLoop::Release()
 	{
+		if (g_IsHeadless)
+		{
+			return true;
+		}
+
 		Input::Release();
 
 		if (!ResourceManager::Release())
@@ -175,12 +334,28 @@ namespace LambdaEngine
 	bool EngineLoop::PostRelease()
 	{
 		Thread::Release();
+
+		Replay::EndRecording();
+		Replay::EndPlayback();
 		
 		PlatformNetworkUtils::Release();
+
+		MetricsRegistry::Release();
+
+		Profiler::Release();
+
+		BinaryLog::Release();
+
+		Log::Release();
+
+		PlatformTime::EndHighResolutionTimer();
 		
-		if (!CommonApplication::PostRelease())
+		if (!g_IsHeadless)
 		{
-			return false;
+			if (!CommonApplication::PostRelease())
+			{
+				return false;
+			}
 		}
 
 #ifdef LAMBDA_DEVELOPMENT
@@ -193,4 +368,51 @@ namespace LambdaEngine
 	{
 		return g_Clock.GetTotalTime();
 	}
+
+	Timestamp EngineLoop::GetPreciseTimeSinceStart()
+	{
+		constexpr uint64 NANOSECONDS = 1000 * 1000 * 1000;
+		const uint64 frequency	= PlatformTime::GetPerformanceFrequency();
+		const uint64 elapsed	= PlatformTime::GetPerformanceCounter() - g_StartCounter;
+
+		// Whole seconds are converted separately, elapsed * NANOSECONDS overflows after a few minutes
+		return Timestamp((elapsed / frequency) * NANOSECONDS + ((elapsed % frequency) * NANOSECONDS) / frequency);
+	}
+
+	bool EngineLoop::IsHeadless()
+	{
+		return g_IsHeadless;
+	}
+
+	void EngineLoop::SetFixedTickRate(float64 ticksPerSecond)
+	{
+		VALIDATE(ticksPerSecond > 0.0);
+		g_FixedTimestep.store(Timestamp::Seconds(1.0 / ticksPerSecond).AsNanoSeconds(), std::memory_order_release);
+	}
+
+	Timestamp EngineLoop::GetFixedTimestep()
+	{
+		return Timestamp::NanoSeconds(g_FixedTimestep.load(std::memory_order_acquire));
+	}
+
+	uint64 EngineLoop::GetFixedTickCount()
+	{
+		return g_FixedTickCount.load(std::memory_order_acquire);
+	}
+
+	void EngineLoop::SetFrameRateLimit(float64 framesPerSecond)
+	{
+		g_FrameTimeLimit = (framesPerSecond > 0.0) ? Timestamp::Seconds(1.0 / framesPerSecond) : Timestamp(0);
+	}
+
+	void EngineLoop::SetMaxFixedTicksPerFrame(uint32 maxFixedTicks)
+	{
+		VALIDATE(maxFixedTicks > 0);
+		g_MaxFixedTicksPerFrame = maxFixedTicks;
+	}
+
+	float64 EngineLoop::GetFixedTickAlpha()
+	{
+		return g_FixedTickAlpha;
+	}
 }
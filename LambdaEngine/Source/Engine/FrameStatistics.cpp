@@ -0,0 +1,244 @@
+#include "Engine/FrameStatistics.h"
+
+#include "Log/Log.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#include <imgui.h>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 FRAME_STATISTICS_WINDOW_SIZE		= 1024;
+	constexpr const uint32 FRAME_STATISTICS_HISTOGRAM_SIZE	= 32;
+
+	struct FrameStatisticsData
+	{
+		float32		FrameTimes[FRAME_STATISTICS_WINDOW_SIZE]	= { };
+		uint8		FixedTicks[FRAME_STATISTICS_WINDOW_SIZE]	= { };
+		uint32		WriteIndex		= 0;
+		uint32		FrameCount		= 0;
+		uint64		TotalFrames		= 0;
+		uint64		TotalHitches	= 0;
+		Timestamp	FrameBudget		= Timestamp::Seconds(1.0 / 30.0);
+	};
+
+	// RegisterFrame runs on the main thread while the overlay is rendered on the render thread
+	static SpinLock				g_FrameStatisticsLock;
+	static FrameStatisticsData	g_FrameStatistics;
+
+	/*
+	* Copies the statistics so that they can be read without holding the lock
+	*/
+	static FrameStatisticsData GetSnapshot()
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		return g_FrameStatistics;
+	}
+
+	static FrameStatisticsSummary CalculateSummary(const FrameStatisticsData& statistics)
+	{
+		FrameStatisticsSummary summary = {};
+		summary.FrameCount = statistics.FrameCount;
+		if (summary.FrameCount == 0)
+		{
+			return summary;
+		}
+
+		const float32 budget = float32(statistics.FrameBudget.AsMilliSeconds());
+
+		float32 sortedFrameTimes[FRAME_STATISTICS_WINDOW_SIZE];
+		float64 totalFrameTime = 0.0;
+
+		summary.MinFrameTime = FLT64_MAX;
+		for (uint32 i = 0; i < summary.FrameCount; i++)
+		{
+			const float32 frameTime = statistics.FrameTimes[i];
+			sortedFrameTimes[i] = frameTime;
+			totalFrameTime += frameTime;
+
+			summary.MinFrameTime = std::min<float64>(summary.MinFrameTime, frameTime);
+			summary.MaxFrameTime = std::max<float64>(summary.MaxFrameTime, frameTime);
+
+			if (frameTime > budget)
+			{
+				summary.Hitches++;
+			}
+
+			const uint32 fixedTicks = statistics.FixedTicks[i];
+			if (fixedTicks > 1)
+			{
+				summary.CatchUpFrames++;
+			}
+
+			summary.MaxFixedTicks = std::max(summary.MaxFixedTicks, fixedTicks);
+		}
+
+		std::sort(sortedFrameTimes, sortedFrameTimes + summary.FrameCount);
+
+		const uint32 lastIndex = summary.FrameCount - 1;
+		summary.AvgFrameTime = totalFrameTime / float64(summary.FrameCount);
+		summary.P50FrameTime = sortedFrameTimes[(lastIndex * 50) / 100];
+		summary.P95FrameTime = sortedFrameTimes[(lastIndex * 95) / 100];
+		summary.P99FrameTime = sortedFrameTimes[(lastIndex * 99) / 100];
+		return summary;
+	}
+
+	void FrameStatistics::SetFrameBudget(Timestamp budget)
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		g_FrameStatistics.FrameBudget = budget;
+	}
+
+	Timestamp FrameStatistics::GetFrameBudget()
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		return g_FrameStatistics.FrameBudget;
+	}
+
+	FrameStatisticsSummary FrameStatistics::GetSummary()
+	{
+		return CalculateSummary(GetSnapshot());
+	}
+
+	uint64 FrameStatistics::GetTotalHitches()
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		return g_FrameStatistics.TotalHitches;
+	}
+
+	uint64 FrameStatistics::GetTotalFrames()
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		return g_FrameStatistics.TotalFrames;
+	}
+
+	void FrameStatistics::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		const Timestamp budget = g_FrameStatistics.FrameBudget;
+		g_FrameStatistics = FrameStatisticsData();
+		g_FrameStatistics.FrameBudget = budget;
+	}
+
+	void FrameStatistics::RenderStatisticsWithImGUI()
+	{
+		const FrameStatisticsData		statistics	= GetSnapshot();
+		const FrameStatisticsSummary	summary		= CalculateSummary(statistics);
+
+		ImGui::SetNextWindowSize(ImVec2(430, 450), ImGuiCond_FirstUseEver);
+		if (ImGui::Begin("Frame Statistics", NULL))
+		{
+			ImGui::Text("Frames            %llu", (unsigned long long)statistics.TotalFrames);
+			ImGui::Text("Min               %.2f ms", summary.MinFrameTime);
+			ImGui::Text("Avg               %.2f ms (%.1f FPS)", summary.AvgFrameTime, summary.AvgFrameTime > 0.0 ? 1000.0 / summary.AvgFrameTime : 0.0);
+			ImGui::Text("Max               %.2f ms", summary.MaxFrameTime);
+			ImGui::Text("P50 / P95 / P99   %.2f / %.2f / %.2f ms", summary.P50FrameTime, summary.P95FrameTime, summary.P99FrameTime);
+			ImGui::Text("Budget            %.2f ms", statistics.FrameBudget.AsMilliSeconds());
+			ImGui::Text("Hitches           %u (Total %llu)", summary.Hitches, (unsigned long long)statistics.TotalHitches);
+			ImGui::Text("Catch-up Frames   %u (Max %u fixed ticks)", summary.CatchUpFrames, summary.MaxFixedTicks);
+
+			ImGui::NewLine();
+
+			// The plot starts at the oldest frame in the window
+			const uint32 offset = statistics.FrameCount < FRAME_STATISTICS_WINDOW_SIZE ? 0 : statistics.WriteIndex;
+			ImGui::PlotLines("Frametime", statistics.FrameTimes, int(statistics.FrameCount), int(offset), nullptr, 0.0f, float32(summary.MaxFrameTime), ImVec2(0, 80));
+
+			float32 histogram[FRAME_STATISTICS_HISTOGRAM_SIZE] = { };
+			const float64 bucketSize = std::max(summary.MaxFrameTime / float64(FRAME_STATISTICS_HISTOGRAM_SIZE), 0.001);
+			for (uint32 i = 0; i < statistics.FrameCount; i++)
+			{
+				const uint32 bucket = std::min(uint32(statistics.FrameTimes[i] / bucketSize), FRAME_STATISTICS_HISTOGRAM_SIZE - 1);
+				histogram[bucket] += 1.0f;
+			}
+
+			ImGui::PlotHistogram("Distribution", histogram, int(FRAME_STATISTICS_HISTOGRAM_SIZE), 0, nullptr, 0.0f, FLT32_MAX, ImVec2(0, 80));
+			ImGui::Text("Bucket size       %.2f ms", bucketSize);
+		}
+		ImGui::End();
+	}
+
+	bool FrameStatistics::ExportFramesCSV(const String& filepath)
+	{
+		FILE* pFile = fopen(filepath.c_str(), "w");
+		if (!pFile)
+		{
+			LOG_ERROR("[FrameStatistics]: Failed to open '%s'", filepath.c_str());
+			return false;
+		}
+
+		const FrameStatisticsData statistics = GetSnapshot();
+
+		const float32	budget		= float32(statistics.FrameBudget.AsMilliSeconds());
+		const uint32	frameCount	= statistics.FrameCount;
+		const uint32	offset		= frameCount < FRAME_STATISTICS_WINDOW_SIZE ? 0 : statistics.WriteIndex;
+		const uint64	firstFrame	= statistics.TotalFrames - frameCount;
+
+		fputs("Frame,FrameTimeMs,FixedTicks,Hitch\n", pFile);
+		for (uint32 i = 0; i < frameCount; i++)
+		{
+			const uint32	index		= (offset + i) % FRAME_STATISTICS_WINDOW_SIZE;
+			const float32	frameTime	= statistics.FrameTimes[index];
+			fprintf(pFile, "%llu,%.4f,%u,%d\n", (unsigned long long)(firstFrame + i), frameTime, uint32(statistics.FixedTicks[index]), frameTime > budget ? 1 : 0);
+		}
+
+		fclose(pFile);
+		return true;
+	}
+
+	bool FrameStatistics::AppendSummaryCSV(const String& filepath, const String& label)
+	{
+		FILE* pFile = fopen(filepath.c_str(), "a");
+		if (!pFile)
+		{
+			LOG_ERROR("[FrameStatistics]: Failed to open '%s'", filepath.c_str());
+			return false;
+		}
+
+		fseek(pFile, 0, SEEK_END);
+		if (ftell(pFile) == 0)
+		{
+			fputs("Label,Frames,MinMs,AvgMs,MaxMs,P50Ms,P95Ms,P99Ms,BudgetMs,Hitches,TotalHitches,CatchUpFrames,MaxFixedTicks\n", pFile);
+		}
+
+		const FrameStatisticsData		statistics	= GetSnapshot();
+		const FrameStatisticsSummary	summary		= CalculateSummary(statistics);
+		fprintf(pFile, "%s,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%llu,%u,%u\n",
+			label.c_str(),
+			summary.FrameCount,
+			summary.MinFrameTime,
+			summary.AvgFrameTime,
+			summary.MaxFrameTime,
+			summary.P50FrameTime,
+			summary.P95FrameTime,
+			summary.P99FrameTime,
+			statistics.FrameBudget.AsMilliSeconds(),
+			summary.Hitches,
+			(unsigned long long)statistics.TotalHitches,
+			summary.CatchUpFrames,
+			summary.MaxFixedTicks);
+
+		fclose(pFile);
+		return true;
+	}
+
+	void FrameStatistics::RegisterFrame(Timestamp delta, uint32 fixedTicks)
+	{
+		const float32 frameTime = float32(delta.AsMilliSeconds());
+
+		std::scoped_lock<SpinLock> lock(g_FrameStatisticsLock);
+		g_FrameStatistics.FrameTimes[g_FrameStatistics.WriteIndex] = frameTime;
+		g_FrameStatistics.FixedTicks[g_FrameStatistics.WriteIndex] = uint8(std::min<uint32>(fixedTicks, UINT8_MAX));
+		g_FrameStatistics.WriteIndex = (g_FrameStatistics.WriteIndex + 1) % FRAME_STATISTICS_WINDOW_SIZE;
+		g_FrameStatistics.FrameCount = std::min(g_FrameStatistics.FrameCount + 1, FRAME_STATISTICS_WINDOW_SIZE);
+		g_FrameStatistics.TotalFrames++;
+
+		if (delta > g_FrameStatistics.FrameBudget)
+		{
+			g_FrameStatistics.TotalHitches++;
+		}
+	}
+}
@@ -0,0 +1,488 @@
+#include "Engine/Replay.h"
+#include "Engine/EngineLoop.h"
+
+#include "Input/API/Input.h"
+
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/IPAddress.h"
+
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+#include "Containers/String.h"
+
+#include "Log/Log.h"
+
+#include "Math/Random.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 REPLAY_MAGIC		= 0x4C50524C; // "LRPL"
+	constexpr const uint32 REPLAY_VERSION	= 2;
+
+	constexpr const uint32 REPLAY_KEY_COUNT		= ARR_SIZE(KeyboardState::KeyStates);
+	constexpr const uint32 REPLAY_KEY_BYTES		= (REPLAY_KEY_COUNT + 7) / 8;
+	constexpr const uint32 REPLAY_BUTTON_COUNT	= ARR_SIZE(MouseState::ButtonStates);
+	static_assert(REPLAY_BUTTON_COUNT <= 8, "Mouse buttons are stored as a single byte");
+
+	enum EReplayBlock : uint8
+	{
+		REPLAY_BLOCK_FRAME		= 0,
+		REPLAY_BLOCK_DATAGRAM	= 1,
+	};
+
+	/*
+	* Input is only stored when it differs from the previous frame, keys and buttons are stored as bits
+	*/
+	struct ReplayInput
+	{
+		uint8	Keys[REPLAY_KEY_BYTES];
+		int32	MouseX;
+		int32	MouseY;
+		int32	ScrollX;
+		int32	ScrollY;
+		uint8	Buttons;
+
+		bool operator==(const ReplayInput& other) const
+		{
+			return memcmp(Keys, other.Keys, sizeof(Keys)) == 0
+				&& MouseX	== other.MouseX
+				&& MouseY	== other.MouseY
+				&& ScrollX	== other.ScrollX
+				&& ScrollY	== other.ScrollY
+				&& Buttons	== other.Buttons;
+		}
+	};
+
+	struct ReplayFrame
+	{
+		Timestamp	Delta;
+		bool		HasInput;
+		ReplayInput	Input;
+	};
+
+	struct ReplayDatagram
+	{
+		uint32			FrameIndex;
+		String			Address;
+		uint16			Port;
+		TArray<char>	Data;
+	};
+
+	static std::mutex										g_ReplayLock;
+	static std::condition_variable							g_DatagramCondition;
+	static FILE*											g_pReplayFile		= nullptr;
+	static std::atomic_bool									g_IsRecording		= false;
+	static std::atomic_bool									g_IsPlaying			= false;
+	static std::atomic<uint32>								g_FrameIndex		= 0;
+	static std::atomic<uint32>								g_StreamCount		= 0;
+	static uint32											g_FramesStarted		= 0;
+	static Timestamp										g_RecordedDelta		= Timestamp(0);
+	static ReplayInput										g_LastInput			= { };
+	static bool												g_HasLastInput		= false;
+	static TArray<ReplayFrame>								g_Frames;
+	static THashTable<uint32, std::deque<ReplayDatagram>>	g_Datagrams;
+
+	static void WriteData(const void* pData, uint32 size)
+	{
+		fwrite(pData, 1, size, g_pReplayFile);
+	}
+
+	template<typename T>
+	static void WriteValue(const T& value)
+	{
+		WriteData(&value, sizeof(T));
+	}
+
+	template<typename T>
+	static bool ReadValue(const TArray<char>& buffer, uint64& offset, T& value)
+	{
+		if (offset + sizeof(T) > buffer.GetSize())
+		{
+			return false;
+		}
+
+		memcpy(&value, buffer.GetData() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	static void CaptureInput(ReplayInput& input)
+	{
+		memset(&input, 0, sizeof(input));
+
+		const KeyboardState& keyboardState = Input::GetKeyboardState();
+		for (uint32 key = 0; key < REPLAY_KEY_COUNT; key++)
+		{
+			if (keyboardState.KeyStates[key])
+			{
+				input.Keys[key / 8] |= uint8(1 << (key % 8));
+			}
+		}
+
+		const MouseState& mouseState = Input::GetMouseState();
+		input.MouseX	= mouseState.x;
+		input.MouseY	= mouseState.y;
+		input.ScrollX	= mouseState.ScrollX;
+		input.ScrollY	= mouseState.ScrollY;
+		for (uint32 button = 0; button < REPLAY_BUTTON_COUNT; button++)
+		{
+			if (mouseState.ButtonStates[button])
+			{
+				input.Buttons |= uint8(1 << button);
+			}
+		}
+	}
+
+	static bool ParseReplay(const TArray<char>& buffer, uint32& seed)
+	{
+		uint64 offset = 0;
+
+		uint32 magic	= 0;
+		uint32 version	= 0;
+		if (!ReadValue(buffer, offset, magic) || !ReadValue(buffer, offset, version) || magic != REPLAY_MAGIC || version != REPLAY_VERSION)
+		{
+			LOG_ERROR("[Replay]: Not a replay or unsupported version");
+			return false;
+		}
+
+		if (!ReadValue(buffer, offset, seed))
+		{
+			return false;
+		}
+
+		uint8 block = 0;
+		while (ReadValue(buffer, offset, block))
+		{
+			if (block == REPLAY_BLOCK_FRAME)
+			{
+				ReplayFrame frame = { };
+				uint64 deltaNanoSeconds = 0;
+				uint8 hasInput = 0;
+				if (!ReadValue(buffer, offset, deltaNanoSeconds) || !ReadValue(buffer, offset, hasInput))
+				{
+					return false;
+				}
+
+				frame.Delta		= Timestamp(deltaNanoSeconds);
+				frame.HasInput	= hasInput != 0;
+				if (frame.HasInput && !ReadValue(buffer, offset, frame.Input))
+				{
+					return false;
+				}
+
+				g_Frames.PushBack(frame);
+			}
+			else if (block == REPLAY_BLOCK_DATAGRAM)
+			{
+				uint32 stream			= 0;
+				uint8 addressLength		= 0;
+				uint16 size				= 0;
+				ReplayDatagram datagram	= { };
+				if (!ReadValue(buffer, offset, stream) || !ReadValue(buffer, offset, datagram.FrameIndex) || !ReadValue(buffer, offset, datagram.Port) || !ReadValue(buffer, offset, addressLength))
+				{
+					return false;
+				}
+
+				if (offset + addressLength > buffer.GetSize())
+				{
+					return false;
+				}
+
+				datagram.Address.assign(buffer.GetData() + offset, addressLength);
+				offset += addressLength;
+
+				if (!ReadValue(buffer, offset, size) || offset + size > buffer.GetSize())
+				{
+					return false;
+				}
+
+				datagram.Data.Resize(size);
+				memcpy(datagram.Data.GetData(), buffer.GetData() + offset, size);
+				offset += size;
+
+				g_Datagrams[stream].push_back(std::move(datagram));
+			}
+			else
+			{
+				LOG_ERROR("[Replay]: Unknown block %u", uint32(block));
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Replay::BeginRecording(const char* pFilepath)
+	{
+		VALIDATE(!g_IsPlaying);
+
+		std::scoped_lock<std::mutex> lock(g_ReplayLock);
+		if (g_pReplayFile)
+		{
+			LOG_WARNING("[Replay]: Already recording");
+			return false;
+		}
+
+		g_pReplayFile = fopen(pFilepath, "wb");
+		if (!g_pReplayFile)
+		{
+			LOG_ERROR("[Replay]: Failed to create '%s'", pFilepath);
+			return false;
+		}
+
+		// Salts and cookie keys come from Random, the playback has to generate the same ones to accept the recorded handshakes
+		const uint32 seed = Random::GetSeed();
+		Random::Seed(seed);
+
+		WriteValue(REPLAY_MAGIC);
+		WriteValue(REPLAY_VERSION);
+		WriteValue(seed);
+
+		g_FrameIndex	= 0;
+		g_FramesStarted	= 0;
+		g_HasLastInput	= false;
+		g_IsRecording	= true;
+
+		LOG_INFO("[Replay]: Recording to '%s'", pFilepath);
+		return true;
+	}
+
+	void Replay::EndRecording()
+	{
+		std::scoped_lock<std::mutex> lock(g_ReplayLock);
+		if (g_pReplayFile)
+		{
+			g_IsRecording = false;
+
+			fclose(g_pReplayFile);
+			g_pReplayFile = nullptr;
+
+			LOG_INFO("[Replay]: Recorded %u frames", g_FramesStarted);
+		}
+	}
+
+	bool Replay::BeginPlayback(const char* pFilepath)
+	{
+		VALIDATE(!g_IsRecording);
+
+		FILE* pFile = fopen(pFilepath, "rb");
+		if (!pFile)
+		{
+			LOG_ERROR("[Replay]: Failed to open '%s'", pFilepath);
+			return false;
+		}
+
+		fseek(pFile, 0, SEEK_END);
+		const long fileSize = ftell(pFile);
+		fseek(pFile, 0, SEEK_SET);
+
+		TArray<char> buffer(uint32(fileSize > 0 ? fileSize : 0));
+		const bool readAll = fread(buffer.GetData(), 1, buffer.GetSize(), pFile) == buffer.GetSize();
+		fclose(pFile);
+
+		std::scoped_lock<std::mutex> lock(g_ReplayLock);
+		g_Frames.Clear();
+		g_Datagrams.clear();
+
+		uint32 seed = 0;
+		if (!readAll || !ParseReplay(buffer, seed))
+		{
+			LOG_ERROR("[Replay]: '%s' is corrupt", pFilepath);
+			g_Frames.Clear();
+			g_Datagrams.clear();
+			return false;
+		}
+
+		Random::Seed(seed);
+
+		g_FrameIndex	= 0;
+		g_FramesStarted	= 0;
+		g_HasLastInput	= false;
+		g_IsPlaying		= true;
+
+		LOG_INFO("[Replay]: Playing '%s' (%u frames)", pFilepath, g_Frames.GetSize());
+		return true;
+	}
+
+	void Replay::EndPlayback()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(g_ReplayLock);
+			g_IsPlaying = false;
+			g_Frames.Clear();
+			g_Datagrams.clear();
+		}
+
+		g_DatagramCondition.notify_all();
+	}
+
+	bool Replay::IsRecording()
+	{
+		return g_IsRecording;
+	}
+
+	bool Replay::IsPlaying()
+	{
+		return g_IsPlaying;
+	}
+
+	uint32 Replay::GetFrameIndex()
+	{
+		return g_FrameIndex;
+	}
+
+	bool Replay::BeginFrame(Timestamp& delta)
+	{
+		if (g_IsRecording)
+		{
+			g_FrameIndex	= g_FramesStarted++;
+			g_RecordedDelta	= delta;
+		}
+		else if (g_IsPlaying)
+		{
+			if (g_FramesStarted >= g_Frames.GetSize())
+			{
+				LOG_INFO("[Replay]: Playback finished after %u frames", g_FramesStarted);
+				EndPlayback();
+				return false;
+			}
+
+			{
+				std::scoped_lock<std::mutex> lock(g_ReplayLock);
+				g_FrameIndex = g_FramesStarted++;
+			}
+
+			g_DatagramCondition.notify_all();
+
+			delta = g_Frames[g_FrameIndex].Delta;
+		}
+
+		return true;
+	}
+
+	void Replay::SyncInput()
+	{
+		// There is no input when running headless, the frames only contain the deltas
+		const bool hasInputSystem = !EngineLoop::IsHeadless();
+
+		if (g_IsRecording)
+		{
+			ReplayInput input = { };
+			bool inputChanged = false;
+			if (hasInputSystem)
+			{
+				CaptureInput(input);
+				inputChanged = !g_HasLastInput || !(input == g_LastInput);
+				g_LastInput		= input;
+				g_HasLastInput	= true;
+			}
+
+			std::scoped_lock<std::mutex> lock(g_ReplayLock);
+			if (g_pReplayFile)
+			{
+				WriteValue(uint8(REPLAY_BLOCK_FRAME));
+				WriteValue(g_RecordedDelta.AsNanoSeconds());
+				WriteValue(uint8(inputChanged ? 1 : 0));
+				if (inputChanged)
+				{
+					WriteValue(input);
+				}
+			}
+		}
+		else if (g_IsPlaying && hasInputSystem && g_FramesStarted > 0)
+		{
+			const ReplayFrame& frame = g_Frames[g_FrameIndex];
+			if (!frame.HasInput)
+			{
+				if (!g_HasLastInput)
+				{
+					return;
+				}
+			}
+			else
+			{
+				g_LastInput		= frame.Input;
+				g_HasLastInput	= true;
+			}
+
+			// Overwrite everything the platform reported this frame
+			KeyboardState& keyboardState = Input::s_pInstance->m_KeyboardState;
+			for (uint32 key = 0; key < REPLAY_KEY_COUNT; key++)
+			{
+				keyboardState.KeyStates[key] = (g_LastInput.Keys[key / 8] >> (key % 8)) & 1;
+			}
+
+			MouseState& mouseState = Input::s_pInstance->m_MouseState;
+			mouseState.x		= g_LastInput.MouseX;
+			mouseState.y		= g_LastInput.MouseY;
+			mouseState.ScrollX	= g_LastInput.ScrollX;
+			mouseState.ScrollY	= g_LastInput.ScrollY;
+			for (uint32 button = 0; button < REPLAY_BUTTON_COUNT; button++)
+			{
+				mouseState.ButtonStates[button] = (g_LastInput.Buttons >> button) & 1;
+			}
+		}
+	}
+
+	uint32 Replay::RegisterStream()
+	{
+		return g_StreamCount++;
+	}
+
+	void Replay::RecordDatagram(uint32 stream, const IPEndPoint& sender, const char* pBuffer, int32 size)
+	{
+		const std::string& address = sender.GetAddress()->ToString();
+
+		std::scoped_lock<std::mutex> lock(g_ReplayLock);
+		if (g_pReplayFile)
+		{
+			WriteValue(uint8(REPLAY_BLOCK_DATAGRAM));
+			WriteValue(stream);
+			WriteValue(uint32(g_FrameIndex));
+			WriteValue(sender.GetPort());
+			WriteValue(uint8(address.size()));
+			WriteData(address.c_str(), uint32(uint8(address.size())));
+			WriteValue(uint16(size));
+			WriteData(pBuffer, uint32(uint16(size)));
+		}
+	}
+
+	bool Replay::PlaybackDatagram(uint32 stream, IPEndPoint& sender, char* pBuffer, int32 bufferSize, int32& size)
+	{
+		std::unique_lock<std::mutex> lock(g_ReplayLock);
+
+		// The receiver threads wait here instead of in the socket, the timeout lets them check if they should terminate
+		auto isReady = [stream]()
+		{
+			if (!g_IsPlaying)
+			{
+				return true;
+			}
+
+			auto it = g_Datagrams.find(stream);
+			return it != g_Datagrams.end() && !it->second.empty() && it->second.front().FrameIndex <= g_FrameIndex;
+		};
+
+		if (!g_DatagramCondition.wait_for(lock, std::chrono::milliseconds(10), isReady) || !g_IsPlaying)
+		{
+			return false;
+		}
+
+		std::deque<ReplayDatagram>& datagrams = g_Datagrams[stream];
+		ReplayDatagram& datagram = datagrams.front();
+
+		size = std::min<int32>(bufferSize, int32(datagram.Data.GetSize()));
+		memcpy(pBuffer, datagram.Data.GetData(), size);
+		sender.SetEndPoint(IPAddress::Get(datagram.Address), datagram.Port);
+
+		datagrams.pop_front();
+		return true;
+	}
+}
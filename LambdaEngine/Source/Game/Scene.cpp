@@ -22,6 +22,8 @@
 #include "Time/API/Clock.h"
 #include "Math/Random.h"
 
+#include "Profiling/Profiler.h"
+
 namespace LambdaEngine
 {
 	Scene::Scene(const GraphicsDevice* pGraphicsDevice, const IAudioDevice* pAudioDevice) :
@@ -178,6 +180,8 @@ namespace LambdaEngine
 
 	bool Scene::Finalize()
 	{
+		PROFILE_FUNCTION();
+
 		LambdaEngine::Clock clock;
 
 		clock.Reset();
@@ -624,6 +628,11 @@ namespace LambdaEngine
 		m_PerFrameData.Camera = pCamera->GetData();
 	}
 
+	void Scene::UpdateCamera(const CameraData& camera)
+	{
+		m_PerFrameData.Camera = camera;
+	}
+
 	void Scene::UpdateMaterialProperties(GUID_Lambda materialGUID)
 	{
 		m_SceneMaterialProperties[m_GUIDToMaterials[materialGUID]] = ResourceManager::GetMaterial(materialGUID)->Properties;
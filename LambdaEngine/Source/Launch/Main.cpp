@@ -1,19 +1,28 @@
 #include "Engine/EngineLoop.h"
+#include "Engine/Replay.h"
+#include "Engine/CommandLine.h"
 
 namespace LambdaEngine
 {
 	extern Game* CreateGame();
 }
 
-#ifdef LAMBDA_PLATFORM_WINDOWS
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
-#else
-int main(int, const char*[])
-#endif 
+/*
+* Command line: [--record <file>] [--replay <file>], the rest is available to the game through CommandLine
+*/
+static int EngineMain(int argc, const char* const argv[])
 {
 	using namespace LambdaEngine;
 
-	if (!EngineLoop::PreInit())
+	CommandLine::Init(argc, argv);
+
+#ifdef LAMBDA_HEADLESS
+	constexpr bool isHeadless = true;
+#else
+	constexpr bool isHeadless = false;
+#endif
+
+	if (!EngineLoop::PreInit(isHeadless))
 	{
 		return -1;
 	}
@@ -23,7 +32,17 @@ int main(int, const char*[])
 		return -1;
 	}
 
-	Game* pGame = CreateGame();	
+	// Started before the game is created so that the network streams are registered in the same order
+	if (const char* pRecordPath = CommandLine::GetString("record"))
+	{
+		Replay::BeginRecording(pRecordPath);
+	}
+	else if (const char* pReplayPath = CommandLine::GetString("replay"))
+	{
+		Replay::BeginPlayback(pReplayPath);
+	}
+
+	Game* pGame = CreateGame();
 	EngineLoop::Run();
 
 	SAFEDELETE(pGame);
@@ -32,7 +51,7 @@ int main(int, const char*[])
 	{
 		return -1;
 	}
-	
+
 	if (!EngineLoop::PostRelease())
 	{
 		return -1;
@@ -40,3 +59,15 @@ int main(int, const char*[])
 
 	return 0;
 }
+
+#if defined(LAMBDA_PLATFORM_WINDOWS) && !defined(LAMBDA_HEADLESS)
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
+{
+	return EngineMain(__argc, __argv);
+}
+#else
+int main(int argc, const char* argv[])
+{
+	return EngineMain(argc, argv);
+}
+#endif
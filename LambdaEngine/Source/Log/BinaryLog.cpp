@@ -0,0 +1,204 @@
+#include "Log/BinaryLog.h"
+
+#include "Containers/TSet.h"
+#include "Containers/TLockFreeQueue.h"
+
+#include "Time/API/PlatformTime.h"
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <stdio.h>
+#include <string.h>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 BINARY_LOG_QUEUE_SIZE = 4096;
+
+	static TLockFreeQueue<BinaryLogRecord>*	g_pBinaryLogQueue			= nullptr;
+	static std::thread						g_BinaryLogThread;
+	static std::atomic_bool					g_BinaryLogIsRunning		= false;
+	static std::mutex						g_BinaryLogMutex;
+	static std::condition_variable			g_BinaryLogCondition;
+	static std::atomic_uint32_t				g_BinaryLogDroppedRecords	= 0;
+	static std::atomic_uint32_t				g_BinaryLogThreadCount		= 0;
+	static thread_local uint32				t_BinaryLogThreadID			= UINT32_MAX;
+	static FILE*							g_pBinaryLogFile			= nullptr;
+	static TSet<uint32>						g_BinaryLogWrittenCallSites;
+
+	static void WriteCallSite(const BinaryLogCallSite& callSite)
+	{
+		const uint64 fileLength		= strlen(callSite.pFile);
+		const uint64 formatLength	= strlen(callSite.pFormat);
+
+		BinaryLogCallSiteHeader header = {};
+		header.ID			= callSite.ID;
+		header.Severity		= uint8(callSite.Severity);
+		header.Line			= callSite.Line;
+		header.FileLength	= uint16(fileLength < UINT16_MAX ? fileLength : UINT16_MAX);
+		header.FormatLength	= uint16(formatLength < UINT16_MAX ? formatLength : UINT16_MAX);
+
+		const uint8 block = uint8(EBinaryLogBlock::BLOCK_CALL_SITE);
+		fwrite(&block, sizeof(block), 1, g_pBinaryLogFile);
+		fwrite(&header, sizeof(header), 1, g_pBinaryLogFile);
+		fwrite(callSite.pFile, 1, header.FileLength, g_pBinaryLogFile);
+		fwrite(callSite.pFormat, 1, header.FormatLength, g_pBinaryLogFile);
+	}
+
+	static void WriteRecord(const BinaryLogRecord& record)
+	{
+		const BinaryLogCallSite* pCallSite = record.pCallSite;
+		if (g_BinaryLogWrittenCallSites.insert(pCallSite->ID).second)
+		{
+			WriteCallSite(*pCallSite);
+		}
+
+		BinaryLogEntryHeader header = {};
+		header.ID			= pCallSite->ID;
+		header.ThreadID		= record.ThreadID;
+		header.Timestamp	= record.Timestamp;
+		header.Suppressed	= record.Suppressed;
+		header.ArgumentSize	= record.ArgumentSize;
+
+		const uint8 block = uint8(EBinaryLogBlock::BLOCK_ENTRY);
+		fwrite(&block, sizeof(block), 1, g_pBinaryLogFile);
+		fwrite(&header, sizeof(header), 1, g_pBinaryLogFile);
+		fwrite(record.Arguments, 1, record.ArgumentSize, g_pBinaryLogFile);
+	}
+
+	static void RunBinaryLogThread()
+	{
+		BinaryLogRecord record;
+		for (;;)
+		{
+			// Read the flag before draining so that everything pushed before Release gets written
+			const bool isRunning = g_BinaryLogIsRunning.load(std::memory_order_acquire);
+
+			while (g_pBinaryLogQueue->TryPop(record))
+			{
+				WriteRecord(record);
+			}
+
+			const uint32 droppedRecords = g_BinaryLogDroppedRecords.exchange(0);
+			if (droppedRecords > 0)
+			{
+				LOG_WARNING("[BinaryLog]: Queue was full, %u entries were dropped", droppedRecords);
+			}
+
+			fflush(g_pBinaryLogFile);
+
+			if (!isRunning)
+			{
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock(g_BinaryLogMutex);
+			g_BinaryLogCondition.wait_for(lock, std::chrono::milliseconds(10));
+		}
+	}
+
+	/*
+	* BinaryLog
+	*/
+	bool BinaryLog::Init(const char* pFilepath)
+	{
+		if (g_BinaryLogIsRunning)
+		{
+			return true;
+		}
+
+		g_pBinaryLogFile = fopen(pFilepath, "wb");
+		if (!g_pBinaryLogFile)
+		{
+			LOG_ERROR("[BinaryLog]: Failed to open '%s'", pFilepath);
+			return false;
+		}
+
+		BinaryLogFileHeader header = {};
+		header.Magic			= BINARY_LOG_MAGIC;
+		header.Version			= BINARY_LOG_VERSION;
+		header.TimerFrequency	= PlatformTime::GetPerformanceFrequency();
+		fwrite(&header, sizeof(header), 1, g_pBinaryLogFile);
+
+		g_pBinaryLogQueue = DBG_NEW TLockFreeQueue<BinaryLogRecord>(BINARY_LOG_QUEUE_SIZE);
+		g_BinaryLogWrittenCallSites.clear();
+
+		g_BinaryLogIsRunning	= true;
+		g_BinaryLogThread		= std::thread(RunBinaryLogThread);
+		return true;
+	}
+
+	void BinaryLog::Release()
+	{
+		if (!g_BinaryLogIsRunning)
+		{
+			return;
+		}
+
+		g_BinaryLogIsRunning.store(false, std::memory_order_release);
+		g_BinaryLogCondition.notify_one();
+
+		if (g_BinaryLogThread.joinable())
+		{
+			g_BinaryLogThread.join();
+		}
+
+		fclose(g_pBinaryLogFile);
+		g_pBinaryLogFile = nullptr;
+
+		SAFEDELETE(g_pBinaryLogQueue);
+	}
+
+	bool BinaryLog::IsRunning()
+	{
+		return g_BinaryLogIsRunning.load(std::memory_order_relaxed);
+	}
+
+	bool BinaryLog::BeginRecord(BinaryLogCallSite& callSite, BinaryLogRecord& record)
+	{
+		const uint64 timestamp = PlatformTime::GetPerformanceCounter();
+
+		uint32 suppressed = 0;
+		if (callSite.MaxPerSecond > 0)
+		{
+			// Start a new window when a second has passed, only one thread succeeds with the exchange
+			uint64 windowStart = callSite.WindowStart.load(std::memory_order_relaxed);
+			if (timestamp - windowStart >= PlatformTime::GetPerformanceFrequency())
+			{
+				if (callSite.WindowStart.compare_exchange_strong(windowStart, timestamp, std::memory_order_relaxed))
+				{
+					callSite.WindowCount.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			if (callSite.WindowCount.fetch_add(1, std::memory_order_relaxed) >= callSite.MaxPerSecond)
+			{
+				callSite.Suppressed.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			suppressed = callSite.Suppressed.exchange(0, std::memory_order_relaxed);
+		}
+
+		if (t_BinaryLogThreadID == UINT32_MAX)
+		{
+			t_BinaryLogThreadID = g_BinaryLogThreadCount++;
+		}
+
+		record.pCallSite	= &callSite;
+		record.Timestamp	= timestamp;
+		record.ThreadID		= t_BinaryLogThreadID;
+		record.Suppressed	= suppressed;
+		record.ArgumentSize	= 0;
+		return true;
+	}
+
+	void BinaryLog::EndRecord(const BinaryLogRecord& record)
+	{
+		// Never block the caller, if the log thread can not keep up the entry is dropped and reported later
+		if (!g_pBinaryLogQueue->TryPush(record))
+		{
+			g_BinaryLogDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
@@ -1,20 +1,319 @@
 #include "Log/Log.h"
 
+#include "Containers/String.h"
+#include "Containers/TLockFreeQueue.h"
+
 #include "Threading/API/SpinLock.h"
 
+#include "Time/API/PlatformTime.h"
+
 #include "Application/API/PlatformConsole.h"
 #include "Application/API/PlatformMisc.h"
 
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <stdio.h>
 
 namespace LambdaEngine
 {
+	constexpr const uint32 LOG_QUEUE_SIZE		= 2048;
+	constexpr const uint32 LOG_MESSAGE_SIZE		= 1024;
+	constexpr const uint64 LOG_FILE_MAX_SIZE	= MEGA_BYTE(16);
+	constexpr const uint32 LOG_FILE_MAX_COUNT	= 4;
+
+	/*
+	* A message that has been formatted on the calling thread and waits to be written by the log thread
+	*/
+	struct LogRecord
+	{
+		uint64			Timestamp	= 0;
+		uint32			ThreadID	= 0;
+		ELogSeverity	Severity	= ELogSeverity::LOG_MESSAGE;
+		char			Message[LOG_MESSAGE_SIZE];
+	};
+
+	static TLockFreeQueue<LogRecord>*	g_pLogQueue				= nullptr;
+	static std::thread					g_LogThread;
+	static std::atomic_bool				g_LogIsRunning			= false;
+	static std::atomic_bool				g_LogThreadShouldStop	= false;
+	static std::atomic_uint32_t			g_LogProducers			= 0;
+	static std::mutex					g_LogMutex;
+	static std::condition_variable		g_LogCondition;
+	static std::atomic_uint64_t			g_LogPushedRecords		= 0;
+	static std::atomic_uint64_t			g_LogWrittenRecords		= 0;
+	static std::atomic_uint32_t			g_LogDroppedRecords		= 0;
+	static std::atomic_uint32_t			g_LogThreadCount		= 0;
+	static thread_local uint32			t_LogThreadID			= UINT32_MAX;
+	static FILE*						g_pLogFile				= nullptr;
+	static uint64						g_LogFileSize			= 0;
+	static uint64						g_LogStartCounter		= 0;
+	static String						g_LogFilepath;
+
+	static const char* GetSeverityString(ELogSeverity severity)
+	{
+		switch (severity)
+		{
+		case ELogSeverity::LOG_MESSAGE:	return "MESSAGE";
+		case ELogSeverity::LOG_INFO:	return "INFO";
+		case ELogSeverity::LOG_WARNING:	return "WARNING";
+		case ELogSeverity::LOG_ERROR:	return "ERROR";
+		default:						return "UNKNOWN";
+		}
+	}
+
+	static String GetRotatedFilepath(uint32 index)
+	{
+		if (index == 0)
+		{
+			return g_LogFilepath;
+		}
+
+		// LambdaEngine.log -> LambdaEngine.1.log
+		const size_t extensionPos = g_LogFilepath.find_last_of('.');
+		if (extensionPos == String::npos)
+		{
+			return g_LogFilepath + "." + std::to_string(index);
+		}
+
+		return g_LogFilepath.substr(0, extensionPos) + "." + std::to_string(index) + g_LogFilepath.substr(extensionPos);
+	}
+
+	static void RotateLogFile()
+	{
+		if (g_pLogFile)
+		{
+			fclose(g_pLogFile);
+			g_pLogFile = nullptr;
+		}
+
+		remove(GetRotatedFilepath(LOG_FILE_MAX_COUNT - 1).c_str());
+		for (uint32 i = LOG_FILE_MAX_COUNT - 1; i > 0; i--)
+		{
+			rename(GetRotatedFilepath(i - 1).c_str(), GetRotatedFilepath(i).c_str());
+		}
+
+		g_pLogFile		= fopen(g_LogFilepath.c_str(), "w");
+		g_LogFileSize	= 0;
+	}
+
+	static void WriteRecord(const LogRecord& record)
+	{
+		if (record.Severity == ELogSeverity::LOG_INFO)
+		{
+			PlatformConsole::SetColor(EConsoleColor::COLOR_GREEN);
+		}
+		else if (record.Severity == ELogSeverity::LOG_WARNING)
+		{
+			PlatformConsole::SetColor(EConsoleColor::COLOR_YELLOW);
+		}
+		else if (record.Severity == ELogSeverity::LOG_ERROR)
+		{
+			PlatformConsole::SetColor(EConsoleColor::COLOR_RED);
+		}
+
+		PlatformConsole::PrintLine("%s", record.Message);
+
+		if (record.Severity != ELogSeverity::LOG_MESSAGE)
+		{
+			PlatformConsole::SetColor(EConsoleColor::COLOR_WHITE);
+		}
+
+		if (Log::IsDebuggerOutputEnabled())
+		{
+			PlatformMisc::OutputDebugString(record.Message);
+		}
+
+		if (g_pLogFile)
+		{
+			const float64 seconds = float64(record.Timestamp - g_LogStartCounter) / float64(PlatformTime::GetPerformanceFrequency());
+			const int32 written = fprintf(g_pLogFile, "[%10.4f][Thread %u][%s] %s\n", seconds, record.ThreadID, GetSeverityString(record.Severity), record.Message);
+			if (written > 0)
+			{
+				g_LogFileSize += uint64(written);
+				if (g_LogFileSize >= LOG_FILE_MAX_SIZE)
+				{
+					RotateLogFile();
+				}
+			}
+		}
+	}
+
+	static void RunLogThread()
+	{
+		LogRecord record;
+		for (;;)
+		{
+			// Read the flag before draining so that everything pushed before Release gets written
+			const bool shouldStop = g_LogThreadShouldStop.load(std::memory_order_acquire);
+
+			while (g_pLogQueue->TryPop(record))
+			{
+				WriteRecord(record);
+				g_LogWrittenRecords.fetch_add(1, std::memory_order_release);
+			}
+
+			const uint32 droppedRecords = g_LogDroppedRecords.exchange(0);
+			if (droppedRecords > 0)
+			{
+				record.Timestamp	= PlatformTime::GetPerformanceCounter();
+				record.ThreadID		= t_LogThreadID;
+				record.Severity		= ELogSeverity::LOG_WARNING;
+				snprintf(record.Message, LOG_MESSAGE_SIZE, "[Log]: Queue was full, %u messages were dropped", droppedRecords);
+				WriteRecord(record);
+			}
+
+			if (g_pLogFile)
+			{
+				fflush(g_pLogFile);
+			}
+
+			if (shouldStop)
+			{
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock(g_LogMutex);
+			g_LogCondition.wait_for(lock, std::chrono::milliseconds(10));
+		}
+	}
+
+	/*
+	* Producers are counted before they check g_LogIsRunning, so that Release can wait for those that saw it set. A
+	* producer that sees it cleared writes synchronously instead, nothing is pushed to a queue that is being deleted
+	*/
+	static bool BeginPush()
+	{
+		g_LogProducers.fetch_add(1, std::memory_order_seq_cst);
+		if (g_LogIsRunning.load(std::memory_order_seq_cst))
+		{
+			return true;
+		}
+
+		g_LogProducers.fetch_sub(1, std::memory_order_release);
+		return false;
+	}
+
+	static void EndPush()
+	{
+		g_LogProducers.fetch_sub(1, std::memory_order_release);
+	}
+
+	static void PushRecord(ELogSeverity severity, const char* pPrefix, const char* pFormat, va_list args)
+	{
+		if (t_LogThreadID == UINT32_MAX)
+		{
+			t_LogThreadID = g_LogThreadCount++;
+		}
+
+		LogRecord record;
+		record.Timestamp	= PlatformTime::GetPerformanceCounter();
+		record.ThreadID		= t_LogThreadID;
+		record.Severity		= severity;
+
+		int32 prefixLength = 0;
+		if (pPrefix)
+		{
+			prefixLength = snprintf(record.Message, LOG_MESSAGE_SIZE, "%s", pPrefix);
+			prefixLength = prefixLength < int32(LOG_MESSAGE_SIZE) ? prefixLength : int32(LOG_MESSAGE_SIZE) - 1;
+		}
+
+		vsnprintf(record.Message + prefixLength, LOG_MESSAGE_SIZE - prefixLength, pFormat, args);
+
+		// Never block the caller, if the log thread can not keep up the message is dropped and reported later
+		if (g_pLogQueue->TryPush(record))
+		{
+			g_LogPushedRecords.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			g_LogDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (severity == ELogSeverity::LOG_ERROR)
+		{
+			g_LogCondition.notify_one();
+		}
+	}
+
 	bool Log::s_DebuggerOutputEnabled = false;
 
 	/*
 	* Log
 	*/
+	bool Log::Init(const char* pFilepath)
+	{
+		if (g_LogIsRunning)
+		{
+			return true;
+		}
+
+		g_pLogQueue			= DBG_NEW TLockFreeQueue<LogRecord>(LOG_QUEUE_SIZE);
+		g_LogStartCounter	= PlatformTime::GetPerformanceCounter();
+
+		if (pFilepath)
+		{
+			g_LogFilepath = pFilepath;
+			RotateLogFile();
+
+			if (!g_pLogFile)
+			{
+				LOG_WARNING("[Log]: Failed to open log file '%s', logging to console only", pFilepath);
+			}
+		}
+
+		g_LogThreadShouldStop	= false;
+		g_LogIsRunning			= true;
+		g_LogThread				= std::thread(RunLogThread);
+		return true;
+	}
+
+	void Log::Release()
+	{
+		if (!g_LogIsRunning)
+		{
+			return;
+		}
+
+		// New messages are written synchronously from here, the ones already being pushed are waited for
+		g_LogIsRunning.store(false, std::memory_order_seq_cst);
+		while (g_LogProducers.load(std::memory_order_seq_cst) > 0)
+		{
+			std::this_thread::yield();
+		}
+
+		g_LogThreadShouldStop.store(true, std::memory_order_release);
+		g_LogCondition.notify_one();
+
+		if (g_LogThread.joinable())
+		{
+			g_LogThread.join();
+		}
+
+		if (g_pLogFile)
+		{
+			fclose(g_pLogFile);
+			g_pLogFile = nullptr;
+		}
+
+		SAFEDELETE(g_pLogQueue);
+	}
+
+	void Log::Flush()
+	{
+		if (!g_LogIsRunning)
+		{
+			return;
+		}
+
+		const uint64 pushedRecords = g_LogPushedRecords.load(std::memory_order_relaxed);
+		while (g_LogWrittenRecords.load(std::memory_order_acquire) < pushedRecords)
+		{
+			g_LogCondition.notify_one();
+			std::this_thread::yield();
+		}
+	}
+
 	void Log::Print(ELogSeverity severity, const char* pFormat, ...)
 	{
 		va_list args;
@@ -27,6 +326,13 @@ namespace LambdaEngine
 
 	void Log::PrintV(ELogSeverity severity, const char* pFormat, va_list args)
 	{
+		if (BeginPush())
+		{
+			PushRecord(severity, nullptr, pFormat, args);
+			EndPush();
+			return;
+		}
+
 		if (severity == ELogSeverity::LOG_INFO)
 		{
 			PlatformConsole::SetColor(EConsoleColor::COLOR_GREEN);
@@ -76,6 +382,15 @@ namespace LambdaEngine
 
 	void Log::PrintTraceErrorV(const char* pFunction, const char* pFormat, va_list args)
 	{
+		if (BeginPush())
+		{
+			char prefix[256];
+			snprintf(prefix, sizeof(prefix), "CRITICAL ERROR IN '%s': ", pFunction);
+			PushRecord(ELogSeverity::LOG_ERROR, prefix, pFormat, args);
+			EndPush();
+			return;
+		}
+
 		PlatformConsole::SetColor(EConsoleColor::COLOR_RED);
 		PlatformConsole::Print("CRITICAL ERROR IN '%s': ", pFunction);
 		PlatformConsole::SetColor(EConsoleColor::COLOR_WHITE);
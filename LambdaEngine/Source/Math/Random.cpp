@@ -5,10 +5,22 @@
 namespace LambdaEngine
 {
 	std::default_random_engine Random::s_Generator((uint32)0);
+	uint32 Random::s_Seed = 0;
 
 	void Random::PreInit()
 	{
-		s_Generator = std::default_random_engine((uint32)PlatformTime::GetPerformanceCounter());
+		Seed((uint32)PlatformTime::GetPerformanceCounter());
+	}
+
+	void Random::Seed(uint32 seed)
+	{
+		s_Seed		= seed;
+		s_Generator	= std::default_random_engine(seed);
+	}
+
+	uint32 Random::GetSeed()
+	{
+		return s_Seed;
 	}
 
 	int32 Random::Int32(int32 min, int32 max)
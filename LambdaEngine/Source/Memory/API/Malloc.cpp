@@ -5,6 +5,7 @@
 
 #include "Math/Math.h"
 
+#include <atomic>
 #include <stdlib.h>
 
 #ifdef LAMBDA_VISUAL_STUDIO
@@ -41,17 +42,23 @@ namespace LambdaEngine
 {
 	uint16 Malloc::s_DebugFlags = 0;
 
+	static std::atomic<uint64> g_AllocationCount	= 0;
+	static std::atomic<uint64> g_FreeCount			= 0;
+
 	void* Malloc::Allocate(uint64 sizeInBytes)
 	{
 #if MEM_DEBUG_ENABLED
 		return Allocate(sizeInBytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
 #else
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
 		return malloc(sizeInBytes);
 #endif
 	}
 
 	void* Malloc::Allocate(uint64 sizeInBytes, uint64 alignment)
 	{
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
 #if MEM_DEBUG_ENABLED
 		if (sizeInBytes == 0)
 		{
@@ -105,12 +112,15 @@ namespace LambdaEngine
 #if MEM_DEBUG_ENABLED
 		return AllocateDbg(sizeInBytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__, pFileName, lineNumber);
 #else
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
 		return debug_malloc(sizeInBytes, pFileName, lineNumber);
 #endif
 	}
 
 	void* Malloc::AllocateDbg(uint64 sizeInBytes, uint64 alignment, const char* pFileName, int32 lineNumber)
 	{
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
 #if MEM_DEBUG_ENABLED
 		if (sizeInBytes == 0)
 		{
@@ -153,6 +163,11 @@ namespace LambdaEngine
 
 	void Malloc::Free(void* pPtr)
 	{
+		if (pPtr != nullptr)
+		{
+			g_FreeCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
 #if MEM_DEBUG_ENABLED
 		// It appears that it is legal that free recives a nullptr so we support is aswell
 		if (pPtr == nullptr)
@@ -189,6 +204,16 @@ namespace LambdaEngine
 
 		s_DebugFlags = debugFlags;
 	}
+
+	uint64 Malloc::GetAllocationCount()
+	{
+		return g_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+	uint64 Malloc::GetFreeCount()
+	{
+		return g_FreeCount.load(std::memory_order_relaxed);
+	}
 	
 	void* Malloc::AllocateProtected(uint64 sizeInBytes)
 	{
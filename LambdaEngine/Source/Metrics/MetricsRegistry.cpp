@@ -0,0 +1,400 @@
+#include "Metrics/MetricsRegistry.h"
+
+#include "Log/Log.h"
+
+#include "Time/API/PlatformTime.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include <mutex>
+#include <stdio.h>
+
+#ifdef LAMBDA_PLATFORM_WINDOWS
+	#include "Application/Win32/Windows.h"
+#endif
+
+namespace LambdaEngine
+{
+	static SpinLock				g_MetricsLock;
+	static std::mutex			g_MetricsExportLock;
+	static TArray<Metric*>		g_Metrics;
+	static TArray<MetricSample>	g_MetricsSnapshot;
+	static String				g_MetricsPrometheusPath;
+	static String				g_MetricsCSVPath;
+	static Timestamp			g_MetricsSnapshotInterval	= Timestamp::Seconds(1.0);
+	static uint64				g_MetricsLastSnapshot		= 0;
+	static uint64				g_MetricsFirstSnapshot		= 0;
+
+	static Metric* FindMetric(const String& name)
+	{
+		for (Metric* pMetric : g_Metrics)
+		{
+			if (pMetric->GetName() == name)
+			{
+				return pMetric;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template<typename TMetric>
+	static TMetric* FindMetricOfType(const String& name, EMetricType type)
+	{
+		Metric* pMetric = FindMetric(name);
+		if (pMetric && pMetric->GetType() != type)
+		{
+			LOG_ERROR("[MetricsRegistry]: Metric '%s' is already registered with another type", name.c_str());
+		}
+
+		return pMetric && pMetric->GetType() == type ? static_cast<TMetric*>(pMetric) : nullptr;
+	}
+
+	/*
+	* Replaces the file at path with the file at tempPath in a single step. On Windows rename fails if the target
+	* exists, removing it first would leave a moment without a file, so MoveFileEx is used instead
+	*/
+	static bool ReplaceExportFile(const String& tempPath, const String& path)
+	{
+#ifdef LAMBDA_PLATFORM_WINDOWS
+		return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+	}
+
+	static void WritePrometheusFile(const TArray<MetricSample>& snapshot, const String& path)
+	{
+		// Write to a temporary file and rename it so that a scraper never sees a partially written file
+		const String tempPath = path + ".tmp";
+		FILE* pFile = fopen(tempPath.c_str(), "w");
+		if (!pFile)
+		{
+			LOG_ERROR("[MetricsRegistry]: Failed to open '%s'", tempPath.c_str());
+			return;
+		}
+
+		for (const MetricSample& sample : snapshot)
+		{
+			const Metric*	pMetric	= sample.pMetric;
+			const char*		pName	= pMetric->GetName().c_str();
+			fprintf(pFile, "# HELP %s %s\n", pName, pMetric->GetHelp().c_str());
+
+			if (pMetric->GetType() == EMetricType::METRIC_TYPE_COUNTER)
+			{
+				fprintf(pFile, "# TYPE %s counter\n%s %llu\n", pName, pName, (unsigned long long)sample.Value);
+			}
+			else if (pMetric->GetType() == EMetricType::METRIC_TYPE_GAUGE)
+			{
+				fprintf(pFile, "# TYPE %s gauge\n%s %.6f\n", pName, pName, sample.Value);
+			}
+			else if (pMetric->GetType() == EMetricType::METRIC_TYPE_HISTOGRAM)
+			{
+				const TArray<float64>& upperBounds = static_cast<const MetricHistogram*>(pMetric)->GetUpperBounds();
+				fprintf(pFile, "# TYPE %s histogram\n", pName);
+
+				// Prometheus buckets are cumulative
+				uint64 cumulativeCount = 0;
+				for (uint32 i = 0; i < upperBounds.GetSize(); i++)
+				{
+					cumulativeCount += sample.BucketCounts[i];
+					fprintf(pFile, "%s_bucket{le=\"%g\"} %llu\n", pName, upperBounds[i], (unsigned long long)cumulativeCount);
+				}
+
+				fprintf(pFile, "%s_bucket{le=\"+Inf\"} %llu\n", pName, (unsigned long long)sample.Value);
+				fprintf(pFile, "%s_sum %.6f\n", pName, sample.Sum);
+				fprintf(pFile, "%s_count %llu\n", pName, (unsigned long long)sample.Value);
+			}
+		}
+
+		fclose(pFile);
+
+		if (!ReplaceExportFile(tempPath, path))
+		{
+			LOG_ERROR("[MetricsRegistry]: Failed to replace '%s'", path.c_str());
+		}
+	}
+
+	static void AppendCSVFile(const TArray<MetricSample>& snapshot, float64 time, const String& path)
+	{
+		FILE* pFile = fopen(path.c_str(), "a");
+		if (!pFile)
+		{
+			LOG_ERROR("[MetricsRegistry]: Failed to open '%s'", path.c_str());
+			return;
+		}
+
+		fseek(pFile, 0, SEEK_END);
+		if (ftell(pFile) == 0)
+		{
+			fputs("Time,Name,Value,Rate\n", pFile);
+		}
+
+		for (const MetricSample& sample : snapshot)
+		{
+			const char* pName = sample.pMetric->GetName().c_str();
+			if (sample.pMetric->GetType() == EMetricType::METRIC_TYPE_HISTOGRAM)
+			{
+				// Write the mean of the observations since the snapshot started, that is what is usually plotted
+				const float64 mean = sample.Value > 0.0 ? sample.Sum / sample.Value : 0.0;
+				fprintf(pFile, "%.3f,%s_count,%.6f,%.6f\n", time, pName, sample.Value, sample.Rate);
+				fprintf(pFile, "%.3f,%s_mean,%.6f,0\n", time, pName, mean);
+			}
+			else
+			{
+				fprintf(pFile, "%.3f,%s,%.6f,%.6f\n", time, pName, sample.Value, sample.Rate);
+			}
+		}
+
+		fclose(pFile);
+	}
+
+	/*
+	* MetricHistogram
+	*/
+	MetricHistogram::MetricHistogram(const String& name, const String& help, const TArray<float64>& upperBounds)
+		: Metric(name, help, EMetricType::METRIC_TYPE_HISTOGRAM),
+		m_UpperBounds(upperBounds),
+		m_pBucketCounts(nullptr),
+		m_Count(0),
+		m_Sum(0.0)
+	{
+		m_pBucketCounts = DBG_NEW std::atomic<uint64>[m_UpperBounds.GetSize() + 1];
+		for (uint32 i = 0; i <= m_UpperBounds.GetSize(); i++)
+		{
+			m_pBucketCounts[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	MetricHistogram::~MetricHistogram()
+	{
+		SAFEDELETE_ARRAY(m_pBucketCounts);
+	}
+
+	void MetricHistogram::Observe(float64 value)
+	{
+		// The number of buckets is small so a linear search is faster than a binary search
+		uint32 bucket = 0;
+		while (bucket < m_UpperBounds.GetSize() && value > m_UpperBounds[bucket])
+		{
+			bucket++;
+		}
+
+		m_pBucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		float64 sum = m_Sum.load(std::memory_order_relaxed);
+		while (!m_Sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed));
+	}
+
+	uint64 MetricHistogram::GetValues(TArray<uint64>& bucketCounts, float64& sum) const
+	{
+		bucketCounts.Resize(m_UpperBounds.GetSize() + 1);
+		for (uint32 i = 0; i <= m_UpperBounds.GetSize(); i++)
+		{
+			bucketCounts[i] = m_pBucketCounts[i].load(std::memory_order_relaxed);
+		}
+
+		sum = m_Sum.load(std::memory_order_relaxed);
+		return m_Count.load(std::memory_order_relaxed);
+	}
+
+	/*
+	* MetricsRegistry
+	*/
+	MetricCounter* MetricsRegistry::RegisterCounter(const String& name, const String& help)
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		if (FindMetric(name))
+		{
+			return FindMetricOfType<MetricCounter>(name, EMetricType::METRIC_TYPE_COUNTER);
+		}
+
+		MetricCounter* pCounter = DBG_NEW MetricCounter(name, help);
+		g_Metrics.PushBack(pCounter);
+		return pCounter;
+	}
+
+	MetricGauge* MetricsRegistry::RegisterGauge(const String& name, const String& help)
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		if (FindMetric(name))
+		{
+			return FindMetricOfType<MetricGauge>(name, EMetricType::METRIC_TYPE_GAUGE);
+		}
+
+		MetricGauge* pGauge = DBG_NEW MetricGauge(name, help);
+		g_Metrics.PushBack(pGauge);
+		return pGauge;
+	}
+
+	MetricHistogram* MetricsRegistry::RegisterHistogram(const String& name, const String& help, const TArray<float64>& upperBounds)
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		if (FindMetric(name))
+		{
+			return FindMetricOfType<MetricHistogram>(name, EMetricType::METRIC_TYPE_HISTOGRAM);
+		}
+
+		MetricHistogram* pHistogram = DBG_NEW MetricHistogram(name, help, upperBounds);
+		g_Metrics.PushBack(pHistogram);
+		return pHistogram;
+	}
+
+	MetricCounter* MetricsRegistry::RegisterSampledCounter(const String& name, const String& help, const std::function<uint64()>& sampler)
+	{
+		MetricCounter* pCounter = RegisterCounter(name, help);
+		if (pCounter)
+		{
+			std::scoped_lock<SpinLock> lock(g_MetricsLock);
+			pCounter->m_Sampler = sampler;
+		}
+
+		return pCounter;
+	}
+
+	MetricGauge* MetricsRegistry::RegisterSampledGauge(const String& name, const String& help, const std::function<float64()>& sampler)
+	{
+		MetricGauge* pGauge = RegisterGauge(name, help);
+		if (pGauge)
+		{
+			std::scoped_lock<SpinLock> lock(g_MetricsLock);
+			pGauge->m_Sampler = sampler;
+		}
+
+		return pGauge;
+	}
+
+	void MetricsRegistry::SetPrometheusExportPath(const String& filepath)
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		g_MetricsPrometheusPath = filepath;
+	}
+
+	void MetricsRegistry::SetCSVExportPath(const String& filepath)
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		g_MetricsCSVPath = filepath;
+	}
+
+	void MetricsRegistry::SetSnapshotInterval(Timestamp interval)
+	{
+		g_MetricsSnapshotInterval = interval;
+	}
+
+	void MetricsRegistry::Tick()
+	{
+		const uint64 now		= PlatformTime::GetPerformanceCounter();
+		const uint64 interval	= uint64(g_MetricsSnapshotInterval.AsSeconds() * float64(PlatformTime::GetPerformanceFrequency()));
+		if (now - g_MetricsLastSnapshot >= interval)
+		{
+			TakeSnapshot();
+		}
+	}
+
+	void MetricsRegistry::TakeSnapshot()
+	{
+		const uint64 now = PlatformTime::GetPerformanceCounter();
+		if (g_MetricsFirstSnapshot == 0)
+		{
+			g_MetricsFirstSnapshot = now;
+		}
+
+		const float64 frequency		= float64(PlatformTime::GetPerformanceFrequency());
+		const float64 elapsed		= g_MetricsLastSnapshot != 0 ? float64(now - g_MetricsLastSnapshot) / frequency : 0.0;
+		const float64 time			= float64(now - g_MetricsFirstSnapshot) / frequency;
+		g_MetricsLastSnapshot = now;
+
+		// Samples and paths are copied under the registry lock, the files are written after it has been released
+		TArray<MetricSample> snapshot;
+		String prometheusPath;
+		String csvPath;
+
+		std::unique_lock<SpinLock> lock(g_MetricsLock);
+		snapshot.Reserve(g_Metrics.GetSize());
+
+		for (Metric* pMetric : g_Metrics)
+		{
+			MetricSample sample;
+			sample.pMetric = pMetric;
+
+			if (pMetric->GetType() == EMetricType::METRIC_TYPE_COUNTER)
+			{
+				MetricCounter* pCounter = static_cast<MetricCounter*>(pMetric);
+				if (pCounter->m_Sampler)
+				{
+					pCounter->m_Value.store(pCounter->m_Sampler(), std::memory_order_relaxed);
+				}
+
+				sample.Value = float64(pCounter->GetValue());
+			}
+			else if (pMetric->GetType() == EMetricType::METRIC_TYPE_GAUGE)
+			{
+				MetricGauge* pGauge = static_cast<MetricGauge*>(pMetric);
+				if (pGauge->m_Sampler)
+				{
+					pGauge->Set(pGauge->m_Sampler());
+				}
+
+				sample.Value = pGauge->GetValue();
+			}
+			else if (pMetric->GetType() == EMetricType::METRIC_TYPE_HISTOGRAM)
+			{
+				MetricHistogram* pHistogram = static_cast<MetricHistogram*>(pMetric);
+				sample.Value = float64(pHistogram->GetValues(sample.BucketCounts, sample.Sum));
+			}
+
+			// Rates are calculated against the previous snapshot of the same metric
+			if (elapsed > 0.0 && pMetric->GetType() != EMetricType::METRIC_TYPE_GAUGE)
+			{
+				for (const MetricSample& previousSample : g_MetricsSnapshot)
+				{
+					if (previousSample.pMetric == pMetric)
+					{
+						sample.Rate = (sample.Value - previousSample.Value) / elapsed;
+						break;
+					}
+				}
+			}
+
+			snapshot.PushBack(sample);
+		}
+
+		g_MetricsSnapshot	= snapshot;
+		prometheusPath		= g_MetricsPrometheusPath;
+		csvPath				= g_MetricsCSVPath;
+		lock.unlock();
+
+		// Snapshots taken from two threads would otherwise write the same temporary file
+		std::scoped_lock<std::mutex> exportLock(g_MetricsExportLock);
+
+		if (!prometheusPath.empty())
+		{
+			WritePrometheusFile(snapshot, prometheusPath);
+		}
+
+		if (!csvPath.empty())
+		{
+			AppendCSVFile(snapshot, time, csvPath);
+		}
+	}
+
+	TArray<MetricSample> MetricsRegistry::GetSnapshot()
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		return g_MetricsSnapshot;
+	}
+
+	void MetricsRegistry::Release()
+	{
+		std::scoped_lock<SpinLock> lock(g_MetricsLock);
+		g_MetricsSnapshot.Clear();
+
+		for (Metric* pMetric : g_Metrics)
+		{
+			SAFEDELETE(pMetric);
+		}
+
+		g_Metrics.Clear();
+	}
+}
@@ -1,6 +1,7 @@
 #include "Networking/API/ClientUDP.h"
 #include "Networking/API/IPAddress.h"
 #include "Networking/API/ISocketUDP.h"
+#include "Networking/API/LoopbackSocketUDP.h"
 #include "Networking/API/PlatformNetworkUtils.h"
 #include "Networking/API/IClientUDPHandler.h"
 #include "Networking/API/BinaryEncoder.h"
@@ -13,14 +14,24 @@
 
 namespace LambdaEngine
 {
+	static const Timestamp CONNECT_REQUEST_INTERVAL = Timestamp::MilliSeconds(250);
+	constexpr const uint32 MAX_CONNECT_REQUESTS = 20;
+	constexpr const uint32 MAX_DATAGRAMS_PER_POLL = 64;
+
 	std::set<ClientUDP*> ClientUDP::s_Clients;
 	SpinLock ClientUDP::s_Lock;
+	const ClientUDP::PacketHandlerTable ClientUDP::s_PacketHandlers = ClientUDP::CreatePacketHandlers();
 
 	ClientUDP::ClientUDP(IClientUDPHandler* pHandler, uint16 packetPoolSize, uint8 maximumTries) :
 		m_pSocket(nullptr),
 		m_PacketManager(packetPoolSize, maximumTries),
+		m_FragmentManager(&m_PacketManager, this),
 		m_pHandler(pHandler), 
 		m_State(STATE_DISCONNECTED),
+		m_ChallengeAnswered(false),
+		m_ConnectRequestsSent(0),
+		m_UseLoopback(false),
+		m_IsPolled(false),
 		m_pSendBuffer()
 	{
 		std::scoped_lock<SpinLock> lock(s_Lock);
@@ -52,6 +63,20 @@ namespace LambdaEngine
 
 	bool ClientUDP::Connect(const IPEndPoint& ipEndPoint)
 	{
+		// A polled client sends the connect request from StartPolling, so the end point is set first
+		if (m_IsPolled)
+		{
+			if (IsPolling())
+				return false;
+
+			m_PacketManager.SetEndPoint(ipEndPoint);
+			if (!StartPolling())
+				return false;
+
+			LOG_WARNING("[ClientUDP]: Connecting...");
+			return true;
+		}
+
 		if (!ThreadsAreRunning())
 		{
 			if (StartThreads())
@@ -74,6 +99,50 @@ namespace LambdaEngine
 		m_Transciver.SetSimulateTransmittingPacketLoss(lossRatio);
 	}
 
+	void ClientUDP::SetSimulatedConditions(const NetworkConditions& conditions)
+	{
+		m_Transciver.SetSimulatedConditions(conditions);
+	}
+
+	void ClientUDP::SetUseLoopback(bool useLoopback)
+	{
+		m_UseLoopback = useLoopback;
+	}
+
+	void ClientUDP::SetPolled(bool isPolled)
+	{
+		m_IsPolled = isPolled;
+	}
+
+	bool ClientUDP::Poll()
+	{
+		if (!IsPolling())
+			return false;
+
+		if (ShouldTerminate())
+		{
+			StopPolling();
+			return false;
+		}
+
+		IPEndPoint sender;
+		uint32 datagramsReceived = 0;
+		while (datagramsReceived < MAX_DATAGRAMS_PER_POLL && m_Transciver.ReceiveBegin(sender))
+		{
+			HandleReceivedDatagram();
+			datagramsReceived++;
+		}
+
+		TransmitPackets();
+		m_Transciver.FlushSimulatedDatagrams();
+		return datagramsReceived > 0;
+	}
+
+	void ClientUDP::SetCompressionMode(ECompressionMode mode)
+	{
+		m_PacketManager.SetCompressionMode(mode);
+	}
+
 	void ClientUDP::Disconnect()
 	{
 		TerminateThreads();
@@ -117,6 +186,28 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool ClientUDP::SendLarge(uint16 packetType, const char* pData, uint32 size)
+	{
+		if (!IsConnected())
+		{
+			LOG_WARNING("[ClientUDP]: Can not send packet before a connection has been established");
+			return false;
+		}
+
+		return m_FragmentManager.Send(packetType, pData, size);
+	}
+
+	void ClientUDP::SetChannelType(uint8 channel, EChannelType type)
+	{
+		if (channel >= FragmentManager::FRAGMENT_CHANNEL)
+		{
+			LOG_WARNING("[ClientUDP]: Channel %u is reserved or out of range", uint32(channel));
+			return;
+		}
+
+		m_PacketManager.SetChannelType(channel, type);
+	}
+
 	const IPEndPoint& ClientUDP::GetEndPoint() const
 	{
 		return m_PacketManager.GetEndPoint();
@@ -144,16 +235,23 @@ namespace LambdaEngine
 
 	bool ClientUDP::OnThreadsStarted()
 	{
-		m_pSocket = PlatformNetworkUtils::CreateSocketUDP();
+		m_pSocket = m_UseLoopback ? DBG_NEW LoopbackSocketUDP() : PlatformNetworkUtils::CreateSocketUDP();
 		if (m_pSocket)
 		{
 			if (m_pSocket->Bind(IPEndPoint(IPAddress::ANY, 0)))
 			{
+				if (m_IsPolled)
+					m_pSocket->EnableBlocking(false);
+
 				m_Transciver.SetSocket(m_pSocket);
 				m_PacketManager.Reset();
+				m_FragmentManager.Reset();
+				m_ClockSynchronizer.Reset();
 				m_State = STATE_CONNECTING;
 				m_pHandler->OnConnectingUDP(this);
 				m_SendDisconnectPacket = true;
+				m_ChallengeAnswered = false;
+				m_ConnectRequestsSent = 0;
 				SendConnectRequest();
 				return true;
 			}
@@ -172,13 +270,7 @@ namespace LambdaEngine
 			if (!m_Transciver.ReceiveBegin(sender))
 				continue;
 
-			TArray<NetworkPacket*> packets;
-			m_PacketManager.QueryBegin(&m_Transciver, packets);
-			for (NetworkPacket* pPacket : packets)
-			{
-				HandleReceivedPacket(pPacket);
-			}
-			m_PacketManager.QueryEnd(packets);
+			HandleReceivedDatagram();
 		}
 	}
 
@@ -187,7 +279,7 @@ namespace LambdaEngine
 		while (!ShouldTerminate())
 		{
 			TransmitPackets();
-			YieldTransmitter();
+			YieldTransmitter(m_Transciver.FlushSimulatedDatagrams());
 		}
 	}
 
@@ -200,7 +292,14 @@ namespace LambdaEngine
 		LOG_INFO("[ClientUDP]: Disconnected");
 		m_State = STATE_DISCONNECTED;
 		if(m_pHandler)
+		{
+			TArray<uint16> failedMessages;
+			m_FragmentManager.TakeUndeliveredMessages(failedMessages);
+			for (uint16 packetType : failedMessages)
+				m_pHandler->OnLargePacketFailedUDP(this, packetType);
+
 			m_pHandler->OnDisconnectedUDP(this);
+		}
 	}
 
 	void ClientUDP::OnTerminationRequested()
@@ -219,9 +318,15 @@ namespace LambdaEngine
 		m_pHandler = nullptr;
 	}
 
+	/*
+	* The server keeps no state until the challenge is answered and can not ack the request, so it is sent unreliable
+	* and repeated from Tick until a challenge arrives
+	*/
 	void ClientUDP::SendConnectRequest()
 	{
-		m_PacketManager.EnqueuePacketReliable(GetFreePacket(NetworkPacket::TYPE_CONNNECT), this);
+		m_TimeSinceConnectRequest = 0;
+		m_ConnectRequestsSent++;
+		m_PacketManager.EnqueuePacketUnreliable(GetFreePacket(NetworkPacket::TYPE_CONNNECT));
 		TransmitPackets();
 	}
 
@@ -231,47 +336,101 @@ namespace LambdaEngine
 		TransmitPackets();
 	}
 
-	void ClientUDP::HandleReceivedPacket(NetworkPacket* pPacket)
+	/*
+	* The ping is sent by the Flush right after this in Tick
+	*/
+	void ClientUDP::SendPing()
 	{
-		LOG_MESSAGE("PING %fms", GetStatistics()->GetPing().AsMilliSeconds());
-		uint16 packetType = pPacket->GetType();
-
-		if (packetType == NetworkPacket::TYPE_CHALLENGE)
-		{
-			uint64 answer = NetworkChallenge::Compute(GetStatistics()->GetSalt(), pPacket->GetRemoteSalt());
-			ASSERT(answer != 0);
+		NetworkPacket* pPing = GetFreePacket(NetworkPacket::TYPE_PING);
+		ClockSynchronizer::WritePing(pPing);
+		m_PacketManager.EnqueuePacketUnreliable(pPing);
+	}
 
-			NetworkPacket* pResponse = GetFreePacket(NetworkPacket::TYPE_CHALLENGE);
-			BinaryEncoder encoder(pResponse);
-			encoder.WriteUInt64(answer);
-			m_PacketManager.EnqueuePacketReliable(pResponse, this);
-		}
-		else if (packetType == NetworkPacket::TYPE_ACCEPTED)
-		{
-			if (m_State == STATE_CONNECTING)
-			{
-				LOG_INFO("[ClientUDP]: Connected");
-				m_State = STATE_CONNECTED;
-				m_pHandler->OnConnectedUDP(this);
-			}
-		}
-		else if (packetType == NetworkPacket::TYPE_DISCONNECT)
-		{
-			m_SendDisconnectPacket = false;
-			Disconnect();
-		}
-		else if (packetType == NetworkPacket::TYPE_SERVER_FULL)
+	void ClientUDP::HandleReceivedDatagram()
+	{
+		TArray<NetworkPacket*> packets;
+		m_PacketManager.QueryBegin(&m_Transciver, packets);
+		for (NetworkPacket* pPacket : packets)
 		{
-			m_SendDisconnectPacket = false;
-			m_pHandler->OnServerFullUDP(this);
-			Disconnect();
+			HandleReceivedPacket(pPacket);
 		}
+		m_PacketManager.QueryEnd(packets);
+	}
+
+	/*
+	* Engine packets are handled through a table indexed by UINT16_MAX - type, everything else goes to the handler
+	*/
+	void ClientUDP::HandleReceivedPacket(NetworkPacket* pPacket)
+	{
+		const uint16 internalIndex = UINT16_MAX - pPacket->GetType();
+		if (internalIndex < NetworkPacket::INTERNAL_TYPE_COUNT)
+			(this->*s_PacketHandlers[internalIndex])(pPacket);
 		else
+			HandleApplicationPacket(pPacket);
+	}
+
+	void ClientUDP::HandleChallenge(NetworkPacket* pPacket)
+	{
+		// Every repeated connect request is answered, the first answer is resent until it is acked
+		if (m_ChallengeAnswered.exchange(true))
+			return;
+
+		uint64 answer = NetworkChallenge::Compute(GetStatistics()->GetSalt(), pPacket->GetRemoteSalt());
+		ASSERT(answer != 0);
+
+		NetworkPacket* pResponse = GetFreePacket(NetworkPacket::TYPE_CHALLENGE);
+		BinaryEncoder encoder(pResponse);
+		encoder.WriteUInt64(answer);
+		m_PacketManager.EnqueuePacketReliable(pResponse, this);
+	}
+
+	void ClientUDP::HandlePing(NetworkPacket* pPacket)
+	{
+		m_ClockSynchronizer.OnPongReceived(pPacket);
+	}
+
+	void ClientUDP::HandleAccepted(NetworkPacket* pPacket)
+	{
+		UNREFERENCED_VARIABLE(pPacket);
+
+		if (m_State == STATE_CONNECTING)
 		{
-			m_pHandler->OnPacketReceivedUDP(this, pPacket);
+			LOG_INFO("[ClientUDP]: Connected");
+			m_State = STATE_CONNECTED;
+			m_pHandler->OnConnectedUDP(this);
 		}
 	}
 
+	void ClientUDP::HandleDisconnect(NetworkPacket* pPacket)
+	{
+		UNREFERENCED_VARIABLE(pPacket);
+
+		m_SendDisconnectPacket = false;
+		Disconnect();
+	}
+
+	void ClientUDP::HandleServerFull(NetworkPacket* pPacket)
+	{
+		UNREFERENCED_VARIABLE(pPacket);
+
+		m_SendDisconnectPacket = false;
+		m_pHandler->OnServerFullUDP(this);
+		Disconnect();
+	}
+
+	void ClientUDP::HandleFragment(NetworkPacket* pPacket)
+	{
+		uint16 messageType;
+		TArray<char> message;
+		if (m_FragmentManager.OnFragmentReceived(pPacket, messageType, message))
+			m_pHandler->OnLargePacketReceivedUDP(this, messageType, message.GetData(), message.GetSize());
+	}
+
+	void ClientUDP::HandleApplicationPacket(NetworkPacket* pPacket)
+	{
+		m_pHandler->OnPacketReceivedUDP(this, pPacket);
+	}
+
 	void ClientUDP::TransmitPackets()
 	{
 		std::scoped_lock<SpinLock> lock(m_Lock);
@@ -283,11 +442,39 @@ namespace LambdaEngine
 		if (m_State != STATE_DISCONNECTED)
 		{
 			m_PacketManager.Tick(delta);
+			m_FragmentManager.Tick();
+		}
+
+		if (m_State == STATE_CONNECTING && !m_ChallengeAnswered)
+		{
+			m_TimeSinceConnectRequest += delta;
+			if (m_TimeSinceConnectRequest >= CONNECT_REQUEST_INTERVAL)
+			{
+				if (m_ConnectRequestsSent < MAX_CONNECT_REQUESTS)
+				{
+					SendConnectRequest();
+				}
+				else
+				{
+					LOG_WARNING("[ClientUDP]: No challenge received after %u connect requests", m_ConnectRequestsSent);
+					Disconnect();
+				}
+			}
+		}
+
+		if (m_State == STATE_CONNECTED && m_ClockSynchronizer.Tick(delta))
+		{
+			SendPing();
 		}
 		
 		Flush();
 	}
 
+	const ClockSynchronizer* ClientUDP::GetClockSynchronizer() const
+	{
+		return &m_ClockSynchronizer;
+	}
+
 	ClientUDP* ClientUDP::Create(IClientUDPHandler* pHandler, uint16 packetPoolSize, uint8 maximumTries)
 	{
 		return DBG_NEW ClientUDP(pHandler, packetPoolSize, maximumTries);
@@ -306,4 +493,17 @@ namespace LambdaEngine
 			}
 		}
 	}
+
+	ClientUDP::PacketHandlerTable ClientUDP::CreatePacketHandlers()
+	{
+		PacketHandlerTable packetHandlers;
+		packetHandlers.fill(&ClientUDP::HandleApplicationPacket);
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_PING]			= &ClientUDP::HandlePing;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_CHALLENGE]		= &ClientUDP::HandleChallenge;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_ACCEPTED]		= &ClientUDP::HandleAccepted;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_DISCONNECT]		= &ClientUDP::HandleDisconnect;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_SERVER_FULL]	= &ClientUDP::HandleServerFull;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_FRAGMENT]		= &ClientUDP::HandleFragment;
+		return packetHandlers;
+	}
 }
\ No newline at end of file
@@ -7,20 +7,27 @@
 #include "Networking/API/BinaryDecoder.h"
 #include "Networking/API/PacketTransceiver.h"
 #include "Networking/API/NetworkChallenge.h"
+#include "Networking/API/ClockSynchronizer.h"
+
+#include "Engine/EngineLoop.h"
 
 #include "Log/Log.h"
 
 namespace LambdaEngine
 {
-	ClientUDPRemote::ClientUDPRemote(uint16 packetPoolSize, uint8 maximumTries, const IPEndPoint& ipEndPoint, ServerUDP* pServer) :
+	const ClientUDPRemote::PacketHandlerTable ClientUDPRemote::s_PacketHandlers = ClientUDPRemote::CreatePacketHandlers();
+
+	ClientUDPRemote::ClientUDPRemote(PacketArena* pPacketArena, uint16 packetQuota, uint8 maximumTries, const IPEndPoint& ipEndPoint, uint64 salt, ServerUDP* pServer) :
 		m_pServer(pServer),
-		m_PacketManager(packetPoolSize, maximumTries),
+		m_PacketManager(pPacketArena, packetQuota, maximumTries),
+		m_FragmentManager(&m_PacketManager, this),
 		m_pHandler(nullptr),
 		m_State(STATE_CONNECTING),
 		m_Release(false),
 		m_DisconnectedByRemote(false)
 	{
 		m_PacketManager.SetEndPoint(ipEndPoint);
+		m_PacketManager.SetSalt(salt);
 	}
 
 	ClientUDPRemote::~ClientUDPRemote()
@@ -69,59 +76,109 @@ namespace LambdaEngine
 		m_PacketManager.Flush(pTransciver);
 	}
 
+	/*
+	* Engine packets are handled through a table indexed by UINT16_MAX - type, everything else goes to the handler
+	*	return - False if the client was disconnected and the remaining packets should not be handled
+	*/
 	bool ClientUDPRemote::HandleReceivedPacket(NetworkPacket* pPacket)
 	{
 		LOG_MESSAGE("PING %fms", GetStatistics()->GetPing().AsMilliSeconds());
-		uint16 packetType = pPacket->GetType();
-
 		LOG_MESSAGE("ClientUDPRemote::OnPacketReceivedUDP(%s)", pPacket->ToString().c_str());
 
-		if (packetType == NetworkPacket::TYPE_CONNNECT)
+		const uint16 internalIndex = UINT16_MAX - pPacket->GetType();
+		if (internalIndex < NetworkPacket::INTERNAL_TYPE_COUNT)
+			return (this->*s_PacketHandlers[internalIndex])(pPacket);
+
+		return HandleApplicationPacket(pPacket);
+	}
+
+	bool ClientUDPRemote::HandleConnect(NetworkPacket* pPacket)
+	{
+		UNREFERENCED_VARIABLE(pPacket);
+
+		// A late connect request, the client already has the cookie since it is the salt of this connection
+		m_PacketManager.EnqueuePacketUnreliable(GetFreePacket(NetworkPacket::TYPE_CHALLENGE));
+		return true;
+	}
+
+	bool ClientUDPRemote::HandleChallenge(NetworkPacket* pPacket)
+	{
+		uint64 expectedAnswer = NetworkChallenge::Compute(pPacket->GetRemoteSalt(), GetStatistics()->GetSalt());
+		BinaryDecoder decoder(pPacket);
+		uint64 answer = decoder.ReadUInt64();
+		if (answer == expectedAnswer)
 		{
-			m_PacketManager.EnqueuePacketUnreliable(GetFreePacket(NetworkPacket::TYPE_CHALLENGE));
+			m_PacketManager.EnqueuePacketUnreliable(GetFreePacket(NetworkPacket::TYPE_ACCEPTED));
 
-			if (!m_pHandler)
+			if (m_State == STATE_CONNECTING)
 			{
-				m_pHandler = m_pServer->CreateClientUDPHandler();
-				m_pHandler->OnConnectingUDP(this);
+				if (!m_pHandler)
+				{
+					m_pHandler = m_pServer->CreateClientUDPHandler();
+					m_pHandler->OnConnectingUDP(this);
+				}
+
+				m_State = STATE_CONNECTED;
+				m_pHandler->OnConnectedUDP(this);
 			}
 		}
-		else if (packetType == NetworkPacket::TYPE_CHALLENGE)
+		else
 		{
-			uint64 expectedAnswer = NetworkChallenge::Compute(GetStatistics()->GetSalt(), pPacket->GetRemoteSalt());
-			BinaryDecoder decoder(pPacket);
-			uint64 answer = decoder.ReadUInt64();
-			if (answer == expectedAnswer)
-			{
-				m_PacketManager.EnqueuePacketUnreliable(GetFreePacket(NetworkPacket::TYPE_ACCEPTED));
+			LOG_ERROR("[ClientUDPRemote]: Client responded with %lu, expected %lu, is it a fake client? [%s]", answer, expectedAnswer, GetEndPoint().ToString().c_str());
+		}
+		return true;
+	}
 
-				if (m_State == STATE_CONNECTING)
-				{
-					m_State = STATE_CONNECTED;
-					m_pHandler->OnConnectedUDP(this);
-				}
+	bool ClientUDPRemote::HandlePing(NetworkPacket* pPacket)
+	{
+		const Timestamp receiveTime = EngineLoop::GetPreciseTimeSinceStart();
+
+		if (IsConnected())
+		{
+			NetworkPacket* pPong = GetFreePacket(NetworkPacket::TYPE_PING);
+			if (ClockSynchronizer::WritePong(pPacket, pPong, receiveTime))
+			{
+				// Wakes the transmitter instead of waiting for the next tick, time in the queue counts as travel time
+				m_PacketManager.EnqueuePacketUnreliable(pPong);
+				m_pServer->Flush();
 			}
 			else
 			{
-				LOG_ERROR("[ClientUDPRemote]: Client responded with %lu, expected %lu, is it a fake client? [%s]", answer, expectedAnswer, GetEndPoint().ToString().c_str());
-			}	
-		}
-		else if (packetType == NetworkPacket::TYPE_DISCONNECT)
-		{
-			m_DisconnectedByRemote = true;
-			Disconnect();
-			return false;
+				m_PacketManager.GetPacketPool()->FreePacket(pPong);
+			}
 		}
-		else if(IsConnected())
-		{
+		return true;
+	}
+
+	bool ClientUDPRemote::HandleDisconnect(NetworkPacket* pPacket)
+	{
+		UNREFERENCED_VARIABLE(pPacket);
+
+		m_DisconnectedByRemote = true;
+		Disconnect();
+		return false;
+	}
+
+	bool ClientUDPRemote::HandleFragment(NetworkPacket* pPacket)
+	{
+		uint16 messageType;
+		TArray<char> message;
+		if (m_FragmentManager.OnFragmentReceived(pPacket, messageType, message) && IsConnected())
+			m_pHandler->OnLargePacketReceivedUDP(this, messageType, message.GetData(), message.GetSize());
+		return true;
+	}
+
+	bool ClientUDPRemote::HandleApplicationPacket(NetworkPacket* pPacket)
+	{
+		if (IsConnected())
 			m_pHandler->OnPacketReceivedUDP(this, pPacket);
-		}
 		return true;
 	}
 
 	void ClientUDPRemote::Tick(Timestamp delta)
 	{
 		m_PacketManager.Tick(delta);
+		m_FragmentManager.Tick();
 	}
 
 	void ClientUDPRemote::Disconnect()
@@ -145,7 +202,14 @@ namespace LambdaEngine
 			m_State = STATE_DISCONNECTED;
 
 			if (m_pHandler)
+			{
+				TArray<uint16> failedMessages;
+				m_FragmentManager.TakeUndeliveredMessages(failedMessages);
+				for (uint16 packetType : failedMessages)
+					m_pHandler->OnLargePacketFailedUDP(this, packetType);
+
 				m_pHandler->OnDisconnectedUDP(this);
+			}
 		}
 	}
 
@@ -178,6 +242,28 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool ClientUDPRemote::SendLarge(uint16 packetType, const char* pData, uint32 size)
+	{
+		if (!IsConnected())
+		{
+			LOG_WARNING("[ClientUDPRemote]: Can not send packet before a connection has been established");
+			return false;
+		}
+
+		return m_FragmentManager.Send(packetType, pData, size);
+	}
+
+	void ClientUDPRemote::SetChannelType(uint8 channel, EChannelType type)
+	{
+		if (channel >= FragmentManager::FRAGMENT_CHANNEL)
+		{
+			LOG_WARNING("[ClientUDPRemote]: Channel %u is reserved or out of range", uint32(channel));
+			return;
+		}
+
+		m_PacketManager.SetChannelType(channel, type);
+	}
+
 	const IPEndPoint& ClientUDPRemote::GetEndPoint() const
 	{
 		return m_PacketManager.GetEndPoint();
@@ -216,4 +302,16 @@ namespace LambdaEngine
 			delete this;
 		}
 	}
-}
\ No newline at end of file
+
+	ClientUDPRemote::PacketHandlerTable ClientUDPRemote::CreatePacketHandlers()
+	{
+		PacketHandlerTable packetHandlers;
+		packetHandlers.fill(&ClientUDPRemote::HandleApplicationPacket);
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_CONNNECT]	= &ClientUDPRemote::HandleConnect;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_PING]		= &ClientUDPRemote::HandlePing;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_CHALLENGE]	= &ClientUDPRemote::HandleChallenge;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_DISCONNECT]	= &ClientUDPRemote::HandleDisconnect;
+		packetHandlers[UINT16_MAX - NetworkPacket::TYPE_FRAGMENT]	= &ClientUDPRemote::HandleFragment;
+		return packetHandlers;
+	}
+}
@@ -0,0 +1,221 @@
+#include "Networking/API/ClockSynchronizer.h"
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/BinaryEncoder.h"
+#include "Networking/API/BinaryDecoder.h"
+
+#include "Engine/EngineLoop.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace LambdaEngine
+{
+	static const Timestamp FAST_PING_INTERVAL	= Timestamp::MilliSeconds(100);	// Until the sample window has been filled once
+	static const Timestamp PING_INTERVAL		= Timestamp::Seconds(1);
+	static const Timestamp MAX_SAMPLE_AGE		= Timestamp::Seconds(2);
+	constexpr const uint32 MIN_SAMPLES			= 4;
+	constexpr const float64 MAX_SLEW_RATE		= 0.05;
+	constexpr const int64 SNAP_THRESHOLD		= 100 * 1000 * 1000;			// Nanoseconds
+
+	constexpr const uint16 PING_SIZE = sizeof(uint64);
+	constexpr const uint16 PONG_SIZE = 5 * sizeof(uint64);
+
+	ClockSynchronizer::ClockSynchronizer()
+	{
+		Reset();
+	}
+
+	bool ClockSynchronizer::Tick(Timestamp delta)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		if (m_IsSynchronized)
+		{
+			const int64 maxStep		= int64(float64(delta.AsNanoSeconds()) * MAX_SLEW_RATE);
+			const int64 difference	= m_TargetOffset - m_Offset;
+			m_Offset += std::clamp(difference, -maxStep, maxStep);
+		}
+
+		m_TimeSincePing += delta;
+		const Timestamp interval = m_SampleCount < SAMPLE_COUNT ? FAST_PING_INTERVAL : PING_INTERVAL;
+		if (m_TimeSincePing >= interval)
+		{
+			m_TimeSincePing = 0;
+			return true;
+		}
+		return false;
+	}
+
+	bool ClockSynchronizer::OnPongReceived(NetworkPacket* pPong)
+	{
+		const uint64 receiveTime = EngineLoop::GetPreciseTimeSinceStart().AsNanoSeconds();
+
+		if (pPong->GetBufferSize() < PONG_SIZE)
+			return false;
+
+		BinaryDecoder decoder(pPong);
+		const uint64 clientSendTime		= decoder.ReadUInt64();
+		const uint64 serverReceiveTime	= decoder.ReadUInt64();
+		const uint64 serverSendTime		= decoder.ReadUInt64();
+		const uint64 serverTick			= decoder.ReadUInt64();
+		const uint64 serverTimestep		= decoder.ReadUInt64();
+
+		// Answers to pings from before a reconnect, duplicates and answers that took too long are not usable
+		if (clientSendTime > receiveTime || receiveTime - clientSendTime > MAX_SAMPLE_AGE.AsNanoSeconds())
+			return false;
+
+		if (serverSendTime < serverReceiveTime || serverTimestep == 0)
+			return false;
+
+		const uint64 serverTime = serverSendTime - serverReceiveTime;
+		const uint64 totalTime	= receiveTime - clientSendTime;
+
+		Sample sample;
+		sample.RoundTrip	= totalTime > serverTime ? int64(totalTime - serverTime) : 0;
+		sample.Offset		= ((int64(serverReceiveTime) - int64(clientSendTime)) + (int64(serverSendTime) - int64(receiveTime))) / 2;
+		sample.TickOffset	= float64(serverTick) - float64(serverSendTime) / float64(serverTimestep);
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Samples[m_NextSample]	= sample;
+		m_NextSample			= (m_NextSample + 1) % SAMPLE_COUNT;
+		m_SampleCount			= std::min(m_SampleCount + 1, SAMPLE_COUNT);
+		m_ServerTimestep		= serverTimestep;
+
+		UpdateEstimate();
+		return true;
+	}
+
+	bool ClockSynchronizer::IsSynchronized() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_IsSynchronized;
+	}
+
+	Timestamp ClockSynchronizer::GetServerTime() const
+	{
+		const int64 clientTime = int64(EngineLoop::GetPreciseTimeSinceStart().AsNanoSeconds());
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp(uint64(std::max<int64>(clientTime + m_Offset, 0)));
+	}
+
+	float64 ClockSynchronizer::GetServerTick() const
+	{
+		const Timestamp serverTime = GetServerTime();
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		if (!m_IsSynchronized)
+			return 0.0;
+
+		return std::max(float64(serverTime.AsNanoSeconds()) / float64(m_ServerTimestep) + m_TickOffset, 0.0);
+	}
+
+	Timestamp ClockSynchronizer::GetServerTimestep() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp(m_ServerTimestep);
+	}
+
+	int64 ClockSynchronizer::GetOffset() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_Offset;
+	}
+
+	Timestamp ClockSynchronizer::GetRoundTrip() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp(uint64(m_RoundTrip));
+	}
+
+	void ClockSynchronizer::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_SampleCount		= 0;
+		m_NextSample		= 0;
+		m_TimeSincePing		= 0;
+		m_Offset			= 0;
+		m_TargetOffset		= 0;
+		m_RoundTrip			= 0;
+		m_TickOffset		= 0.0;
+		m_ServerTimestep	= EngineLoop::GetFixedTimestep().AsNanoSeconds();
+		m_IsSynchronized	= false;
+	}
+
+	void ClockSynchronizer::UpdateEstimate()
+	{
+		if (m_SampleCount < MIN_SAMPLES)
+			return;
+
+		Sample samples[SAMPLE_COUNT];
+		std::copy(m_Samples, m_Samples + m_SampleCount, samples);
+		std::sort(samples, samples + m_SampleCount, [](const Sample& first, const Sample& second)
+		{
+			return first.RoundTrip < second.RoundTrip;
+		});
+
+		const int64 median = samples[m_SampleCount / 2].RoundTrip;
+
+		float64 mean = 0.0;
+		for (uint32 i = 0; i < m_SampleCount; i++)
+			mean += float64(samples[i].RoundTrip);
+		mean /= float64(m_SampleCount);
+
+		float64 variance = 0.0;
+		for (uint32 i = 0; i < m_SampleCount; i++)
+			variance += (float64(samples[i].RoundTrip) - mean) * (float64(samples[i].RoundTrip) - mean);
+		variance /= float64(m_SampleCount);
+
+		// Sorted by round trip, so the samples that are kept are the first ones and always include the median
+		const float64 maxRoundTrip = float64(median) + std::sqrt(variance);
+
+		int64 offsetSum		= 0;
+		int64 roundTripSum	= 0;
+		uint32 count		= 0;
+		while (count < m_SampleCount && float64(samples[count].RoundTrip) <= maxRoundTrip)
+		{
+			offsetSum		+= samples[count].Offset;
+			roundTripSum	+= samples[count].RoundTrip;
+			count++;
+		}
+
+		// The tick count only advances at the start of a frame, the largest offset is the one closest to a tick boundary
+		float64 tickOffset = samples[0].TickOffset;
+		for (uint32 i = 1; i < m_SampleCount; i++)
+			tickOffset = std::max(tickOffset, samples[i].TickOffset);
+
+		m_TargetOffset	= offsetSum / int64(count);
+		m_RoundTrip		= roundTripSum / int64(count);
+		m_TickOffset	= tickOffset;
+
+		if (!m_IsSynchronized || std::abs(m_TargetOffset - m_Offset) > SNAP_THRESHOLD)
+		{
+			m_Offset			= m_TargetOffset;
+			m_IsSynchronized	= true;
+		}
+	}
+
+	void ClockSynchronizer::WritePing(NetworkPacket* pPing)
+	{
+		BinaryEncoder encoder(pPing);
+		encoder.WriteUInt64(EngineLoop::GetPreciseTimeSinceStart().AsNanoSeconds());
+	}
+
+	bool ClockSynchronizer::WritePong(NetworkPacket* pPing, NetworkPacket* pPong, Timestamp receiveTime)
+	{
+		if (pPing->GetBufferSize() < PING_SIZE)
+			return false;
+
+		BinaryDecoder decoder(pPing);
+		const uint64 clientSendTime = decoder.ReadUInt64();
+
+		BinaryEncoder encoder(pPong);
+		encoder.WriteUInt64(clientSendTime);
+		encoder.WriteUInt64(receiveTime.AsNanoSeconds());
+		encoder.WriteUInt64(EngineLoop::GetPreciseTimeSinceStart().AsNanoSeconds());
+		encoder.WriteUInt64(EngineLoop::GetFixedTickCount());
+		encoder.WriteUInt64(EngineLoop::GetFixedTimestep().AsNanoSeconds());
+		return true;
+	}
+}
@@ -0,0 +1,143 @@
+#include "Networking/API/CongestionController.h"
+#include "Networking/API/NetworkPacket.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	static const Timestamp MIN_ROUND_TRIP			= Timestamp::MilliSeconds(10);
+	static const Timestamp MIN_DELIVERY_WINDOW		= Timestamp::MilliSeconds(100);
+	constexpr const float64 RETRANSMIT_BURST_WINDOW	= 0.1;	// Seconds
+	constexpr const float64 MAX_REFILL_WINDOW		= 0.05;	// Seconds, longest gap between flushes that is refilled in full
+	constexpr const float64 BANDWIDTH_SMOOTHING		= 0.25;
+
+	CongestionController::CongestionController(const CongestionControllerDesc& desc) :
+		m_Desc(desc)
+	{
+		Reset();
+	}
+
+	bool CongestionController::CanSend(Timestamp timestamp)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		Refill(timestamp);
+		return m_Tokens > 0.0;
+	}
+
+	void CongestionController::OnSent(uint32 bytes)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Tokens -= float64(bytes);
+	}
+
+	bool CongestionController::TryRetransmit(uint32 bytes, Timestamp timestamp)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		Refill(timestamp);
+
+		if (m_RetransmitTokens <= 0.0)
+		{
+			return false;
+		}
+
+		m_RetransmitTokens -= float64(bytes);
+		return true;
+	}
+
+	void CongestionController::OnAcked(uint32 bytes, Timestamp rtt, Timestamp timestamp)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		const Timestamp roundTrip = std::max(rtt, MIN_ROUND_TRIP);
+
+		// Delivery rate, measured over at least one round trip
+		m_DeliveredBytes += bytes;
+		const Timestamp elapsed = timestamp - m_DeliveryWindowStart;
+		if (elapsed >= std::max(roundTrip, MIN_DELIVERY_WINDOW))
+		{
+			const float64 sample = float64(m_DeliveredBytes) / elapsed.AsSeconds();
+			m_EstimatedBandwidth = m_EstimatedBandwidth > 0.0 ? (1.0 - BANDWIDTH_SMOOTHING) * m_EstimatedBandwidth + BANDWIDTH_SMOOTHING * sample : sample;
+			m_DeliveredBytes		= 0;
+			m_DeliveryWindowStart	= timestamp;
+		}
+
+		// Additive increase, one datagram per round trip
+		if (timestamp - m_LastIncrease >= roundTrip)
+		{
+			m_Rate += float64(MAXIMUM_PACKET_SIZE) / roundTrip.AsSeconds();
+			m_LastIncrease = timestamp;
+		}
+
+		float64 maxRate = float64(m_Desc.MaxRate);
+		if (m_EstimatedBandwidth > 0.0)
+		{
+			maxRate = std::min(maxRate, std::max(float64(m_Desc.InitialRate), 2.0 * m_EstimatedBandwidth));
+		}
+
+		m_Rate = std::clamp(m_Rate, float64(m_Desc.MinRate), std::max(maxRate, float64(m_Desc.MinRate)));
+	}
+
+	void CongestionController::OnLoss(Timestamp rtt, Timestamp timestamp)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		// Multiplicative decrease, once per round trip since the timeouts of one loss event arrive together
+		if (timestamp - m_LastDecrease >= std::max(rtt, MIN_ROUND_TRIP))
+		{
+			m_Rate			= std::max(m_Rate * float64(m_Desc.DecreaseFactor), float64(m_Desc.MinRate));
+			m_LastDecrease	= timestamp;
+			m_LastIncrease	= timestamp;
+		}
+	}
+
+	uint32 CongestionController::GetMaxQueuedBytes() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return uint32(m_Rate * float64(m_Desc.MaxQueueDelayMS) / 1000.0);
+	}
+
+	uint32 CongestionController::GetSendRate() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return uint32(m_Rate);
+	}
+
+	uint32 CongestionController::GetEstimatedBandwidth() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return uint32(m_EstimatedBandwidth);
+	}
+
+	void CongestionController::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Rate					= float64(m_Desc.InitialRate);
+		m_Tokens				= float64(2 * MAXIMUM_PACKET_SIZE);
+		m_RetransmitTokens		= float64(2 * MAXIMUM_PACKET_SIZE);
+		m_EstimatedBandwidth	= 0.0;
+		m_DeliveredBytes		= 0;
+		m_LastRefill			= 0;
+		m_DeliveryWindowStart	= 0;
+		m_LastIncrease			= 0;
+		m_LastDecrease			= 0;
+	}
+
+	void CongestionController::Refill(Timestamp timestamp)
+	{
+		if (m_LastRefill != 0 && timestamp > m_LastRefill)
+		{
+			const float64 seconds = (timestamp - m_LastRefill).AsSeconds();
+
+			// The bucket holds at least the time since the last flush, otherwise a tick longer than the burst window loses rate
+			const float64 burstWindow	= std::max(float64(m_Desc.BurstWindowMS) / 1000.0, std::min(seconds, MAX_REFILL_WINDOW));
+			const float64 bucketSize	= std::max(float64(2 * MAXIMUM_PACKET_SIZE), m_Rate * burstWindow);
+			m_Tokens = std::min(m_Tokens + m_Rate * seconds, bucketSize);
+
+			const float64 retransmitRate		= m_Rate * float64(m_Desc.RetransmitShare);
+			const float64 retransmitBucketSize	= std::max(float64(2 * MAXIMUM_PACKET_SIZE), retransmitRate * RETRANSMIT_BURST_WINDOW);
+			m_RetransmitTokens = std::min(m_RetransmitTokens + retransmitRate * seconds, retransmitBucketSize);
+		}
+
+		m_LastRefill = timestamp;
+	}
+}
@@ -0,0 +1,301 @@
+#include "Networking/API/FragmentManager.h"
+#include "Networking/API/PacketManager.h"
+#include "Networking/API/NetworkPacket.h"
+
+#include "Engine/EngineLoop.h"
+
+#include "Log/Log.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 MIN_WINDOW_FRAGMENTS = 4;
+	constexpr const uint32 MAX_WINDOW_FRAGMENTS = 128;
+	constexpr const uint32 MAX_FRAGMENT_LEAD	= 2 * MAX_WINDOW_FRAGMENTS;	// How far past the received fragments a sender within its window can be
+	constexpr const uint64 MAX_REASSEMBLY_BYTES	= 2 * FragmentManager::MAXIMUM_MESSAGE_SIZE;
+	static const Timestamp REASSEMBLY_TIMEOUT	= Timestamp::Seconds(10);
+
+	FragmentManager::FragmentManager(PacketManager* pPacketManager, IPacketListener* pListener) :
+		m_pPacketManager(pPacketManager),
+		m_pListener(pListener),
+		m_NextMessageID(0),
+		m_BytesInFlight(0),
+		m_BytesQueued(0),
+		m_BytesReassembling(0)
+	{
+		m_pPacketManager->SetChannelType(FRAGMENT_CHANNEL, CHANNEL_TYPE_RELIABLE_UNORDERED);
+	}
+
+	bool FragmentManager::Send(uint16 packetType, const char* pData, uint32 size)
+	{
+		if (size > MAXIMUM_MESSAGE_SIZE)
+		{
+			LOG_ERROR("[FragmentManager]: Message of %u bytes is larger than the maximum of %u bytes", size, MAXIMUM_MESSAGE_SIZE);
+			return false;
+		}
+
+		{
+			std::scoped_lock<SpinLock> lock(m_Lock);
+
+			OutgoingMessage message;
+			message.ID				= ++m_NextMessageID;
+			message.Type			= packetType;
+			message.FragmentCount	= uint16(std::max<uint32>((size + FRAGMENT_PAYLOAD_SIZE - 1) / FRAGMENT_PAYLOAD_SIZE, 1));
+			message.Data.Assign(pData, pData + size);
+
+			m_Sending.insert({ message.ID, SendingMessage{ packetType, size } });
+			m_Outgoing.push_back(std::move(message));
+			m_BytesQueued += size;
+		}
+
+		SendFragments();
+		return true;
+	}
+
+	void FragmentManager::Tick()
+	{
+		DeleteTimedOutMessages();
+		SendFragments();
+	}
+
+	void FragmentManager::SendFragments()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		const uint32 windowSize = GetWindowSize();
+
+		while (!m_Outgoing.empty() && m_BytesInFlight < windowSize)
+		{
+			OutgoingMessage& message = m_Outgoing.front();
+
+			NetworkPacket* pPacket = m_pPacketManager->GetPacketPool()->RequestFreePacket();
+			if (!pPacket)
+				break;
+
+			FragmentHeader header;
+			header.MessageID	= message.ID;
+			header.MessageSize	= message.Data.GetSize();
+			header.Index		= message.NextFragment;
+			header.Count		= message.FragmentCount;
+			header.Type			= message.Type;
+
+			const uint32 offset	= uint32(header.Index) * FRAGMENT_PAYLOAD_SIZE;
+			const uint16 bytes	= uint16(std::min<uint32>(FRAGMENT_PAYLOAD_SIZE, header.MessageSize - offset));
+
+			pPacket->SetType(NetworkPacket::TYPE_FRAGMENT)->SetChannel(FRAGMENT_CHANNEL);
+			memcpy(pPacket->GetBuffer(), &header, sizeof(header));
+			memcpy(pPacket->GetBuffer() + sizeof(header), message.Data.GetData() + offset, bytes);
+			pPacket->AppendBytes(sizeof(header) + bytes);
+
+			m_BytesInFlight += pPacket->GetTotalSize();
+			m_pPacketManager->EnqueuePacketReliable(pPacket, this);
+
+			if (++message.NextFragment == message.FragmentCount)
+				m_Outgoing.pop_front();
+		}
+	}
+
+	bool FragmentManager::OnFragmentReceived(NetworkPacket* pPacket, uint16& packetType, TArray<char>& data)
+	{
+		FragmentHeader header;
+		if (pPacket->GetBufferSize() < sizeof(header))
+			return false;
+
+		memcpy(&header, pPacket->GetBufferReadOnly(), sizeof(header));
+
+		const uint32 offset	= uint32(header.Index) * FRAGMENT_PAYLOAD_SIZE;
+		const uint32 bytes	= pPacket->GetBufferSize() - sizeof(header);
+
+		// Every fragment but the last is full, so a complete message has no gaps
+		const uint32 fragmentCount = std::max<uint32>((header.MessageSize + FRAGMENT_PAYLOAD_SIZE - 1) / FRAGMENT_PAYLOAD_SIZE, 1);
+		if (header.MessageSize > MAXIMUM_MESSAGE_SIZE || header.Count != fragmentCount || header.Index >= header.Count || bytes != std::min<uint32>(FRAGMENT_PAYLOAD_SIZE, header.MessageSize - offset))
+		{
+			LOG_ERROR("[FragmentManager]: Received an invalid fragment [ID %u, %u/%u]", header.MessageID, header.Index, header.Count);
+			return false;
+		}
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		auto iterator = m_Incoming.find(header.MessageID);
+		if (iterator == m_Incoming.end())
+		{
+			IncomingMessage message;
+			message.Type			= header.Type;
+			message.FragmentCount	= header.Count;
+			message.MessageSize		= header.MessageSize;
+
+			iterator = m_Incoming.insert({ header.MessageID, std::move(message) }).first;
+		}
+
+		IncomingMessage& message = iterator->second;
+		if (message.MessageSize != header.MessageSize)
+		{
+			LOG_ERROR("[FragmentManager]: Fragment does not match message %u", header.MessageID);
+			return false;
+		}
+
+		// The window keeps a well behaved sender close to the fragments that have arrived, so the buffer only grows with
+		// the data received and not with the size the peer claims
+		if (header.Index > message.FragmentsReceived + MAX_FRAGMENT_LEAD)
+		{
+			LOG_ERROR("[FragmentManager]: Fragment %u of message %u is too far ahead of the received fragments", header.Index, header.MessageID);
+			return false;
+		}
+
+		const uint32 end = offset + bytes;
+		if (end > message.Data.GetSize())
+		{
+			// TArray::Resize grows the array when the new size reaches the capacity, the spare byte keeps it at the size reserved here
+			if (end >= message.Data.GetCapacity())
+			{
+				const uint32 capacity = std::min(std::max(end, 2 * message.Data.GetCapacity()), message.MessageSize) + 1;
+				if (m_BytesReassembling + capacity - message.Data.GetCapacity() > MAX_REASSEMBLY_BYTES)
+				{
+					LOG_ERROR("[FragmentManager]: Too many incomplete messages, dropping fragment of message %u", header.MessageID);
+					return false;
+				}
+
+				m_BytesReassembling += capacity - message.Data.GetCapacity();
+				message.Data.Reserve(capacity);
+			}
+
+			message.Data.Resize(end);
+		}
+
+		// The channel filters duplicates, so every fragment is counted once
+		memcpy(message.Data.GetData() + offset, pPacket->GetBufferReadOnly() + sizeof(header), bytes);
+		message.LastReceived = EngineLoop::GetTimeSinceStart();
+
+		if (++message.FragmentsReceived < message.FragmentCount)
+			return false;
+
+		m_BytesReassembling -= message.Data.GetCapacity();
+
+		packetType = message.Type;
+		data = std::move(message.Data);
+
+		m_Incoming.erase(iterator);
+		return true;
+	}
+
+	void FragmentManager::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Outgoing.clear();
+		m_Sending.clear();
+		m_Incoming.clear();
+		m_BytesInFlight		= 0;
+		m_BytesQueued		= 0;
+		m_BytesReassembling	= 0;
+	}
+
+	void FragmentManager::TakeUndeliveredMessages(TArray<uint16>& packetTypes)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		packetTypes.Clear();
+		for (auto& pair : m_Sending)
+			packetTypes.PushBack(pair.second.Type);
+
+		m_Outgoing.clear();
+		m_Sending.clear();
+		m_BytesQueued = 0;
+	}
+
+	uint64 FragmentManager::GetBytesQueued() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_BytesQueued;
+	}
+
+	void FragmentManager::OnPacketDelivered(NetworkPacket* pPacket)
+	{
+		FragmentHeader header;
+		memcpy(&header, pPacket->GetBufferReadOnly(), sizeof(header));
+		const uint32 bytes = pPacket->GetBufferSize() - sizeof(header);
+
+		{
+			std::scoped_lock<SpinLock> lock(m_Lock);
+			m_BytesInFlight -= std::min<uint32>(m_BytesInFlight, pPacket->GetTotalSize());
+
+			auto iterator = m_Sending.find(header.MessageID);
+			if (iterator != m_Sending.end())
+			{
+				SendingMessage& message = iterator->second;
+				message.BytesUnacked	-= std::min<uint64>(message.BytesUnacked, bytes);
+				m_BytesQueued			-= std::min<uint64>(m_BytesQueued, bytes);
+
+				// Empty messages still wait for their single fragment
+				if (message.BytesUnacked == 0)
+					m_Sending.erase(iterator);
+			}
+		}
+
+		// Keeps the window full without waiting for the next tick
+		SendFragments();
+	}
+
+	void FragmentManager::OnPacketResent(NetworkPacket* pPacket, uint8 retries)
+	{
+		if (m_pListener)
+			m_pListener->OnPacketResent(pPacket, retries);
+	}
+
+	void FragmentManager::OnPacketMaxTriesReached(NetworkPacket* pPacket, uint8 retries)
+	{
+		FragmentHeader header;
+		memcpy(&header, pPacket->GetBufferReadOnly(), sizeof(header));
+
+		{
+			std::scoped_lock<SpinLock> lock(m_Lock);
+			m_BytesInFlight -= std::min<uint32>(m_BytesInFlight, pPacket->GetTotalSize());
+
+			// The message can not be completed anymore, its remaining fragments are not sent. It stays undelivered
+			// until TakeUndeliveredMessages is called
+			auto iterator = std::find_if(m_Outgoing.begin(), m_Outgoing.end(), [&](const OutgoingMessage& message) { return message.ID == header.MessageID; });
+			if (iterator != m_Outgoing.end())
+				m_Outgoing.erase(iterator);
+		}
+
+		if (m_pListener)
+			m_pListener->OnPacketMaxTriesReached(pPacket, retries);
+	}
+
+	/*
+	* Drops incomplete messages that have not received a fragment for REASSEMBLY_TIMEOUT, a sender that is still
+	* connected resends much more often than that
+	*/
+	void FragmentManager::DeleteTimedOutMessages()
+	{
+		const Timestamp currentTime = EngineLoop::GetTimeSinceStart();
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		for (auto iterator = m_Incoming.begin(); iterator != m_Incoming.end();)
+		{
+			IncomingMessage& message = iterator->second;
+			if (currentTime - message.LastReceived > REASSEMBLY_TIMEOUT)
+			{
+				LOG_WARNING("[FragmentManager]: Message %u timed out with %u/%u fragments received", iterator->first, uint32(message.FragmentsReceived), uint32(message.FragmentCount));
+				m_BytesReassembling -= message.Data.GetCapacity();
+				iterator = m_Incoming.erase(iterator);
+			}
+			else
+			{
+				iterator++;
+			}
+		}
+	}
+
+	/*
+	* One bandwidth-delay product at the current send rate, which is what keeps the link busy
+	*/
+	uint32 FragmentManager::GetWindowSize() const
+	{
+		const float64 rate			= float64(m_pPacketManager->GetCongestionController()->GetSendRate());
+		const float64 roundTrip		= m_pPacketManager->GetStatistics()->GetPing().AsSeconds();
+		const uint32 windowSize		= uint32(rate * roundTrip);
+
+		return std::clamp<uint32>(windowSize, MIN_WINDOW_FRAGMENTS * MAXIMUM_PACKET_SIZE, MAX_WINDOW_FRAGMENTS * MAXIMUM_PACKET_SIZE);
+	}
+}
@@ -0,0 +1,87 @@
+#include "Networking/API/InterestGrid.h"
+
+namespace LambdaEngine
+{
+	InterestGrid::InterestGrid(float32 cellSize) :
+		m_CellSize(cellSize),
+		m_InverseCellSize(1.0f / cellSize)
+	{
+		ASSERT(cellSize > 0.0f);
+	}
+
+	void InterestGrid::Insert(uint32 objectID, const glm::vec3& position)
+	{
+		m_Cells[GetCellKey(position)].PushBack(objectID);
+	}
+
+	void InterestGrid::Remove(uint32 objectID, const glm::vec3& position)
+	{
+		auto iterator = m_Cells.find(GetCellKey(position));
+		if (iterator == m_Cells.end())
+			return;
+
+		TArray<uint32>& objects = iterator->second;
+		for (uint32 i = 0; i < objects.GetSize(); i++)
+		{
+			if (objects[i] == objectID)
+			{
+				objects[i] = objects.GetBack();
+				objects.PopBack();
+				break;
+			}
+		}
+
+		if (objects.IsEmpty())
+			m_Cells.erase(iterator);
+	}
+
+	void InterestGrid::Move(uint32 objectID, const glm::vec3& oldPosition, const glm::vec3& newPosition)
+	{
+		if (GetCellKey(oldPosition) != GetCellKey(newPosition))
+		{
+			Remove(objectID, oldPosition);
+			Insert(objectID, newPosition);
+		}
+	}
+
+	void InterestGrid::Query(const glm::vec3& center, float32 radius, TArray<uint32>& objectIDs) const
+	{
+		const int32 minX = int32(glm::floor((center.x - radius) * m_InverseCellSize));
+		const int32 maxX = int32(glm::floor((center.x + radius) * m_InverseCellSize));
+		const int32 minZ = int32(glm::floor((center.z - radius) * m_InverseCellSize));
+		const int32 maxZ = int32(glm::floor((center.z + radius) * m_InverseCellSize));
+
+		for (int32 z = minZ; z <= maxZ; z++)
+		{
+			for (int32 x = minX; x <= maxX; x++)
+			{
+				auto iterator = m_Cells.find(GetCellKey(x, z));
+				if (iterator != m_Cells.end())
+				{
+					for (uint32 objectID : iterator->second)
+						objectIDs.PushBack(objectID);
+				}
+			}
+		}
+	}
+
+	void InterestGrid::Clear()
+	{
+		m_Cells.clear();
+	}
+
+	float32 InterestGrid::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	uint64 InterestGrid::GetCellKey(const glm::vec3& position) const
+	{
+		return GetCellKey(int32(glm::floor(position.x * m_InverseCellSize)), int32(glm::floor(position.z * m_InverseCellSize)));
+	}
+
+	uint64 InterestGrid::GetCellKey(int32 x, int32 z)
+	{
+		return (uint64(uint32(x)) << 32) | uint64(uint32(z));
+	}
+}
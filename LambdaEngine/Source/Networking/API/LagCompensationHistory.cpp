@@ -0,0 +1,264 @@
+#include "Networking/API/LagCompensationHistory.h"
+#include "Networking/API/NetworkStatistics.h"
+
+#include <algorithm>
+
+#include <emmintrin.h>
+
+namespace LambdaEngine
+{
+	constexpr const float32 NO_ENTITY = -1.0f;	// Radius of empty slots
+
+	LagCompensationHistory::LagCompensationHistory(const LagCompensationHistoryDesc& desc) :
+		m_Desc(desc),
+		m_Stride((desc.MaxEntities + 3) & ~3u)
+	{
+		VALIDATE(desc.HistorySize > 0);
+
+		m_Current.Resize(4 * m_Stride);
+		m_Frames.Resize(4 * m_Stride * m_Desc.HistorySize);
+		m_FrameTimes.Resize(m_Desc.HistorySize);
+		Reset();
+	}
+
+	void LagCompensationHistory::SetEntity(uint32 entityIndex, const glm::vec3& center, float32 radius)
+	{
+		VALIDATE(entityIndex < m_Desc.MaxEntities);
+
+		m_Current[entityIndex]					= center.x;
+		m_Current[m_Stride + entityIndex]		= center.y;
+		m_Current[2 * m_Stride + entityIndex]	= center.z;
+		m_Current[3 * m_Stride + entityIndex]	= radius;
+	}
+
+	void LagCompensationHistory::RemoveEntity(uint32 entityIndex)
+	{
+		VALIDATE(entityIndex < m_Desc.MaxEntities);
+		m_Current[3 * m_Stride + entityIndex] = NO_ENTITY;
+	}
+
+	void LagCompensationHistory::RecordTick(Timestamp time)
+	{
+		uint32 frame;
+		if (m_FrameCount > 0 && time.AsNanoSeconds() <= m_FrameTimes[(m_Head + m_FrameCount - 1) % m_Desc.HistorySize])
+		{
+			// The same tick recorded again, the newest frame is replaced so that frame times stay increasing
+			frame = (m_Head + m_FrameCount - 1) % m_Desc.HistorySize;
+		}
+		else
+		{
+			if (m_FrameCount == m_Desc.HistorySize)
+			{
+				m_Head = (m_Head + 1) % m_Desc.HistorySize;
+				m_FrameCount--;
+			}
+
+			frame = (m_Head + m_FrameCount) % m_Desc.HistorySize;
+			m_FrameTimes[frame] = time.AsNanoSeconds();
+			m_FrameCount++;
+		}
+
+		memcpy(m_Frames.GetData() + frame * 4 * m_Stride, m_Current.GetData(), sizeof(float32) * 4 * m_Stride);
+	}
+
+	Timestamp LagCompensationHistory::GetViewTime(const NetworkStatistics* pStatistics, Timestamp now) const
+	{
+		float64 rewind = float64(m_Desc.InterpolationDelayMS) / 1000.0;
+		if (pStatistics)
+			rewind += pStatistics->GetPing().AsSeconds() / 2.0;
+
+		const Timestamp rewindTime = Timestamp::Seconds(std::min(rewind, float64(m_Desc.MaxRewindMS) / 1000.0));
+		return now > rewindTime ? now - rewindTime : Timestamp(0);
+	}
+
+	bool LagCompensationHistory::Raycast(Timestamp time, const glm::vec3& origin, const glm::vec3& direction, float32 maxDistance, uint32 ignoreIndex, LagCompensationHit& hit) const
+	{
+		const float32* pFrom;
+		const float32* pTo;
+		float32 alpha;
+		if (!FindFrames(time, pFrom, pTo, alpha))
+			return false;
+
+		const __m128 alphas		= _mm_set1_ps(alpha);
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 originX	= _mm_set1_ps(origin.x);
+		const __m128 originY	= _mm_set1_ps(origin.y);
+		const __m128 originZ	= _mm_set1_ps(origin.z);
+		const __m128 directionX	= _mm_set1_ps(direction.x);
+		const __m128 directionY	= _mm_set1_ps(direction.y);
+		const __m128 directionZ	= _mm_set1_ps(direction.z);
+		const __m128 distance	= _mm_set1_ps(maxDistance);
+
+		bool isHit = false;
+		hit.Distance = maxDistance;
+
+		for (uint32 i = 0; i < m_Stride; i += 4)
+		{
+			const __m128 fromRadius	= _mm_loadu_ps(pFrom + 3 * m_Stride + i);
+			const __m128 toRadius	= _mm_loadu_ps(pTo + 3 * m_Stride + i);
+			const __m128 exists		= _mm_and_ps(_mm_cmpgt_ps(fromRadius, zero), _mm_cmpgt_ps(toRadius, zero));
+			if (_mm_movemask_ps(exists) == 0)
+				continue;
+
+			const __m128 radius		= _mm_add_ps(fromRadius, _mm_mul_ps(_mm_sub_ps(toRadius, fromRadius), alphas));
+			const __m128 fromX		= _mm_loadu_ps(pFrom + i);
+			const __m128 fromY		= _mm_loadu_ps(pFrom + m_Stride + i);
+			const __m128 fromZ		= _mm_loadu_ps(pFrom + 2 * m_Stride + i);
+			const __m128 x			= _mm_add_ps(fromX, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + i), fromX), alphas));
+			const __m128 y			= _mm_add_ps(fromY, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + m_Stride + i), fromY), alphas));
+			const __m128 z			= _mm_add_ps(fromZ, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + 2 * m_Stride + i), fromZ), alphas));
+
+			// Distance along the ray to the point closest to the center, and the squared distance from there to the center
+			const __m128 toCenterX	= _mm_sub_ps(x, originX);
+			const __m128 toCenterY	= _mm_sub_ps(y, originY);
+			const __m128 toCenterZ	= _mm_sub_ps(z, originZ);
+			const __m128 closest	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCenterX, directionX), _mm_mul_ps(toCenterY, directionY)), _mm_mul_ps(toCenterZ, directionZ));
+			const __m128 lengthSq	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCenterX, toCenterX), _mm_mul_ps(toCenterY, toCenterY)), _mm_mul_ps(toCenterZ, toCenterZ));
+			const __m128 halfChord	= _mm_sub_ps(_mm_mul_ps(radius, radius), _mm_sub_ps(lengthSq, _mm_mul_ps(closest, closest)));
+
+			const __m128 chord		= _mm_sqrt_ps(_mm_max_ps(halfChord, zero));
+			const __m128 nearHit	= _mm_sub_ps(closest, chord);
+			const __m128 farHit		= _mm_add_ps(closest, chord);
+
+			// A ray starting inside a sphere hits it at zero
+			__m128 hits = _mm_and_ps(exists, _mm_cmpge_ps(halfChord, zero));
+			hits = _mm_and_ps(hits, _mm_cmpge_ps(farHit, zero));
+			hits = _mm_and_ps(hits, _mm_cmple_ps(nearHit, distance));
+
+			int32 mask = _mm_movemask_ps(hits);
+			if (mask == 0)
+				continue;
+
+			alignas(16) float32 distances[4];
+			_mm_store_ps(distances, _mm_max_ps(nearHit, zero));
+
+			for (uint32 lane = 0; lane < 4; lane++)
+			{
+				const uint32 entityIndex = i + lane;
+				if ((mask & (1 << lane)) && entityIndex != ignoreIndex && distances[lane] <= hit.Distance)
+				{
+					hit.EntityIndex	= entityIndex;
+					hit.Distance	= distances[lane];
+					isHit			= true;
+				}
+			}
+		}
+
+		return isHit;
+	}
+
+	uint32 LagCompensationHistory::OverlapSphere(Timestamp time, const glm::vec3& center, float32 radius, TArray<uint32>& entityIndices) const
+	{
+		entityIndices.Clear();
+
+		const float32* pFrom;
+		const float32* pTo;
+		float32 alpha;
+		if (!FindFrames(time, pFrom, pTo, alpha))
+			return 0;
+
+		const __m128 alphas		= _mm_set1_ps(alpha);
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 centerX	= _mm_set1_ps(center.x);
+		const __m128 centerY	= _mm_set1_ps(center.y);
+		const __m128 centerZ	= _mm_set1_ps(center.z);
+		const __m128 sphere		= _mm_set1_ps(radius);
+
+		for (uint32 i = 0; i < m_Stride; i += 4)
+		{
+			const __m128 fromRadius	= _mm_loadu_ps(pFrom + 3 * m_Stride + i);
+			const __m128 toRadius	= _mm_loadu_ps(pTo + 3 * m_Stride + i);
+			const __m128 exists		= _mm_and_ps(_mm_cmpgt_ps(fromRadius, zero), _mm_cmpgt_ps(toRadius, zero));
+			if (_mm_movemask_ps(exists) == 0)
+				continue;
+
+			const __m128 fromX		= _mm_loadu_ps(pFrom + i);
+			const __m128 fromY		= _mm_loadu_ps(pFrom + m_Stride + i);
+			const __m128 fromZ		= _mm_loadu_ps(pFrom + 2 * m_Stride + i);
+			const __m128 deltaX		= _mm_sub_ps(_mm_add_ps(fromX, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + i), fromX), alphas)), centerX);
+			const __m128 deltaY		= _mm_sub_ps(_mm_add_ps(fromY, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + m_Stride + i), fromY), alphas)), centerY);
+			const __m128 deltaZ		= _mm_sub_ps(_mm_add_ps(fromZ, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pTo + 2 * m_Stride + i), fromZ), alphas)), centerZ);
+			const __m128 lengthSq	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ));
+			const __m128 reach		= _mm_add_ps(sphere, _mm_add_ps(fromRadius, _mm_mul_ps(_mm_sub_ps(toRadius, fromRadius), alphas)));
+
+			const int32 mask = _mm_movemask_ps(_mm_and_ps(exists, _mm_cmple_ps(lengthSq, _mm_mul_ps(reach, reach))));
+			for (uint32 lane = 0; lane < 4; lane++)
+			{
+				if (mask & (1 << lane))
+					entityIndices.PushBack(i + lane);
+			}
+		}
+
+		return entityIndices.GetSize();
+	}
+
+	bool LagCompensationHistory::GetEntity(Timestamp time, uint32 entityIndex, glm::vec3& center, float32& radius) const
+	{
+		VALIDATE(entityIndex < m_Desc.MaxEntities);
+
+		const float32* pFrom;
+		const float32* pTo;
+		float32 alpha;
+		if (!FindFrames(time, pFrom, pTo, alpha))
+			return false;
+
+		const float32 fromRadius	= pFrom[3 * m_Stride + entityIndex];
+		const float32 toRadius		= pTo[3 * m_Stride + entityIndex];
+		if (fromRadius <= 0.0f || toRadius <= 0.0f)
+			return false;
+
+		center.x	= pFrom[entityIndex] + (pTo[entityIndex] - pFrom[entityIndex]) * alpha;
+		center.y	= pFrom[m_Stride + entityIndex] + (pTo[m_Stride + entityIndex] - pFrom[m_Stride + entityIndex]) * alpha;
+		center.z	= pFrom[2 * m_Stride + entityIndex] + (pTo[2 * m_Stride + entityIndex] - pFrom[2 * m_Stride + entityIndex]) * alpha;
+		radius		= fromRadius + (toRadius - fromRadius) * alpha;
+		return true;
+	}
+
+	uint32 LagCompensationHistory::GetRecordedTickCount() const
+	{
+		return m_FrameCount;
+	}
+
+	void LagCompensationHistory::Reset()
+	{
+		float32* pCurrent = m_Current.GetData();
+		std::fill(pCurrent, pCurrent + 3 * m_Stride, 0.0f);
+		std::fill(pCurrent + 3 * m_Stride, pCurrent + 4 * m_Stride, NO_ENTITY);
+		m_Head			= 0;
+		m_FrameCount	= 0;
+	}
+
+	/*
+	* Times outside the history are clamped to the oldest or newest tick
+	*/
+	bool LagCompensationHistory::FindFrames(Timestamp time, const float32*& pFrom, const float32*& pTo, float32& alpha) const
+	{
+		if (m_FrameCount == 0)
+			return false;
+
+		auto getFrameTime = [this](uint32 index)
+		{
+			return m_FrameTimes[(m_Head + index) % m_Desc.HistorySize];
+		};
+
+		const uint64 newest		= getFrameTime(m_FrameCount - 1);
+		const uint64 oldest		= getFrameTime(0);
+		const uint64 clamped	= std::clamp(time.AsNanoSeconds(), oldest, newest);
+
+		// Recent times are the common case, so the search starts at the newest tick
+		uint32 from = m_FrameCount - 1;
+		while (from > 0 && getFrameTime(from) > clamped)
+			from--;
+
+		const uint32 to = std::min(from + 1, m_FrameCount - 1);
+		pFrom	= GetFrame(from);
+		pTo		= GetFrame(to);
+		alpha	= (to == from) ? 0.0f : float32(float64(clamped - getFrameTime(from)) / float64(getFrameTime(to) - getFrameTime(from)));
+		return true;
+	}
+
+	const float32* LagCompensationHistory::GetFrame(uint32 index) const
+	{
+		return m_Frames.GetData() + ((m_Head + index) % m_Desc.HistorySize) * 4 * m_Stride;
+	}
+}
@@ -0,0 +1,286 @@
+#include "Networking/API/LoopbackSocketUDP.h"
+#include "Networking/API/IPAddress.h"
+
+#include "Log/Log.h"
+
+#include <shared_mutex>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 LOOPBACK_RECEIVE_QUEUE_SIZE	= 1024;
+	constexpr const uint32 LOOPBACK_DATAGRAM_POOL_SIZE	= 8192;
+	constexpr const uint16 LOOPBACK_EPHEMERAL_PORT_MIN	= 49152;
+	constexpr const auto LOOPBACK_RECEIVE_TIMEOUT		= std::chrono::milliseconds(5);
+
+	/*
+	* Free datagram buffers shared by all loopback sockets, buffers that do not fit in the pool are deleted
+	*/
+	struct LoopbackDatagramPool
+	{
+		TLockFreeQueue<LoopbackDatagram*> FreeDatagrams;
+
+		LoopbackDatagramPool() :
+			FreeDatagrams(LOOPBACK_DATAGRAM_POOL_SIZE)
+		{
+		}
+
+		~LoopbackDatagramPool()
+		{
+			LoopbackDatagram* pDatagram = nullptr;
+			while (FreeDatagrams.TryPop(pDatagram))
+			{
+				delete pDatagram;
+			}
+		}
+	};
+
+	static LoopbackDatagramPool								g_DatagramPool;
+	static std::unordered_map<uint16, LoopbackSocketUDP*>	g_BoundSockets;
+	static std::shared_mutex								g_BoundSocketsLock;
+	static uint16											g_NextEphemeralPort	= LOOPBACK_EPHEMERAL_PORT_MIN;
+	static std::atomic<uint64>								g_DroppedDatagrams	= 0;
+
+	LoopbackSocketUDP::LoopbackSocketUDP() :
+		m_ReceiveQueue(LOOPBACK_RECEIVE_QUEUE_SIZE),
+		m_IsWaiting(false),
+		m_IsClosed(false),
+		m_IsBound(false),
+		m_IsNonBlocking(false)
+	{
+	}
+
+	LoopbackSocketUDP::~LoopbackSocketUDP()
+	{
+		Close();
+	}
+
+	bool LoopbackSocketUDP::Bind(const IPEndPoint& ipEndPoint)
+	{
+		if (m_IsClosed || m_IsBound)
+		{
+			LOG_ERROR("[LoopbackSocketUDP]: Failed to bind to %s, the socket is closed or already bound", ipEndPoint.ToString().c_str());
+			return false;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(g_BoundSocketsLock);
+
+		uint16 port = ipEndPoint.GetPort();
+		if (port == 0)
+		{
+			constexpr const uint32 ephemeralPortCount = UINT16_MAX - LOOPBACK_EPHEMERAL_PORT_MIN + 1;
+			for (uint32 i = 0; i < ephemeralPortCount && port == 0; i++)
+			{
+				const uint16 candidate = g_NextEphemeralPort;
+				g_NextEphemeralPort = candidate == UINT16_MAX ? LOOPBACK_EPHEMERAL_PORT_MIN : candidate + 1;
+
+				if (g_BoundSockets.find(candidate) == g_BoundSockets.end())
+				{
+					port = candidate;
+				}
+			}
+
+			if (port == 0)
+			{
+				LOG_ERROR("[LoopbackSocketUDP]: Failed to bind to %s, no free ephemeral ports", ipEndPoint.ToString().c_str());
+				return false;
+			}
+		}
+		else if (g_BoundSockets.find(port) != g_BoundSockets.end())
+		{
+			LOG_ERROR("[LoopbackSocketUDP]: Failed to bind to %s, the port is already in use", ipEndPoint.ToString().c_str());
+			return false;
+		}
+
+		g_BoundSockets.insert({ port, this });
+		m_IPEndPoint.SetEndPoint(ipEndPoint.GetAddress(), port);
+		m_IsBound = true;
+		return true;
+	}
+
+	bool LoopbackSocketUDP::Connect(const IPEndPoint& ipEndPoint)
+	{
+		UNREFERENCED_VARIABLE(ipEndPoint);
+
+		if (m_IsClosed)
+		{
+			return false;
+		}
+
+		return m_IsBound || Bind(IPEndPoint(IPAddress::LOOPBACK, 0));
+	}
+
+	bool LoopbackSocketUDP::EnableBlocking(bool enable)
+	{
+		m_IsNonBlocking = !enable;
+		return true;
+	}
+
+	bool LoopbackSocketUDP::IsNonBlocking() const
+	{
+		return m_IsNonBlocking;
+	}
+
+	bool LoopbackSocketUDP::Close()
+	{
+		if (m_IsClosed.exchange(true))
+		{
+			return true;
+		}
+
+		// After unbinding no sender can reach this socket, so whatever is left in the queue can be freed
+		Unbind();
+
+		LoopbackDatagram* pDatagram = nullptr;
+		while (m_ReceiveQueue.TryPop(pDatagram))
+		{
+			FreeDatagram(pDatagram);
+		}
+
+		{
+			std::scoped_lock<std::mutex> lock(m_WaitMutex);
+			m_WaitCondition.notify_all();
+		}
+
+		return true;
+	}
+
+	bool LoopbackSocketUDP::IsClosed() const
+	{
+		return m_IsClosed;
+	}
+
+	const IPEndPoint& LoopbackSocketUDP::GetEndPoint() const
+	{
+		return m_IPEndPoint;
+	}
+
+	bool LoopbackSocketUDP::SendTo(const char* pBuffer, uint32 bytesToSend, int32& bytesSent, const IPEndPoint& ipEndPoint)
+	{
+		bytesSent = 0;
+
+		if (m_IsClosed)
+		{
+			return false;
+		}
+
+		if (bytesToSend > MAXIMUM_PACKET_SIZE)
+		{
+			LOG_ERROR("[LoopbackSocketUDP]: Failed to send datagram packet of %u bytes to %s, larger than %d bytes", bytesToSend, ipEndPoint.ToString().c_str(), MAXIMUM_PACKET_SIZE);
+			return false;
+		}
+
+		// Like a real socket, sending from an unbound socket binds it to an ephemeral port
+		if (!m_IsBound && !Bind(IPEndPoint(IPAddress::ANY, 0)))
+		{
+			return false;
+		}
+
+		bytesSent = int32(bytesToSend);
+
+		std::shared_lock<std::shared_mutex> lock(g_BoundSocketsLock);
+
+		auto iterator = g_BoundSockets.find(ipEndPoint.GetPort());
+		if (iterator == g_BoundSockets.end())
+		{
+			g_DroppedDatagrams++;
+			return true;
+		}
+
+		LoopbackSocketUDP* pReceiver = iterator->second;
+
+		LoopbackDatagram* pDatagram = AllocateDatagram();
+		pDatagram->Sender.SetEndPoint(IPAddress::LOOPBACK, m_IPEndPoint.GetPort());
+		pDatagram->Size = int32(bytesToSend);
+		memcpy(pDatagram->pData, pBuffer, bytesToSend);
+
+		if (!pReceiver->m_ReceiveQueue.TryPush(pDatagram))
+		{
+			FreeDatagram(pDatagram);
+			g_DroppedDatagrams++;
+			return true;
+		}
+
+		// A wakeup missed between the receiver checking the queue and starting to wait is bounded by LOOPBACK_RECEIVE_TIMEOUT
+		if (pReceiver->m_IsWaiting)
+		{
+			std::scoped_lock<std::mutex> waitLock(pReceiver->m_WaitMutex);
+			pReceiver->m_WaitCondition.notify_one();
+		}
+
+		return true;
+	}
+
+	bool LoopbackSocketUDP::ReceiveFrom(char* pBuffer, uint32 size, int32& bytesReceived, IPEndPoint& ipEndPoint)
+	{
+		bytesReceived = 0;
+
+		LoopbackDatagram* pDatagram = nullptr;
+		if (!m_ReceiveQueue.TryPop(pDatagram))
+		{
+			if (m_IsClosed || m_IsNonBlocking)
+			{
+				return false;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(m_WaitMutex);
+				m_IsWaiting = true;
+				m_WaitCondition.wait_for(lock, LOOPBACK_RECEIVE_TIMEOUT, [this] { return !m_ReceiveQueue.IsEmpty() || m_IsClosed; });
+				m_IsWaiting = false;
+			}
+
+			if (m_IsClosed || !m_ReceiveQueue.TryPop(pDatagram))
+			{
+				return false;
+			}
+		}
+
+		// Datagrams that do not fit in the buffer are truncated
+		bytesReceived = pDatagram->Size < int32(size) ? pDatagram->Size : int32(size);
+		memcpy(pBuffer, pDatagram->pData, bytesReceived);
+		ipEndPoint = pDatagram->Sender;
+
+		FreeDatagram(pDatagram);
+		return true;
+	}
+
+	bool LoopbackSocketUDP::EnableBroadcast(bool enable)
+	{
+		UNREFERENCED_VARIABLE(enable);
+		LOG_WARNING("[LoopbackSocketUDP]: Broadcast is not supported");
+		return false;
+	}
+
+	uint64 LoopbackSocketUDP::GetDroppedDatagrams()
+	{
+		return g_DroppedDatagrams;
+	}
+
+	void LoopbackSocketUDP::Unbind()
+	{
+		if (m_IsBound)
+		{
+			std::unique_lock<std::shared_mutex> lock(g_BoundSocketsLock);
+			g_BoundSockets.erase(m_IPEndPoint.GetPort());
+			m_IsBound = false;
+		}
+	}
+
+	LoopbackDatagram* LoopbackSocketUDP::AllocateDatagram()
+	{
+		LoopbackDatagram* pDatagram = nullptr;
+		if (!g_DatagramPool.FreeDatagrams.TryPop(pDatagram))
+		{
+			pDatagram = DBG_NEW LoopbackDatagram();
+		}
+		return pDatagram;
+	}
+
+	void LoopbackSocketUDP::FreeDatagram(LoopbackDatagram* pDatagram)
+	{
+		if (!g_DatagramPool.FreeDatagrams.TryPush(pDatagram))
+		{
+			delete pDatagram;
+		}
+	}
+}
@@ -4,6 +4,8 @@
 
 #include "Threading/API/Thread.h"
 
+#include "Profiling/Profiler.h"
+
 namespace LambdaEngine
 {
 	SpinLock NetWorker::s_LockStatic;
@@ -17,6 +19,7 @@ namespace LambdaEngine
 		m_Initiated(false),
 		m_ThreadsTerminated(true),
 		m_Release(false),
+		m_IsPolling(false),
 		m_pReceiveBuffer()
 	{
 
@@ -45,6 +48,13 @@ namespace LambdaEngine
 			OnReleaseRequested();
 		}
 
+		// A polled worker is not polled after it has been released, so it terminates here
+		if (m_IsPolling.exchange(false))
+		{
+			OnThreadsTerminated();
+			m_ThreadsTerminated = true;
+		}
+
 		if (m_ThreadsTerminated)
 		{
 			delete this;
@@ -71,10 +81,42 @@ namespace LambdaEngine
 		return !m_Run;
 	}
 
-	void NetWorker::YieldTransmitter()
+	void NetWorker::YieldTransmitter(Timestamp timeout)
 	{
 		if (m_pThreadTransmitter)
-			m_pThreadTransmitter->Wait();
+			m_pThreadTransmitter->Wait(timeout);
+	}
+
+	bool NetWorker::StartPolling()
+	{
+		{
+			std::scoped_lock<SpinLock> lock(m_Lock);
+			if (ThreadsAreRunning() || !m_ThreadsTerminated)
+				return false;
+
+			m_Run = true;
+			m_ThreadsTerminated = false;
+		}
+
+		// Poll does nothing until the worker has been set up
+		const bool started = OnThreadsStarted();
+		m_IsPolling = true;
+
+		if (!started)
+			TerminateThreads();
+
+		return true;
+	}
+
+	void NetWorker::StopPolling()
+	{
+		if (m_IsPolling.exchange(false))
+			ThreadsDeleted();
+	}
+
+	bool NetWorker::IsPolling() const
+	{
+		return m_IsPolling;
 	}
 
 	bool NetWorker::StartThreads()
@@ -104,6 +146,8 @@ namespace LambdaEngine
 
 	void NetWorker::ThreadTransmitter()
 	{
+		PROFILE_THREAD("NetWorker Transmitter");
+
 		while (!m_ThreadsStarted);
 		if (!OnThreadsStarted())
 			TerminateThreads();
@@ -117,6 +161,8 @@ namespace LambdaEngine
 
 	void NetWorker::ThreadReceiver()
 	{
+		PROFILE_THREAD("NetWorker Receiver");
+
 		while (!m_Initiated);
 
 		RunReceiver();
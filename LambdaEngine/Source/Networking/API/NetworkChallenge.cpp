@@ -1,9 +1,77 @@
 #include "Networking/API/NetworkChallenge.h"
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/IPAddress.h"
+
+#include <random>
 
 namespace LambdaEngine
 {
+	static FORCEINLINE uint64 RotateLeft(uint64 value, uint32 bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static FORCEINLINE void SipRound(uint64& v0, uint64& v1, uint64& v2, uint64& v3)
+	{
+		v0 += v1; v1 = RotateLeft(v1, 13); v1 ^= v0; v0 = RotateLeft(v0, 32);
+		v2 += v3; v3 = RotateLeft(v3, 16); v3 ^= v2;
+		v0 += v3; v3 = RotateLeft(v3, 21); v3 ^= v0;
+		v2 += v1; v1 = RotateLeft(v1, 17); v1 ^= v2; v2 = RotateLeft(v2, 32);
+	}
+
 	uint64 NetworkChallenge::Compute(uint64 clientSalt, uint64 serverSalt)
 	{
-		return clientSalt & serverSalt;
+		static const uint64 key[2] = { 0x6c616d6264616e65ULL, 0x746368616c6c6e67ULL };
+		const uint64 words[2] = { clientSalt, serverSalt };
+		uint64 answer = SipHash(key, words, 2);
+		return answer != 0 ? answer : 1;
+	}
+
+	uint64 NetworkChallenge::ComputeCookie(const uint64 pKey[2], const IPEndPoint& ipEndPoint, uint64 clientSalt, uint64 timeWindow)
+	{
+		const uint64 words[4] = { ipEndPoint.GetAddress()->GetHash(), ipEndPoint.GetPort(), clientSalt, timeWindow };
+		uint64 cookie = SipHash(pKey, words, 4);
+		return cookie != 0 ? cookie : 1;
+	}
+
+	void NetworkChallenge::GenerateKey(uint64 pKey[2])
+	{
+		// std::random_device produces 32 bits per call
+		std::random_device device;
+		for (uint32 i = 0; i < 2; i++)
+		{
+			pKey[i] = (uint64(device()) << 32) | uint64(device());
+		}
+	}
+
+	/*
+	* SipHash-2-4 of count whole 64 bit words
+	*/
+	uint64 NetworkChallenge::SipHash(const uint64 pKey[2], const uint64* pWords, uint32 count)
+	{
+		uint64 v0 = 0x736f6d6570736575ULL ^ pKey[0];
+		uint64 v1 = 0x646f72616e646f6dULL ^ pKey[1];
+		uint64 v2 = 0x6c7967656e657261ULL ^ pKey[0];
+		uint64 v3 = 0x7465646279746573ULL ^ pKey[1];
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			v3 ^= pWords[i];
+			SipRound(v0, v1, v2, v3);
+			SipRound(v0, v1, v2, v3);
+			v0 ^= pWords[i];
+		}
+
+		const uint64 last = uint64(count * sizeof(uint64)) << 56;
+		v3 ^= last;
+		SipRound(v0, v1, v2, v3);
+		SipRound(v0, v1, v2, v3);
+		v0 ^= last;
+
+		v2 ^= 0xff;
+		for (uint32 i = 0; i < 4; i++)
+			SipRound(v0, v1, v2, v3);
+
+		return v0 ^ v1 ^ v2 ^ v3;
 	}
-}
\ No newline at end of file
+}
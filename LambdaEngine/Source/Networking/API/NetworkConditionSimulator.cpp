@@ -0,0 +1,164 @@
+#include "Networking/API/NetworkConditionSimulator.h"
+
+namespace LambdaEngine
+{
+	constexpr const uint64 NANOSECONDS_PER_MILLISECOND = 1000 * 1000;
+
+	NetworkConditionSimulator::NetworkConditionSimulator() :
+		m_Generator(std::random_device()()),
+		m_DroppedDatagrams(0)
+	{
+	}
+
+	void NetworkConditionSimulator::SetConditions(const NetworkConditions& conditions)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Conditions = conditions;
+		m_Generator.seed(conditions.Seed != 0 ? conditions.Seed : std::random_device()());
+
+		for (auto& link : m_Links)
+		{
+			link.second.InBurst = false;
+		}
+	}
+
+	NetworkConditions NetworkConditionSimulator::GetConditions() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_Conditions;
+	}
+
+	bool NetworkConditionSimulator::IsEnabled() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_Conditions.IsEnabled() || !m_Queue.empty();
+	}
+
+	void NetworkConditionSimulator::Submit(const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint, Timestamp timestamp)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		Link& link = m_Links[ipEndPoint];
+		if (ShouldDrop(link))
+		{
+			m_DroppedDatagrams++;
+			return;
+		}
+
+		const uint64 now = timestamp.AsNanoSeconds();
+		uint64 departureTime = now;
+
+		// The bottleneck sends one datagram at a time, a datagram waits until the ones before it have been serialized
+		if (m_Conditions.BandwidthKbps > 0)
+		{
+			const uint64 startTime		= std::max(now, link.LinkFreeTime);
+			const uint64 backlogBytes	= (startTime - now) * m_Conditions.BandwidthKbps / (8 * NANOSECONDS_PER_MILLISECOND);
+			if (backlogBytes + uint64(bytes) > m_Conditions.QueueLimitBytes)
+			{
+				m_DroppedDatagrams++;
+				return;
+			}
+
+			link.LinkFreeTime	= startTime + uint64(bytes) * 8 * NANOSECONDS_PER_MILLISECOND / m_Conditions.BandwidthKbps;
+			departureTime		= link.LinkFreeTime;
+		}
+
+		const float32 delayMS = m_Conditions.LatencyMS + Random01() * m_Conditions.JitterMS;
+		uint64 deliveryTime = departureTime + uint64(delayMS * float32(NANOSECONDS_PER_MILLISECOND));
+
+		if (m_Conditions.ReorderRatio > 0.0f && Random01() < m_Conditions.ReorderRatio)
+		{
+			deliveryTime += uint64(m_Conditions.ReorderDelayMS * float32(NANOSECONDS_PER_MILLISECOND));
+		}
+		else
+		{
+			// Jitter alone does not reorder, a datagram is never delivered before the one sent before it
+			deliveryTime			= std::max(deliveryTime, link.LastDeliveryTime);
+			link.LastDeliveryTime	= deliveryTime;
+		}
+
+		Enqueue(deliveryTime, pBuffer, bytes, ipEndPoint);
+
+		if (m_Conditions.DuplicationRatio > 0.0f && Random01() < m_Conditions.DuplicationRatio)
+		{
+			Enqueue(deliveryTime, pBuffer, bytes, ipEndPoint);
+		}
+	}
+
+	void NetworkConditionSimulator::Flush(Timestamp timestamp, const SendDatagramFunc& sendFunc)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		const uint64 now = timestamp.AsNanoSeconds();
+		auto iterator = m_Queue.begin();
+		while (iterator != m_Queue.end() && iterator->first <= now)
+		{
+			const DelayedDatagram& datagram = iterator->second;
+			sendFunc(datagram.Data.GetData(), int32(datagram.Data.GetSize()), datagram.EndPoint);
+			iterator = m_Queue.erase(iterator);
+		}
+	}
+
+	bool NetworkConditionSimulator::GetNextDeliveryTime(Timestamp& timestamp) const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		if (m_Queue.empty())
+			return false;
+
+		timestamp = Timestamp(m_Queue.begin()->first);
+		return true;
+	}
+
+	void NetworkConditionSimulator::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Queue.clear();
+		m_Links.clear();
+	}
+
+	void NetworkConditionSimulator::RemoveLink(const IPEndPoint& ipEndPoint)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Links.erase(ipEndPoint);
+	}
+
+	uint64 NetworkConditionSimulator::GetDroppedDatagrams() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_DroppedDatagrams;
+	}
+
+	/*
+	* Gilbert-Elliott model, a two state Markov chain where the bad state represents a burst of loss
+	*/
+	bool NetworkConditionSimulator::ShouldDrop(Link& link)
+	{
+		if (link.InBurst)
+		{
+			if (Random01() < m_Conditions.BurstExitRatio)
+			{
+				link.InBurst = false;
+			}
+		}
+		else if (m_Conditions.BurstEnterRatio > 0.0f && Random01() < m_Conditions.BurstEnterRatio)
+		{
+			link.InBurst = true;
+		}
+
+		const float32 lossRatio = link.InBurst ? m_Conditions.BurstLossRatio : m_Conditions.LossRatio;
+		return lossRatio > 0.0f && Random01() < lossRatio;
+	}
+
+	float32 NetworkConditionSimulator::Random01()
+	{
+		return std::uniform_real_distribution<float32>(0.0f, 1.0f)(m_Generator);
+	}
+
+	void NetworkConditionSimulator::Enqueue(uint64 deliveryTime, const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint)
+	{
+		// Entries with the same delivery time stay in the order they were inserted
+		auto iterator = m_Queue.insert({ deliveryTime, DelayedDatagram() });
+		iterator->second.EndPoint = ipEndPoint;
+		iterator->second.Data.Assign(pBuffer, pBuffer + bytes);
+	}
+}
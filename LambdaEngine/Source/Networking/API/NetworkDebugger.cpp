@@ -16,6 +16,7 @@ namespace LambdaEngine
 		PacketManager* pManager = pClient->GetPacketManager();
 		PacketPool* pPacketPool = pManager->GetPacketPool();
 		const NetworkStatistics* pStatistics = pManager->GetStatistics();
+		const CongestionController* pCongestionController = pManager->GetCongestionController();
 
 		ImGui::SetNextWindowSize(ImVec2(430, 450), ImGuiCond_FirstUseEver);
 		if (ImGui::Begin("Network Statistics", NULL))
@@ -27,9 +28,14 @@ namespace LambdaEngine
 			ImGui::Text("Messages Received      %d", pStatistics->GetMessagesReceived());
 			ImGui::Text("Packets Lost           %d", pStatistics->GetPacketsLost());
 			ImGui::Text("Packet Loss Rate       %.1f%%", pStatistics->GetPacketLossRate() * 100.0f);
+			ImGui::Text("Incoming Packets Lost  %d", pStatistics->GetIncomingPacketsLost());
 			ImGui::Text("Bytes Sent             %d", pStatistics->GetBytesSent());
 			ImGui::Text("Bytes Received         %d", pStatistics->GetBytesReceived());
 			ImGui::Text("Ping                   %.1f ms", pStatistics->GetPing().AsMilliSeconds());
+			ImGui::Text("RTT Variance           %.1f ms", pStatistics->GetRTTVariance().AsMilliSeconds());
+			ImGui::Text("Retransmission Timeout %.1f ms", pStatistics->GetRetransmissionTimeout().AsMilliSeconds());
+			ImGui::Text("Send Rate              %.1f KiB/s", pCongestionController->GetSendRate() / 1024.0f);
+			ImGui::Text("Estimated Bandwidth    %.1f KiB/s", pCongestionController->GetEstimatedBandwidth() / 1024.0f);
 			ImGui::Text("Local Salt             %lu", pStatistics->GetSalt());
 			ImGui::Text("Remote Salt            %lu", pStatistics->GetRemoteSalt());
 			ImGui::Text("Last Packet Sent       %d s", (int32)(EngineLoop::GetTimeSinceStart() - pStatistics->GetTimestapLastSent()).AsSeconds());
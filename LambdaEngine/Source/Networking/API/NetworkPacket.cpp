@@ -84,6 +84,17 @@ namespace LambdaEngine
 		return m_Header.ReliableUID;
 	}
 
+	NetworkPacket* NetworkPacket::SetChannel(uint8 channel)
+	{
+		m_Header.Channel = channel < MAXIMUM_NETWORK_CHANNELS ? channel : 0;
+		return this;
+	}
+
+	uint8 NetworkPacket::GetChannel() const
+	{
+		return m_Header.Channel;
+	}
+
 	std::string NetworkPacket::ToString() const
 	{
 		std::string type;
@@ -105,6 +116,7 @@ namespace LambdaEngine
 		case TYPE_ACCEPTED:				str = "TYPE_ACCEPTED";  break;
 		case TYPE_NETWORK_ACK:			str = "TYPE_NETWORK_ACK";  break;
 		case TYPE_NETWORK_DISCOVERY:	str = "TYPE_NETWORK_DISCOVERY";  break;
+		case TYPE_FRAGMENT:				str = "TYPE_FRAGMENT";  break;
 		default:						str = "USER_PACKET(" + std::to_string(type) + ")"; break;
 		}
 	}
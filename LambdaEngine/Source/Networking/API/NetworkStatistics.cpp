@@ -48,7 +48,12 @@ namespace LambdaEngine
 
 	float64 NetworkStatistics::GetPacketLossRate() const
 	{
-		return m_PacketsLost / (float64)m_PacketsSent;
+		return m_PacketsSent > 0 ? m_PacketsLost / (float64)m_PacketsSent : 0.0;
+	}
+
+	uint32 NetworkStatistics::GetIncomingPacketsLost() const
+	{
+		return m_IncomingPacketsLost;
 	}
 
 	uint32 NetworkStatistics::GetBytesSent() const
@@ -66,6 +71,16 @@ namespace LambdaEngine
 		return m_Ping;
 	}
 
+	const Timestamp& NetworkStatistics::GetRTTVariance() const
+	{
+		return m_RTTVariance;
+	}
+
+	const Timestamp& NetworkStatistics::GetRetransmissionTimeout() const
+	{
+		return m_RetransmissionTimeout;
+	}
+
 	uint64 NetworkStatistics::GetSalt() const
 	{
 		return m_Salt;
@@ -116,12 +131,16 @@ namespace LambdaEngine
 		m_Salt						= Random::UInt64();
 		m_SaltRemote				= 0;
 		m_Ping						= Timestamp::MilliSeconds(10.0f);
+		m_RTTVariance				= 0;
+		m_RetransmissionTimeout		= Timestamp::MilliSeconds(100.0f);
+		m_HasRTTSample				= false;
 		m_PacketsSent				= 0;
 		m_MessagesSent				= 0;
 		m_ReliableMessagesSent		= 0;
 		m_PacketsReceived			= 0;
 		m_MessagesReceived			= 0;
 		m_PacketsLost				= 0;
+		m_IncomingPacketsLost		= 0;
 		m_BytesSent					= 0;
 		m_BytesReceived				= 0;
 		m_LastReceivedSequenceNr	= 0;
@@ -162,9 +181,14 @@ namespace LambdaEngine
 		m_LastReceivedReliableUID++;
 	}
 
-	void NetworkStatistics::RegisterPacketLoss()
+	void NetworkStatistics::RegisterPacketsLost(uint32 packets)
+	{
+		m_PacketsLost += packets;
+	}
+
+	void NetworkStatistics::RegisterIncomingPacketsLost(uint32 packets)
 	{
-		m_PacketsLost++;
+		m_IncomingPacketsLost += packets;
 	}
 
 	void NetworkStatistics::RegisterBytesSent(uint32 bytes)
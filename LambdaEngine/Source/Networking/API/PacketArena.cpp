@@ -0,0 +1,97 @@
+#include "Networking/API/PacketArena.h"
+#include "Networking/API/NetworkPacket.h"
+
+#include "Log/Log.h"
+#include "Log/BinaryLog.h"
+
+#include "Metrics/MetricsRegistry.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	PacketArena::PacketArena(uint32 maxPackets, uint16 chunkSize) :
+		m_MaxPackets(maxPackets),
+		m_AllocatedPackets(0),
+		m_ChunkSize(std::max<uint16>(chunkSize, 1))
+	{
+		m_pPacketsGauge = MetricsRegistry::RegisterGauge("lambda_packet_pool_packets", "Number of packets allocated by all packet pools");
+	}
+
+	PacketArena::~PacketArena()
+	{
+		if (m_PacketsFree.GetSize() != m_AllocatedPackets)
+		{
+			LOG_ERROR("[PacketArena]: %u packets were never returned", m_AllocatedPackets - m_PacketsFree.GetSize());
+		}
+
+		m_pPacketsGauge->Add(-float64(m_AllocatedPackets));
+
+		for (NetworkPacket* pChunk : m_Chunks)
+			delete[] pChunk;
+
+		m_Chunks.Clear();
+		m_PacketsFree.Clear();
+	}
+
+	uint32 PacketArena::RequestPackets(uint32 nrOfPackets, TArray<NetworkPacket*>& packetsReturned)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		while (m_PacketsFree.GetSize() < nrOfPackets && AllocateChunk());
+
+		uint32 count = std::min<uint32>(nrOfPackets, m_PacketsFree.GetSize());
+		uint32 first = m_PacketsFree.GetSize() - count;
+
+		for (uint32 i = first; i < m_PacketsFree.GetSize(); i++)
+			packetsReturned.PushBack(m_PacketsFree[i]);
+
+		m_PacketsFree.Resize(first);
+		return count;
+	}
+
+	void PacketArena::FreePackets(NetworkPacket* const* ppPackets, uint32 nrOfPackets)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		for (uint32 i = 0; i < nrOfPackets; i++)
+			m_PacketsFree.PushBack(ppPackets[i]);
+	}
+
+	uint32 PacketArena::GetMaxPackets() const
+	{
+		return m_MaxPackets;
+	}
+
+	uint32 PacketArena::GetAllocatedPackets() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_AllocatedPackets;
+	}
+
+	uint32 PacketArena::GetFreePackets() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return m_PacketsFree.GetSize();
+	}
+
+	bool PacketArena::AllocateChunk()
+	{
+		uint32 count = std::min<uint32>(m_ChunkSize, m_MaxPackets - m_AllocatedPackets);
+		if (count == 0)
+		{
+			LOG_BINARY_RATE(ELogSeverity::LOG_ERROR, 1, "[PacketArena]: All %u packets are in use", m_MaxPackets);
+			return false;
+		}
+
+		NetworkPacket* pChunk = DBG_NEW NetworkPacket[count];
+		m_Chunks.PushBack(pChunk);
+
+		for (uint32 i = 0; i < count; i++)
+			m_PacketsFree.PushBack(&pChunk[i]);
+
+		m_AllocatedPackets += count;
+		m_pPacketsGauge->Add(float64(count));
+		return true;
+	}
+}
@@ -0,0 +1,434 @@
+#include "Networking/API/PacketCompressor.h"
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <vector>
+#include <string.h>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 LZ_MIN_MATCH			= 4;
+	constexpr const uint32 LZ_HASH_BITS			= 10;
+	constexpr const uint32 LZ_MAX_OFFSET		= UINT16_MAX;
+	constexpr const uint32 HUFFMAN_MAX_LENGTH	= 11;
+
+	/*
+	* Codes are stored bit reversed since the bit stream is written from the least significant bit
+	*/
+	struct HuffmanCode
+	{
+		uint16 Codes[256];
+		uint8 Lengths[256];
+		uint16 DecodeTable[1 << HUFFMAN_MAX_LENGTH];	// Symbol in the low byte, code length in the high byte
+		uint8 ID;										// Hash of the code lengths, written first in every Huffman payload
+	};
+
+	static void BuildHuffmanCode(const uint32 pFrequencies[256], HuffmanCode& code)
+	{
+		// Every value gets a code so that any datagram can be encoded
+		uint64 frequencies[256];
+		for (uint32 i = 0; i < 256; i++)
+			frequencies[i] = uint64(pFrequencies[i]) + 1;
+
+		uint8 lengths[256];
+		for (;;)
+		{
+			struct Node
+			{
+				uint64 Frequency;
+				int32 Parent;
+			};
+
+			Node nodes[511];
+			using Entry = std::pair<uint64, int32>;
+			std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+			for (int32 i = 0; i < 256; i++)
+			{
+				nodes[i] = { frequencies[i], -1 };
+				queue.push({ frequencies[i], i });
+			}
+
+			int32 nodeCount = 256;
+			while (queue.size() > 1)
+			{
+				Entry first = queue.top();
+				queue.pop();
+				Entry second = queue.top();
+				queue.pop();
+
+				nodes[nodeCount] = { first.first + second.first, -1 };
+				nodes[first.second].Parent	= nodeCount;
+				nodes[second.second].Parent	= nodeCount;
+				queue.push({ nodes[nodeCount].Frequency, nodeCount });
+				nodeCount++;
+			}
+
+			uint32 maxLength = 0;
+			for (int32 i = 0; i < 256; i++)
+			{
+				uint32 length = 0;
+				for (int32 node = i; nodes[node].Parent != -1; node = nodes[node].Parent)
+					length++;
+
+				lengths[i] = uint8(length);
+				maxLength = std::max(maxLength, length);
+			}
+
+			if (maxLength <= HUFFMAN_MAX_LENGTH)
+				break;
+
+			// Flattening the distribution shortens the longest codes, with all frequencies equal every code is 8 bits
+			for (uint32 i = 0; i < 256; i++)
+				frequencies[i] = (frequencies[i] >> 1) + 1;
+		}
+
+		// Canonical codes, ordered by length and then by value
+		uint8 symbols[256];
+		for (uint32 i = 0; i < 256; i++)
+			symbols[i] = uint8(i);
+
+		std::sort(symbols, symbols + 256, [&](uint8 first, uint8 second)
+		{
+			return lengths[first] != lengths[second] ? lengths[first] < lengths[second] : first < second;
+		});
+
+		uint32 nextCode = 0;
+		uint32 previousLength = lengths[symbols[0]];
+		for (uint32 i = 0; i < 256; i++)
+		{
+			const uint8 symbol = symbols[i];
+			const uint32 length = lengths[symbol];
+			nextCode <<= (length - previousLength);
+			previousLength = length;
+
+			uint32 reversed = 0;
+			for (uint32 bit = 0; bit < length; bit++)
+				reversed |= ((nextCode >> bit) & 1) << (length - 1 - bit);
+
+			code.Codes[symbol]		= uint16(reversed);
+			code.Lengths[symbol]	= uint8(length);
+			nextCode++;
+
+			for (uint32 index = reversed; index < (1u << HUFFMAN_MAX_LENGTH); index += (1u << length))
+				code.DecodeTable[index] = uint16(symbol | (length << 8));
+		}
+
+		// Canonical codes are defined by their lengths, so peers with the same lengths get the same ID
+		uint32 hash = 2166136261u;
+		for (uint32 i = 0; i < 256; i++)
+			hash = (hash ^ code.Lengths[i]) * 16777619u;
+
+		code.ID = uint8(hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24));
+	}
+
+	static std::shared_ptr<const HuffmanCode> CreateDefaultHuffmanCode()
+	{
+		uint32 frequencies[256];
+		for (uint32 i = 0; i < 256; i++)
+			frequencies[i] = i < 16 ? 64 : 8;
+
+		frequencies[0x00] = 2048;
+		frequencies[0xFF] = 64;
+
+		// Exponent bytes of floats around 1.0 and of small negative values
+		frequencies[0x3F] = 64;
+		frequencies[0x40] = 64;
+		frequencies[0x41] = 32;
+		frequencies[0x42] = 32;
+		frequencies[0xBF] = 32;
+		frequencies[0xC0] = 32;
+
+		std::shared_ptr<HuffmanCode> pCode = std::make_shared<HuffmanCode>();
+		BuildHuffmanCode(frequencies, *pCode);
+		return pCode;
+	}
+
+	// Replaced as a whole by SetHuffmanFrequencies, datagrams that are being coded keep the code they started with
+	static std::shared_ptr<const HuffmanCode> g_pHuffmanCode = CreateDefaultHuffmanCode();
+
+	uint16 PacketCompressor::Compress(ECompressionMode mode, const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize)
+	{
+		// Nothing is gained from compressing data that is already larger than the destination
+		destinationSize = std::min<uint16>(destinationSize, sourceSize > 0 ? sourceSize - 1 : 0);
+
+		if (mode == COMPRESSION_MODE_LZ)
+			return CompressLZ((const uint8*)pSource, sourceSize, (uint8*)pDestination, destinationSize);
+		else if (mode == COMPRESSION_MODE_HUFFMAN)
+			return CompressHuffman((const uint8*)pSource, sourceSize, (uint8*)pDestination, destinationSize);
+
+		return 0;
+	}
+
+	bool PacketCompressor::Decompress(ECompressionMode mode, const char* pSource, uint16 sourceSize, char* pDestination, uint16 decompressedSize)
+	{
+		if (mode == COMPRESSION_MODE_LZ)
+			return DecompressLZ((const uint8*)pSource, sourceSize, (uint8*)pDestination, decompressedSize);
+		else if (mode == COMPRESSION_MODE_HUFFMAN)
+			return DecompressHuffman((const uint8*)pSource, sourceSize, (uint8*)pDestination, decompressedSize);
+
+		return false;
+	}
+
+	void PacketCompressor::SetHuffmanFrequencies(const uint32 pFrequencies[256])
+	{
+		std::shared_ptr<HuffmanCode> pCode = std::make_shared<HuffmanCode>();
+		BuildHuffmanCode(pFrequencies, *pCode);
+		std::atomic_store(&g_pHuffmanCode, std::shared_ptr<const HuffmanCode>(std::move(pCode)));
+	}
+
+	void PacketCompressor::CountFrequencies(const char* pData, uint32 size, uint32 pFrequencies[256])
+	{
+		for (uint32 i = 0; i < size; i++)
+			pFrequencies[uint8(pData[i])]++;
+	}
+
+	static FORCEINLINE uint32 Read32(const uint8* pData)
+	{
+		uint32 value;
+		memcpy(&value, pData, sizeof(value));
+		return value;
+	}
+
+	static FORCEINLINE uint32 HashLZ(uint32 value)
+	{
+		return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+	}
+
+	static FORCEINLINE bool WriteLengthLZ(uint32 length, uint8*& pDestination, const uint8* pEnd)
+	{
+		while (length >= 255)
+		{
+			if (pDestination >= pEnd)
+				return false;
+
+			*pDestination++ = 255;
+			length -= 255;
+		}
+
+		if (pDestination >= pEnd)
+			return false;
+
+		*pDestination++ = uint8(length);
+		return true;
+	}
+
+	static FORCEINLINE bool ReadLengthLZ(uint32& length, const uint8*& pSource, const uint8* pEnd)
+	{
+		uint8 value;
+		do
+		{
+			if (pSource >= pEnd)
+				return false;
+
+			value = *pSource++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+	/*
+	* A sequence is a token with the literal length in the high nibble and the match length minus LZ_MIN_MATCH in the
+	* low nibble, a nibble of 15 is continued in extra bytes. The token is followed by the literals, a 16 bit offset and
+	* the extra match length bytes. The last sequence has no match
+	*/
+	static bool WriteSequenceLZ(const uint8* pLiterals, uint32 literalLength, uint32 offset, uint32 matchLength, uint8*& pDestination, const uint8* pEnd)
+	{
+		if (pDestination >= pEnd)
+			return false;
+
+		const uint32 matchNibble = matchLength > 0 ? matchLength - LZ_MIN_MATCH : 0;
+		uint8* pToken = pDestination++;
+		*pToken = uint8((std::min(literalLength, 15u) << 4) | std::min(matchNibble, 15u));
+
+		if (literalLength >= 15 && !WriteLengthLZ(literalLength - 15, pDestination, pEnd))
+			return false;
+
+		if (pDestination + literalLength > pEnd)
+			return false;
+
+		memcpy(pDestination, pLiterals, literalLength);
+		pDestination += literalLength;
+
+		if (matchLength == 0)
+			return true;
+
+		if (pDestination + 2 > pEnd)
+			return false;
+
+		*pDestination++ = uint8(offset);
+		*pDestination++ = uint8(offset >> 8);
+
+		return matchNibble < 15 || WriteLengthLZ(matchNibble - 15, pDestination, pEnd);
+	}
+
+	uint16 PacketCompressor::CompressLZ(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 destinationSize)
+	{
+		// Positions are stored plus one so that zero means empty
+		uint32 hashTable[1 << LZ_HASH_BITS] = { };
+
+		uint8* pOutput = pDestination;
+		const uint8* pEnd = pDestination + destinationSize;
+
+		uint32 anchor = 0;
+		uint32 position = 0;
+		while (position + LZ_MIN_MATCH <= sourceSize)
+		{
+			const uint32 value = Read32(pSource + position);
+			const uint32 hash = HashLZ(value);
+			const uint32 candidate = hashTable[hash];
+			hashTable[hash] = position + 1;
+
+			if (candidate == 0 || position - (candidate - 1) > LZ_MAX_OFFSET || Read32(pSource + candidate - 1) != value)
+			{
+				position++;
+				continue;
+			}
+
+			const uint32 matchPosition = candidate - 1;
+			uint32 matchLength = LZ_MIN_MATCH;
+			while (position + matchLength < sourceSize && pSource[matchPosition + matchLength] == pSource[position + matchLength])
+				matchLength++;
+
+			if (!WriteSequenceLZ(pSource + anchor, position - anchor, position - matchPosition, matchLength, pOutput, pEnd))
+				return 0;
+
+			position += matchLength;
+			anchor = position;
+		}
+
+		if (anchor < sourceSize && !WriteSequenceLZ(pSource + anchor, sourceSize - anchor, 0, 0, pOutput, pEnd))
+			return 0;
+
+		return uint16(pOutput - pDestination);
+	}
+
+	bool PacketCompressor::DecompressLZ(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 decompressedSize)
+	{
+		const uint8* pInput = pSource;
+		const uint8* pInputEnd = pSource + sourceSize;
+		uint32 written = 0;
+
+		while (pInput < pInputEnd)
+		{
+			const uint8 token = *pInput++;
+
+			uint32 literalLength = token >> 4;
+			if (literalLength == 15 && !ReadLengthLZ(literalLength, pInput, pInputEnd))
+				return false;
+
+			if (literalLength > uint32(pInputEnd - pInput) || written + literalLength > decompressedSize)
+				return false;
+
+			memcpy(pDestination + written, pInput, literalLength);
+			pInput += literalLength;
+			written += literalLength;
+
+			if (pInput == pInputEnd)
+				break;
+
+			if (pInputEnd - pInput < 2)
+				return false;
+
+			const uint32 offset = uint32(pInput[0]) | (uint32(pInput[1]) << 8);
+			pInput += 2;
+
+			uint32 matchLength = token & 0x0F;
+			if (matchLength == 15 && !ReadLengthLZ(matchLength, pInput, pInputEnd))
+				return false;
+
+			matchLength += LZ_MIN_MATCH;
+			if (offset == 0 || offset > written || written + matchLength > decompressedSize)
+				return false;
+
+			// Byte by byte since the match may overlap the bytes it produces
+			const uint8* pMatch = pDestination + written - offset;
+			for (uint32 i = 0; i < matchLength; i++)
+				pDestination[written + i] = pMatch[i];
+
+			written += matchLength;
+		}
+
+		return written == decompressedSize;
+	}
+
+	uint16 PacketCompressor::CompressHuffman(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 destinationSize)
+	{
+		const std::shared_ptr<const HuffmanCode> pCode = std::atomic_load(&g_pHuffmanCode);
+		const HuffmanCode& code = *pCode;
+
+		if (destinationSize == 0)
+			return 0;
+
+		// The ID lets the receiver reject datagrams coded with another code instead of decoding garbage
+		pDestination[0] = code.ID;
+
+		uint64 bits = 0;
+		uint32 bitCount = 0;
+		uint32 written = 1;
+
+		for (uint32 i = 0; i < sourceSize; i++)
+		{
+			const uint8 symbol = pSource[i];
+			bits |= uint64(code.Codes[symbol]) << bitCount;
+			bitCount += code.Lengths[symbol];
+
+			while (bitCount >= 8)
+			{
+				if (written >= destinationSize)
+					return 0;
+
+				pDestination[written++] = uint8(bits);
+				bits >>= 8;
+				bitCount -= 8;
+			}
+		}
+
+		if (bitCount > 0)
+		{
+			if (written >= destinationSize)
+				return 0;
+
+			pDestination[written++] = uint8(bits);
+		}
+
+		return uint16(written);
+	}
+
+	bool PacketCompressor::DecompressHuffman(const uint8* pSource, uint16 sourceSize, uint8* pDestination, uint16 decompressedSize)
+	{
+		const std::shared_ptr<const HuffmanCode> pCode = std::atomic_load(&g_pHuffmanCode);
+		const HuffmanCode& code = *pCode;
+		constexpr const uint64 MASK = (1 << HUFFMAN_MAX_LENGTH) - 1;
+
+		if (sourceSize == 0 || pSource[0] != code.ID)
+			return false;
+
+		uint64 bits = 0;
+		uint32 bitCount = 0;
+		uint32 read = 1;
+
+		for (uint32 i = 0; i < decompressedSize; i++)
+		{
+			while (bitCount <= 56 && read < sourceSize)
+			{
+				bits |= uint64(pSource[read++]) << bitCount;
+				bitCount += 8;
+			}
+
+			const uint16 entry = code.DecodeTable[bits & MASK];
+			const uint32 length = entry >> 8;
+			if (length > bitCount)
+				return false;
+
+			pDestination[i] = uint8(entry);
+			bits >>= length;
+			bitCount -= length;
+		}
+
+		// Only the padding of the last byte may be left
+		return read == sourceSize && bitCount < 8;
+	}
+}
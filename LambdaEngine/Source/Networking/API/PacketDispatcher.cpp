@@ -0,0 +1,39 @@
+#include "Networking/API/PacketDispatcher.h"
+#include "Networking/API/NetworkPacket.h"
+
+#include "Log/Log.h"
+
+namespace LambdaEngine
+{
+	bool PacketDispatcher::RegisterFunc(uint16 packetType, void* pContext, DispatchFunc func)
+	{
+		if (packetType >= MAXIMUM_DISPATCH_TYPES)
+		{
+			LOG_ERROR("[PacketDispatcher]: Packet type %u is out of range, the maximum is %u", packetType, MAXIMUM_DISPATCH_TYPES - 1);
+			return false;
+		}
+
+		if (m_Entries[packetType].Func)
+			LOG_WARNING("[PacketDispatcher]: Replacing the handler of packet type %u", packetType);
+
+		m_Entries[packetType].Func		= func;
+		m_Entries[packetType].pContext	= pContext;
+		return true;
+	}
+
+	void PacketDispatcher::Unregister(uint16 packetType)
+	{
+		if (packetType < MAXIMUM_DISPATCH_TYPES)
+			m_Entries[packetType] = Entry();
+	}
+
+	bool PacketDispatcher::Dispatch(IClientUDP* pClient, NetworkPacket* pPacket) const
+	{
+		const uint16 packetType = pPacket->GetType();
+		if (packetType >= MAXIMUM_DISPATCH_TYPES)
+			return false;
+
+		const Entry& entry = m_Entries[packetType];
+		return entry.Func ? entry.Func(entry.pContext, pClient, pPacket) : false;
+	}
+}
@@ -6,13 +6,53 @@
 
 #include "Engine/EngineLoop.h"
 
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+
 namespace LambdaEngine
 {
-	PacketManager::PacketManager(uint16 poolSize, int32 maxRetries, float32 resendRTTMultiplier) :
+	static const Timestamp CLOCK_GRANULARITY	= Timestamp::MilliSeconds(5);
+	static const Timestamp MIN_RTO				= Timestamp::MilliSeconds(20);
+	static const Timestamp MAX_RTO				= Timestamp::Seconds(2);
+
+	/*
+	* Acks and the handshake are small and the remote is waiting for them, so they are not held back by the pacer
+	*/
+	static bool IsControlPacket(const NetworkPacket* pPacket)
+	{
+		switch (pPacket->GetType())
+		{
+		case NetworkPacket::TYPE_NETWORK_ACK:
+		case NetworkPacket::TYPE_CONNNECT:
+		case NetworkPacket::TYPE_CHALLENGE:
+		case NetworkPacket::TYPE_ACCEPTED:
+		case NetworkPacket::TYPE_SERVER_FULL:
+		case NetworkPacket::TYPE_SERVER_NOT_ACCEPTING:
+			return !pPacket->IsReliable();
+		default:
+			return false;
+		}
+	}
+
+	PacketManager::PacketManager(uint16 poolSize, int32 maxRetries) :
 		m_PacketPool(poolSize),
+		m_PacedBytes(0),
+		m_SentDatagrams(),
 		m_QueueIndex(0),
 		m_MaxRetries(maxRetries),
-		m_ResendRTTMultiplier(resendRTTMultiplier)
+		m_CompressionMode(COMPRESSION_MODE_NONE)
+	{
+
+	}
+
+	PacketManager::PacketManager(PacketArena* pArena, uint16 packetQuota, int32 maxRetries) :
+		m_PacketPool(pArena, packetQuota),
+		m_PacedBytes(0),
+		m_SentDatagrams(),
+		m_QueueIndex(0),
+		m_MaxRetries(maxRetries),
+		m_CompressionMode(COMPRESSION_MODE_NONE)
 	{
 
 	}
@@ -25,8 +65,14 @@ namespace LambdaEngine
 	uint32 PacketManager::EnqueuePacketReliable(NetworkPacket* pPacket, IPacketListener* pListener)
 	{
 		std::scoped_lock<SpinLock> lock(m_LockMessagesToSend);
-		uint32 UID = EnqueuePacket(pPacket, m_Statistics.RegisterReliableMessageSent());
-		m_MessagesWaitingForAck.insert({ UID, MessageInfo{ pPacket, pListener, EngineLoop::GetTimeSinceStart()} });
+		uint32 reliableUID = m_Statistics.RegisterReliableMessageSent();
+		uint32 UID = EnqueuePacket(pPacket, reliableUID);
+
+		MessageInfo messageInfo = { pPacket, pListener, EngineLoop::GetPreciseTimeSinceStart(), m_Statistics.GetRetransmissionTimeout() };
+		messageInfo.IsQueued = true;
+
+		// Bundles refer to their messages by reliable UID
+		m_MessagesWaitingForAck.insert({ reliableUID, messageInfo });
 		return UID;
 	}
 
@@ -38,6 +84,26 @@ namespace LambdaEngine
 
 	uint32 PacketManager::EnqueuePacket(NetworkPacket* pPacket, uint32 reliableUID)
 	{
+		NetworkPacket::Header& header = pPacket->GetHeader();
+		SendChannel& channel = m_SendChannels[header.Channel < MAXIMUM_NETWORK_CHANNELS ? header.Channel : 0];
+
+		// Reliability is chosen by the caller, the channel decides the ordering
+		if (reliableUID != 0)
+		{
+			header.ChannelType		= channel.Type == CHANNEL_TYPE_RELIABLE_UNORDERED ? CHANNEL_TYPE_RELIABLE_UNORDERED : CHANNEL_TYPE_RELIABLE_ORDERED;
+			header.ChannelSequence	= ++channel.ReliableSequence;
+		}
+		else if (channel.Type == CHANNEL_TYPE_UNRELIABLE_SEQUENCED)
+		{
+			header.ChannelType		= CHANNEL_TYPE_UNRELIABLE_SEQUENCED;
+			header.ChannelSequence	= ++channel.UnreliableSequence;
+		}
+		else
+		{
+			header.ChannelType		= CHANNEL_TYPE_UNRELIABLE;
+			header.ChannelSequence	= 0;
+		}
+
 		pPacket->GetHeader().UID = m_Statistics.RegisterMessageSent();
 		pPacket->GetHeader().ReliableUID = reliableUID;
 		m_MessagesToSend[m_QueueIndex].push(pPacket);
@@ -46,22 +112,97 @@ namespace LambdaEngine
 
 	void PacketManager::Flush(PacketTransceiver* pTransceiver)
 	{
+		PROFILE_FUNCTION();
+
 		int32 indexToUse = m_QueueIndex;
 		m_QueueIndex = (m_QueueIndex + 1) % 2;
 		std::queue<NetworkPacket*>& packets = m_MessagesToSend[indexToUse];
 
-		Timestamp timestamp = EngineLoop::GetTimeSinceStart();
-
+		// Messages held back by the pacer last flush are sent before the new ones
 		while (!packets.empty())
 		{
-			Bundle bundle;
-			uint32 bundleUID = pTransceiver->Transmit(&m_PacketPool, packets, bundle.ReliableUIDs, m_IPEndPoint, &m_Statistics);
+			NetworkPacket* pPacket = packets.front();
+			if (IsControlPacket(pPacket))
+			{
+				m_ControlMessages.push(pPacket);
+			}
+			else
+			{
+				m_PacedBytes += pPacket->GetTotalSize();
+				m_PacedMessages.push(pPacket);
+			}
+			packets.pop();
+		}
+
+		if (m_PacedBytes > m_CongestionController.GetMaxQueuedBytes())
+			DropQueuedUnreliablePackets();
+
+		// RTT samples and retransmission timeouts are measured against this, the frame clock would add up to a frame of error
+		Timestamp timestamp = EngineLoop::GetPreciseTimeSinceStart();
+
+		// Control messages bypass the pacer but are still counted against its budget
+		while (!m_ControlMessages.empty())
+		{
+			TransmitBundle(pTransceiver, m_ControlMessages, timestamp);
+		}
+
+		while (!m_PacedMessages.empty() && m_CongestionController.CanSend(timestamp))
+		{
+			uint32 bytesSent = m_Statistics.GetBytesSent();
+			TransmitBundle(pTransceiver, m_PacedMessages, timestamp);
+			bytesSent = m_Statistics.GetBytesSent() - bytesSent;
+
+			m_PacedBytes = m_PacedMessages.empty() || bytesSent > m_PacedBytes ? 0 : m_PacedBytes - bytesSent;
+		}
+	}
+
+	void PacketManager::TransmitBundle(PacketTransceiver* pTransceiver, std::queue<NetworkPacket*>& packets, Timestamp timestamp)
+	{
+		Bundle bundle;
+		uint32 bytesSent = m_Statistics.GetBytesSent();
+		uint32 bundleUID = pTransceiver->Transmit(&m_PacketPool, packets, bundle.ReliableUIDs, m_IPEndPoint, &m_Statistics, m_CompressionMode);
+		bytesSent = m_Statistics.GetBytesSent() - bytesSent;
+
+		m_CongestionController.OnSent(bytesSent);
+
+		// The pacer may have held the messages back, so the retransmission timers start now
+		bool hasRetransmits = false;
+		TArray<NetworkPacket*> packetsToFree;
+		if (!bundle.ReliableUIDs.empty())
+		{
+			std::scoped_lock<SpinLock> lock(m_LockMessagesToSend);
+			for (uint32 reliableUID : bundle.ReliableUIDs)
+			{
+				auto iterator = m_MessagesWaitingForAck.find(reliableUID);
+				if (iterator != m_MessagesWaitingForAck.end())
+				{
+					MessageInfo& messageInfo = iterator->second;
+					messageInfo.IsQueued = false;
+
+					// An earlier transmission was acked while this one was queued, the packet has left the queues now
+					if (messageInfo.IsAcked)
+					{
+						packetsToFree.PushBack(messageInfo.Packet);
+						m_MessagesWaitingForAck.erase(iterator);
+						continue;
+					}
+
+					messageInfo.LastSent	= timestamp;
+					messageInfo.IsInFlight	= true;
+					hasRetransmits |= messageInfo.Retries > 0;
+				}
+			}
+		}
+
+		m_PacketPool.FreePackets(packetsToFree);
+
+		{
+			std::scoped_lock<SpinLock> lock(m_LockBundles);
+			m_SentDatagrams[bundleUID % SENT_DATAGRAM_HISTORY] = { bundleUID, bytesSent, timestamp, hasRetransmits };
 
 			if (!bundle.ReliableUIDs.empty())
 			{
 				bundle.Timestamp = timestamp;
-
-				std::scoped_lock<SpinLock> lock(m_LockBundles);
 				m_Bundles.insert({ bundleUID, bundle });
 			}
 		}
@@ -69,6 +210,8 @@ namespace LambdaEngine
 
 	void PacketManager::QueryBegin(PacketTransceiver* pTransceiver, TArray<NetworkPacket*>& packetsReturned)
 	{
+		PROFILE_FUNCTION();
+
 		TArray<NetworkPacket*> packets;
 		IPEndPoint ipEndPoint;
 		TArray<uint32> acks;
@@ -90,6 +233,8 @@ namespace LambdaEngine
 
 	void PacketManager::Tick(Timestamp delta)
 	{
+		PROFILE_FUNCTION();
+
 		static const Timestamp delay = Timestamp::Seconds(1);
 
 		m_Timer += delta;
@@ -117,29 +262,72 @@ namespace LambdaEngine
 		return m_IPEndPoint;
 	}
 
+	const CongestionController* PacketManager::GetCongestionController() const
+	{
+		return &m_CongestionController;
+	}
+
 	void PacketManager::SetEndPoint(const IPEndPoint& ipEndPoint)
 	{
 		m_IPEndPoint = ipEndPoint;
 	}
 
+	void PacketManager::SetChannelType(uint8 channel, EChannelType type)
+	{
+		std::scoped_lock<SpinLock> lock(m_LockMessagesToSend);
+		if (channel < MAXIMUM_NETWORK_CHANNELS)
+			m_SendChannels[channel].Type = type;
+	}
+
+	EChannelType PacketManager::GetChannelType(uint8 channel) const
+	{
+		return channel < MAXIMUM_NETWORK_CHANNELS ? m_SendChannels[channel].Type : CHANNEL_TYPE_RELIABLE_ORDERED;
+	}
+
+	void PacketManager::SetCompressionMode(ECompressionMode mode)
+	{
+		m_CompressionMode = mode;
+	}
+
+	ECompressionMode PacketManager::GetCompressionMode() const
+	{
+		return m_CompressionMode;
+	}
+
+	void PacketManager::SetSalt(uint64 salt)
+	{
+		m_Statistics.m_Salt = salt;
+	}
+
 	void PacketManager::Reset()
 	{
 		std::scoped_lock<SpinLock> lock1(m_LockMessagesToSend);
 		std::scoped_lock<SpinLock> lock2(m_LockBundles);
 		m_MessagesToSend[0] = {};
 		m_MessagesToSend[1] = {};
+		m_PacedMessages = {};
+		m_ControlMessages = {};
+		m_PacedBytes = 0;
+		memset(m_SentDatagrams, 0, sizeof(m_SentDatagrams));
 		m_MessagesWaitingForAck.clear();
-		m_ReliableMessagesReceived.clear();
+
+		for (uint32 i = 0; i < MAXIMUM_NETWORK_CHANNELS; i++)
+		{
+			m_SendChannels[i].ReliableSequence		= 0;
+			m_SendChannels[i].UnreliableSequence	= 0;
+			m_ReceiveChannels[i] = ReceiveChannel();
+		}
+
 		m_Bundles.clear();
 
 		m_PacketPool.Reset();
 		m_Statistics.Reset();
+		m_CongestionController.Reset();
 		m_QueueIndex = 0;
 	}
 
 	void PacketManager::FindPacketsToReturn(const TArray<NetworkPacket*>& packetsReceived, TArray<NetworkPacket*>& packetsReturned)
 	{
-		bool reliableMessagesInserted = false;
 		bool hasReliableMessage = false;
 
 		TArray<NetworkPacket*> packetsToFree;
@@ -147,74 +335,101 @@ namespace LambdaEngine
 
 		for (NetworkPacket* pPacket : packetsReceived)
 		{
-			if (!pPacket->IsReliable())																//Unreliable Packet
+			const NetworkPacket::Header& header = pPacket->GetHeader();
+
+			if (pPacket->IsReliable())
+				hasReliableMessage = true;
+
+			if (header.Type == NetworkPacket::TYPE_NETWORK_ACK || header.Channel >= MAXIMUM_NETWORK_CHANNELS)
 			{
-				if (pPacket->GetType() == NetworkPacket::TYPE_NETWORK_ACK)
-					packetsToFree.PushBack(pPacket);
-				else
+				packetsToFree.PushBack(pPacket);
+				continue;
+			}
+
+			ReceiveChannel& channel = m_ReceiveChannels[header.Channel];
+
+			if (header.ChannelType == CHANNEL_TYPE_RELIABLE_ORDERED)
+			{
+				if (header.ChannelSequence == channel.LastOrdered + 1)									//Reliable Packet in correct order
+				{
 					packetsReturned.PushBack(pPacket);
+					channel.LastOrdered++;
+					m_Statistics.RegisterReliableMessageReceived();
+					UntangleReliablePackets(channel, packetsReturned);
+				}
+				else if (header.ChannelSequence > channel.LastOrdered && channel.PendingOrdered.insert({ header.ChannelSequence, pPacket }).second)
+				{
+					//Reliable Packet in incorrect order, held until the gap is filled
+				}
+				else																					//Reliable Packet already received before
+				{
+					packetsToFree.PushBack(pPacket);
+				}
 			}
-			else
+			else if (header.ChannelType == CHANNEL_TYPE_RELIABLE_UNORDERED)
 			{
-				hasReliableMessage = true;
-
-				if (pPacket->GetReliableUID() == m_Statistics.GetLastReceivedReliableUID() + 1)		//Reliable Packet in correct order
+				if (header.ChannelSequence > channel.LastUnordered && channel.ReceivedUnordered.insert(header.ChannelSequence).second)
 				{
 					packetsReturned.PushBack(pPacket);
 					m_Statistics.RegisterReliableMessageReceived();
+
+					//Only sequences above the last contiguous one have to be remembered
+					while (!channel.ReceivedUnordered.empty() && *channel.ReceivedUnordered.begin() == channel.LastUnordered + 1)
+					{
+						channel.ReceivedUnordered.erase(channel.ReceivedUnordered.begin());
+						channel.LastUnordered++;
+					}
+				}
+				else
+				{
+					packetsToFree.PushBack(pPacket);
 				}
-				else if (pPacket->GetReliableUID() > m_Statistics.GetLastReceivedReliableUID())		//Reliable Packet in incorrect order
+			}
+			else if (header.ChannelType == CHANNEL_TYPE_UNRELIABLE_SEQUENCED)
+			{
+				if (header.ChannelSequence > channel.LastSequenced)
 				{
-					m_ReliableMessagesReceived.insert(pPacket);
-					reliableMessagesInserted = true;
+					packetsReturned.PushBack(pPacket);
+					channel.LastSequenced = header.ChannelSequence;
 				}
-				else																				//Reliable Packet already received before
+				else
 				{
 					packetsToFree.PushBack(pPacket);
 				}
 			}
+			else
+			{
+				packetsReturned.PushBack(pPacket);
+			}
 		}
 
 		m_PacketPool.FreePackets(packetsToFree);
 
-		if (reliableMessagesInserted)
-			UntangleReliablePackets(packetsReturned);
-
 		if (hasReliableMessage && m_MessagesToSend[m_QueueIndex].empty())
 			EnqueuePacketUnreliable(m_PacketPool.RequestFreePacket()->SetType(NetworkPacket::TYPE_NETWORK_ACK));
 	}
 
-	void PacketManager::UntangleReliablePackets(TArray<NetworkPacket*>& packetsReturned)
+	void PacketManager::UntangleReliablePackets(ReceiveChannel& channel, TArray<NetworkPacket*>& packetsReturned)
 	{
-		TArray<NetworkPacket*> packetsToErase;
-
-		for (NetworkPacket* pPacket : m_ReliableMessagesReceived)
+		auto iterator = channel.PendingOrdered.begin();
+		while (iterator != channel.PendingOrdered.end() && iterator->first == channel.LastOrdered + 1)
 		{
-			if (pPacket->GetReliableUID() == m_Statistics.GetLastReceivedReliableUID() + 1)
-			{
-				packetsReturned.PushBack(pPacket);
-				packetsToErase.PushBack(pPacket);
-				m_Statistics.RegisterReliableMessageReceived();
-			}
-			else
-			{
-				break;
-			}
-		}
-
-		for (NetworkPacket* pPacket : packetsToErase)
-		{
-			m_ReliableMessagesReceived.erase(pPacket);
+			packetsReturned.PushBack(iterator->second);
+			channel.LastOrdered++;
+			m_Statistics.RegisterReliableMessageReceived();
+			iterator = channel.PendingOrdered.erase(iterator);
 		}
 	}
 
 	/*
 	* Finds packets that have been sent erlier and are now acked.
 	* Notifies the listener that the packet was succesfully delivered.
-	* Removes the packet and returns it to the pool.
+	* Removes the packet and returns it to the pool, unless a resend of it is still queued.
 	*/
 	void PacketManager::HandleAcks(const TArray<uint32>& acks)
 	{
+		RegisterAckedDatagrams(acks);
+
 		TArray<uint32> ackedReliableUIDs;
 		GetReliableUIDsFromAcks(acks, ackedReliableUIDs);
 
@@ -230,7 +445,9 @@ namespace LambdaEngine
 			{
 				messageInfo.Listener->OnPacketDelivered(messageInfo.Packet);
 			}
-			packetsToFree.PushBack(messageInfo.Packet);
+
+			if (!messageInfo.IsQueued)
+				packetsToFree.PushBack(messageInfo.Packet);
 		}
 
 		m_PacketPool.FreePackets(packetsToFree);
@@ -241,8 +458,6 @@ namespace LambdaEngine
 		ackedReliableUIDs.Reserve(128);
 		std::scoped_lock<SpinLock> lock(m_LockBundles);
 
-		Timestamp timestamp = 0;
-
 		for (uint32 ack : acks)
 		{
 			auto iterator = m_Bundles.find(ack);
@@ -252,15 +467,9 @@ namespace LambdaEngine
 				for (uint32 UID : bundle.ReliableUIDs)
 					ackedReliableUIDs.PushBack(UID);
 
-				timestamp = bundle.Timestamp;
 				m_Bundles.erase(iterator);
 			}
 		}
-
-		if (timestamp != 0)
-		{
-			RegisterRTT(EngineLoop::GetTimeSinceStart() - timestamp);
-		}
 	}
 
 	void PacketManager::GetReliableMessageInfosFromUIDs(const TArray<uint32>& ackedReliableUIDs, TArray<MessageInfo>& ackedReliableMessages)
@@ -271,25 +480,105 @@ namespace LambdaEngine
 		for (uint32 UID : ackedReliableUIDs)
 		{
 			auto iterator = m_MessagesWaitingForAck.find(UID);
-			if (iterator != m_MessagesWaitingForAck.end())
+			if (iterator != m_MessagesWaitingForAck.end() && !iterator->second.IsAcked)
 			{
 				ackedReliableMessages.PushBack(iterator->second);
-				m_MessagesWaitingForAck.erase(iterator);
+
+				// A queued resend still refers to the packet, Flush frees it once it is transmitted
+				if (iterator->second.IsQueued)
+					iterator->second.IsAcked = true;
+				else
+					m_MessagesWaitingForAck.erase(iterator);
 			}
 		}
 	}
 
+	/*
+	* Updates SRTT, RTTVAR and RTO as described in RFC 6298.
+	* The minimum RTO is far below the 1 second of the RFC since the peers ack at least once per tick.
+	*/
 	void PacketManager::RegisterRTT(Timestamp rtt)
 	{
-		static const double scalar1 = 1.0f / 10.0f;
-		static const double scalar2 = 1.0f - scalar1;
-		m_Statistics.m_Ping = (uint64)((rtt.AsNanoSeconds() * scalar1) + (m_Statistics.GetPing().AsNanoSeconds() * scalar2));
+		if (!m_Statistics.m_HasRTTSample)
+		{
+			m_Statistics.m_Ping			= rtt;
+			m_Statistics.m_RTTVariance	= rtt / 2;
+			m_Statistics.m_HasRTTSample	= true;
+		}
+		else
+		{
+			const Timestamp& srtt = m_Statistics.GetPing();
+			Timestamp deviation = srtt > rtt ? srtt - rtt : rtt - srtt;
+			m_Statistics.m_RTTVariance	= (m_Statistics.GetRTTVariance() * 3 + deviation) / 4;
+			m_Statistics.m_Ping			= (srtt * 7 + rtt) / 8;
+		}
+
+		Timestamp variance = m_Statistics.GetRTTVariance() * 4;
+		Timestamp rto = m_Statistics.GetPing() + (variance > CLOCK_GRANULARITY ? variance : CLOCK_GRANULARITY);
+		m_Statistics.m_RetransmissionTimeout = std::clamp(rto, MIN_RTO, MAX_RTO);
+	}
+
+	void PacketManager::RegisterAckedDatagrams(const TArray<uint32>& acks)
+	{
+		Timestamp currentTime = EngineLoop::GetPreciseTimeSinceStart();
+		Timestamp lastSent = 0;
+
+		{
+			std::scoped_lock<SpinLock> lock(m_LockBundles);
+			for (uint32 ack : acks)
+			{
+				SentDatagram& datagram = m_SentDatagrams[ack % SENT_DATAGRAM_HISTORY];
+				if (datagram.Sequence == ack && datagram.Bytes > 0)
+				{
+					if (!datagram.HasRetransmits && datagram.Timestamp > lastSent)
+						lastSent = datagram.Timestamp;
+
+					m_CongestionController.OnAcked(datagram.Bytes, m_Statistics.GetPing(), currentTime);
+					datagram.Bytes = 0;
+				}
+			}
+		}
+
+		// The latest datagram gives the sample with the least ack delay
+		if (lastSent != 0)
+			RegisterRTT(currentTime - lastSent);
+	}
+
+	/*
+	* Called when the paced queue holds more than the congestion controller allows.
+	* Drops the oldest unreliable messages, reliable messages are kept since they would be resent anyway.
+	*/
+	void PacketManager::DropQueuedUnreliablePackets()
+	{
+		const uint32 maxQueuedBytes = m_CongestionController.GetMaxQueuedBytes();
+
+		TArray<NetworkPacket*> packetsToFree;
+		std::queue<NetworkPacket*> packetsToKeep;
+
+		while (!m_PacedMessages.empty())
+		{
+			NetworkPacket* pPacket = m_PacedMessages.front();
+			m_PacedMessages.pop();
+
+			if (m_PacedBytes > maxQueuedBytes && !pPacket->IsReliable())
+			{
+				m_PacedBytes -= pPacket->GetTotalSize();
+				packetsToFree.PushBack(pPacket);
+			}
+			else
+			{
+				packetsToKeep.push(pPacket);
+			}
+		}
+
+		m_PacedMessages.swap(packetsToKeep);
+		m_PacketPool.FreePackets(packetsToFree);
 	}
 
 	void PacketManager::DeleteOldBundles()
 	{
 		Timestamp maxAllowedTime = m_Statistics.GetPing() * 100;
-		Timestamp currentTime = EngineLoop::GetTimeSinceStart();
+		Timestamp currentTime = EngineLoop::GetPreciseTimeSinceStart();
 
 		TArray<uint32> bundlesToDelete;
 
@@ -297,10 +586,7 @@ namespace LambdaEngine
 		for (auto& pair : m_Bundles)
 		{
 			if (currentTime - pair.second.Timestamp > maxAllowedTime)
-			{
 				bundlesToDelete.PushBack(pair.first);
-				m_Statistics.RegisterPacketLoss();
-			}
 		}
 
 		for (uint32 UID : bundlesToDelete)
@@ -309,14 +595,13 @@ namespace LambdaEngine
 
 	void PacketManager::ResendOrDeleteMessages()
 	{
-		static Timestamp minTime = Timestamp::MilliSeconds(5);
-		Timestamp maxAllowedTime = (uint64)((float64)m_Statistics.GetPing().AsNanoSeconds() * m_ResendRTTMultiplier);
-		if (maxAllowedTime < minTime)
-			maxAllowedTime = minTime;
+		Timestamp currentTime = EngineLoop::GetPreciseTimeSinceStart();
 
-		Timestamp currentTime = EngineLoop::GetTimeSinceStart();
+		// Resends would only queue up behind the messages the pacer is still holding back
+		const bool isBacklogged = m_PacedBytes > 0;
 
 		TArray<std::pair<const uint32, MessageInfo>> messagesToDelete;
+		bool hasTimedOut = false;
 
 		{
 			std::scoped_lock<SpinLock> lock(m_LockMessagesToSend);
@@ -324,28 +609,46 @@ namespace LambdaEngine
 			for (auto& pair : m_MessagesWaitingForAck)
 			{
 				MessageInfo& messageInfo = pair.second;
-				if (currentTime - messageInfo.LastSent > maxAllowedTime)
+
+				// A loss is only reported once per transmission, messages still waiting in the queues have not been sent
+				if (messageInfo.IsInFlight && currentTime - messageInfo.LastSent > messageInfo.Timeout)
 				{
-					messageInfo.Retries++;
+					messageInfo.IsInFlight	= false;
+					messageInfo.IsLost		= true;
+					hasTimedOut = true;
+				}
 
-					if (messageInfo.Retries < m_MaxRetries)
-					{
-						m_MessagesToSend[m_QueueIndex].push(messageInfo.Packet);
-						messageInfo.LastSent = currentTime;
+				if (!messageInfo.IsLost)
+					continue;
 
-						if (messageInfo.Listener)
-							messageInfo.Listener->OnPacketResent(messageInfo.Packet, messageInfo.Retries);
-					}
-					else
-					{
-						messagesToDelete.PushBack(pair);
-					}
+				// Without retransmit budget the message waits for the next tick and keeps its retries
+				if (messageInfo.Retries + 1 < m_MaxRetries && (isBacklogged || !m_CongestionController.TryRetransmit(messageInfo.Packet->GetTotalSize(), currentTime)))
+					continue;
+
+				messageInfo.Retries++;
+
+				if (messageInfo.Retries < m_MaxRetries)
+				{
+					m_MessagesToSend[m_QueueIndex].push(messageInfo.Packet);
+					messageInfo.IsLost		= false;
+					messageInfo.IsQueued	= true;
+					messageInfo.Timeout	= std::min(messageInfo.Timeout * 2, MAX_RTO);
+
+					if (messageInfo.Listener)
+						messageInfo.Listener->OnPacketResent(messageInfo.Packet, messageInfo.Retries);
+				}
+				else
+				{
+					messagesToDelete.PushBack(pair);
 				}
 			}
 
 			for (auto& pair : messagesToDelete)
 				m_MessagesWaitingForAck.erase(pair.first);
 		}
+
+		if (hasTimedOut)
+			m_CongestionController.OnLoss(m_Statistics.GetPing(), currentTime);
 		
 		TArray<NetworkPacket*> packetsToFree;
 		packetsToFree.Reserve(messagesToDelete.GetSize());
@@ -1,11 +1,21 @@
 #include "Networking/API/PacketPool.h"
 #include "Networking/API/NetworkPacket.h"
+#include "Networking/API/PacketArena.h"
 
 #include "Log/Log.h"
+#include "Log/BinaryLog.h"
+
+#include "Metrics/MetricsRegistry.h"
+
+#include <algorithm>
 
 namespace LambdaEngine
 {
-	PacketPool::PacketPool(uint16 size)
+	constexpr const uint16 ARENA_GROW_SIZE = 16;
+
+	PacketPool::PacketPool(uint16 size) :
+		m_pArena(nullptr),
+		m_Quota(size)
 	{
 		m_Packets.Reserve(size);
 		m_PacketsFree.Reserve(size);
@@ -16,12 +26,36 @@ namespace LambdaEngine
 			m_Packets.PushBack(pPacket);
 			m_PacketsFree.PushBack(pPacket);
 		}		
+
+		m_pPacketsGauge			= MetricsRegistry::RegisterGauge("lambda_packet_pool_packets", "Number of packets allocated by all packet pools");
+		m_pPacketsInUseGauge	= MetricsRegistry::RegisterGauge("lambda_packet_pool_packets_in_use", "Number of packets currently borrowed from all packet pools");
+		m_pPacketsGauge->Add(size);
+	}
+
+	PacketPool::PacketPool(PacketArena* pArena, uint16 quota) :
+		m_pArena(pArena),
+		m_Quota(quota)
+	{
+		// The arena accounts for the packets it allocates
+		m_pPacketsGauge			= nullptr;
+		m_pPacketsInUseGauge	= MetricsRegistry::RegisterGauge("lambda_packet_pool_packets_in_use", "Number of packets currently borrowed from all packet pools");
 	}
 
 	PacketPool::~PacketPool()
 	{
-		for (uint16 i = 0; i < m_Packets.GetSize(); i++)
-			delete m_Packets[i];
+		m_pPacketsInUseGauge->Add(-float64(m_Packets.GetSize() - m_PacketsFree.GetSize()));
+
+		if (m_pArena)
+		{
+			m_pArena->FreePackets(m_Packets.GetData(), m_Packets.GetSize());
+		}
+		else
+		{
+			m_pPacketsGauge->Add(-float64(m_Packets.GetSize()));
+
+			for (uint16 i = 0; i < m_Packets.GetSize(); i++)
+				delete m_Packets[i];
+		}
 
 		m_Packets.Clear();
 	}
@@ -29,11 +63,16 @@ namespace LambdaEngine
 	NetworkPacket* PacketPool::RequestFreePacket()
 	{
 		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		if (m_pArena && m_PacketsFree.IsEmpty())
+			Grow(1);
+
 		NetworkPacket* pPacket = nullptr;
 		if (!m_PacketsFree.IsEmpty())
 		{
 			pPacket = m_PacketsFree[m_PacketsFree.GetSize() - 1];
 			m_PacketsFree.PopBack();
+			m_pPacketsInUseGauge->Add(1.0);
 
 #ifndef LAMBDA_CONFIG_PRODUCTION
 			Request(pPacket);
@@ -41,7 +80,7 @@ namespace LambdaEngine
 		}
 		else
 		{
-			LOG_ERROR("[PacketPool]: No more free packets!, delta = -1");
+			LOG_BINARY_RATE(ELogSeverity::LOG_ERROR, 1, "[PacketPool]: No more free packets!, delta = -1");
 		}
 		return pPacket;
 	}
@@ -50,16 +89,20 @@ namespace LambdaEngine
 	{
 		std::scoped_lock<SpinLock> lock(m_Lock);
 
+		if (m_pArena && m_PacketsFree.GetSize() < nrOfPackets)
+			Grow(nrOfPackets - (uint16)m_PacketsFree.GetSize());
+
 		int32 delta = (int32)m_PacketsFree.GetSize() - nrOfPackets;
 
 		if (delta < 0)
 		{
-			LOG_ERROR("[PacketPool]: No more free packets!, delta = %d", delta);
+			LOG_BINARY_RATE(ELogSeverity::LOG_ERROR, 1, "[PacketPool]: No more free packets!, delta = %d", delta);
 			return false;
 		}
 
 		packetsReturned = TArray<NetworkPacket*>(m_PacketsFree.begin() + delta, m_PacketsFree.end());
 		m_PacketsFree = TArray<NetworkPacket*>(m_PacketsFree.begin(), m_PacketsFree.begin() + delta);
+		m_pPacketsInUseGauge->Add(float64(nrOfPackets));
 
 #ifndef LAMBDA_CONFIG_PRODUCTION
 		for (int32 i = 0; i < nrOfPackets; i++)
@@ -115,13 +158,49 @@ namespace LambdaEngine
 #endif
 
 		pPacket->m_SizeOfBuffer = 0;
+		pPacket->m_Header = NetworkPacket::Header();
 		m_PacketsFree.PushBack(pPacket);
+		m_pPacketsInUseGauge->Add(-1.0);
+	}
+
+	/*
+	* Takes at least nrOfPackets, and at most the remaining quota, from the arena
+	*/
+	void PacketPool::Grow(uint16 nrOfPackets)
+	{
+		uint32 quotaLeft = m_Quota > m_Packets.GetSize() ? m_Quota - m_Packets.GetSize() : 0;
+		uint32 count = std::min<uint32>(std::max(nrOfPackets, ARENA_GROW_SIZE), quotaLeft);
+		if (count == 0)
+			return;
+
+		uint32 first = m_Packets.GetSize();
+		count = m_pArena->RequestPackets(count, m_Packets);
+
+		for (uint32 i = first; i < first + count; i++)
+		{
+			NetworkPacket* pPacket = m_Packets[i];
+#ifndef LAMBDA_CONFIG_PRODUCTION
+			pPacket->m_IsBorrowed = false;
+#endif
+			pPacket->m_SizeOfBuffer = 0;
+			pPacket->m_Header = NetworkPacket::Header();
+			m_PacketsFree.PushBack(pPacket);
+		}
 	}
 
 	void PacketPool::Reset()
 	{
 		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_pPacketsInUseGauge->Add(-float64(m_Packets.GetSize() - m_PacketsFree.GetSize()));
 		m_PacketsFree.Clear();
+
+		// Pools backed by an arena start over empty, packets are borrowed again when needed
+		if (m_pArena)
+		{
+			m_pArena->FreePackets(m_Packets.GetData(), m_Packets.GetSize());
+			m_Packets.Clear();
+			return;
+		}
 		m_PacketsFree.Reserve(m_Packets.GetSize());
 
 		for (NetworkPacket* pPacket : m_Packets)
@@ -130,6 +209,7 @@ namespace LambdaEngine
 			pPacket->m_IsBorrowed = false;
 #endif
 			pPacket->m_SizeOfBuffer = 0;
+			pPacket->m_Header = NetworkPacket::Header();
 			m_PacketsFree.PushBack(pPacket);
 		}
 	}
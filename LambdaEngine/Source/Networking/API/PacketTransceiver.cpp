@@ -4,19 +4,34 @@
 
 #include "Math/Random.h"
 
+#include "Metrics/MetricsRegistry.h"
+
+#include "Engine/Replay.h"
+#include "Engine/EngineLoop.h"
+
 #include "Log/Log.h"
+#include "Log/BinaryLog.h"
 
 namespace LambdaEngine
 {
 	PacketTransceiver::PacketTransceiver() : 
 		m_pSocket(nullptr),
 		m_BytesReceived(0),
+		m_pDatagram(nullptr),
+		m_DatagramSize(0),
 		m_ReceivingLossRatio(0.0f),
 		m_TransmittingLossRatio(0.0f),
 		m_pSendBuffer(),
-		m_pReceiveBuffer()
+		m_pReceiveBuffer(),
+		m_pCompressBuffer(),
+		m_pDecompressBuffer(),
+		m_ReplayStream(Replay::RegisterStream())
 	{
-
+		m_pPacketsSentCounter		= MetricsRegistry::RegisterCounter("lambda_network_packets_sent_total", "Number of UDP datagrams sent");
+		m_pPacketsReceivedCounter	= MetricsRegistry::RegisterCounter("lambda_network_packets_received_total", "Number of UDP datagrams received");
+		m_pBytesSentCounter			= MetricsRegistry::RegisterCounter("lambda_network_bytes_sent_total", "Number of bytes sent over UDP");
+		m_pBytesReceivedCounter		= MetricsRegistry::RegisterCounter("lambda_network_bytes_received_total", "Number of bytes received over UDP");
+		m_pBytesSavedCounter		= MetricsRegistry::RegisterCounter("lambda_network_compression_bytes_saved_total", "Number of bytes removed from sent datagrams by compression");
 	}
 
 	PacketTransceiver::~PacketTransceiver()
@@ -24,14 +39,15 @@ namespace LambdaEngine
 
 	}
 
-	int32 PacketTransceiver::Transmit(PacketPool* pPacketPool, std::queue<NetworkPacket*>& packets, std::set<uint32>& reliableUIDsSent, const IPEndPoint& ipEndPoint, NetworkStatistics* pStatistics)
+	int32 PacketTransceiver::Transmit(PacketPool* pPacketPool, std::queue<NetworkPacket*>& packets, std::set<uint32>& reliableUIDsSent, const IPEndPoint& ipEndPoint, NetworkStatistics* pStatistics, ECompressionMode compression)
 	{
+		FlushSimulatedDatagrams();
+
 		if (packets.empty())
 			return 0;
 
 		PacketTranscoder::Header header;
 		uint16 bytesWritten = 0;
-		int32 bytesTransmitted = 0;
 
 		header.Sequence = pStatistics->RegisterPacketSent();
 		header.Salt		= pStatistics->GetSalt();
@@ -40,6 +56,18 @@ namespace LambdaEngine
 
 		PacketTranscoder::EncodePackets(m_pSendBuffer, MAXIMUM_PACKET_SIZE + sizeof(PacketTranscoder::Header), pPacketPool, packets, reliableUIDsSent, bytesWritten, &header);
 
+		const char* pDatagram = m_pSendBuffer;
+		if (compression != COMPRESSION_MODE_NONE)
+		{
+			uint16 compressedSize = PacketTranscoder::CompressDatagram(m_pSendBuffer, bytesWritten, m_pCompressBuffer, sizeof(m_pCompressBuffer), compression);
+			if (compressedSize > 0)
+			{
+				m_pBytesSavedCounter->Add(bytesWritten - compressedSize);
+				pDatagram = m_pCompressBuffer;
+				bytesWritten = compressedSize;
+			}
+		}
+
 		pStatistics->RegisterBytesSent(bytesWritten);
 
 #ifndef LAMBDA_CONFIG_PRODUCTION
@@ -48,22 +76,71 @@ namespace LambdaEngine
 			LOG_WARNING("[PacketTransceiver]: Simulated Transmitting Packetloss");
 			return header.Sequence;
 		}
+
+		if (m_ConditionSimulator.IsEnabled())
+		{
+			m_ConditionSimulator.Submit(pDatagram, bytesWritten, ipEndPoint, EngineLoop::GetPreciseTimeSinceStart());
+			FlushSimulatedDatagrams();
+			return header.Sequence;
+		}
 #endif
 
-		if (!m_pSocket->SendTo(m_pSendBuffer, bytesWritten, bytesTransmitted, ipEndPoint))
-			return -1;
-		else if (bytesWritten != bytesTransmitted)
+		if (!SendDatagram(pDatagram, bytesWritten, ipEndPoint))
 			return -1;
 
 		return header.Sequence;
 	}
 
+	bool PacketTransceiver::PeekFirstPacket(PacketTranscoder::Header& header, NetworkPacket::Header& packetHeader, const char*& pPayload) const
+	{
+		if (m_DatagramSize == 0)
+			return false;
+
+		return PacketTranscoder::PeekFirstPacket(m_pDatagram, m_DatagramSize, &header, &packetHeader, &pPayload);
+	}
+
+	bool PacketTransceiver::SendDatagram(const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint)
+	{
+		// The peers of a recorded session do not exist during playback
+		if (Replay::IsPlaying())
+			return true;
+
+		int32 bytesTransmitted = 0;
+		if (!m_pSocket->SendTo(pBuffer, bytes, bytesTransmitted, ipEndPoint))
+			return false;
+		else if (bytes != bytesTransmitted)
+			return false;
+
+		m_pPacketsSentCounter->Add();
+		m_pBytesSentCounter->Add(bytesTransmitted);
+
+		return true;
+	}
+
 	bool PacketTransceiver::ReceiveBegin(IPEndPoint& sender)
 	{
 		m_BytesReceived = 0;
+		m_DatagramSize	= 0;
 
-		if (!m_pSocket->ReceiveFrom(m_pReceiveBuffer, UINT16_MAX, m_BytesReceived, sender))
-			return false;
+		if (Replay::IsPlaying())
+		{
+			if (!Replay::PlaybackDatagram(m_ReplayStream, sender, m_pReceiveBuffer, UINT16_MAX, m_BytesReceived))
+				return false;
+		}
+		else
+		{
+			if (!m_pSocket->ReceiveFrom(m_pReceiveBuffer, UINT16_MAX, m_BytesReceived, sender))
+				return false;
+
+			if (m_BytesReceived > 0 && Replay::IsRecording())
+				Replay::RecordDatagram(m_ReplayStream, sender, m_pReceiveBuffer, m_BytesReceived);
+		}
+
+		if (m_BytesReceived > 0)
+		{
+			m_pPacketsReceivedCounter->Add();
+			m_pBytesReceivedCounter->Add(m_BytesReceived);
+		}
 
 #ifndef LAMBDA_CONFIG_PRODUCTION
 		if (m_ReceivingLossRatio > 0.0f && Random::Float32() <= m_ReceivingLossRatio)
@@ -73,13 +150,36 @@ namespace LambdaEngine
 		}	
 #endif
 
-		return m_BytesReceived > 0;
+		if (m_BytesReceived <= 0)
+			return false;
+
+		m_pDatagram		= m_pReceiveBuffer;
+		m_DatagramSize	= (uint16)m_BytesReceived;
+
+		PacketTranscoder::Header header;
+		if (m_DatagramSize >= sizeof(header))
+		{
+			memcpy(&header, m_pReceiveBuffer, sizeof(header));
+			if (header.Compression != COMPRESSION_MODE_NONE)
+			{
+				if (!PacketTranscoder::DecompressDatagram(m_pReceiveBuffer, m_DatagramSize, m_pDecompressBuffer, sizeof(m_pDecompressBuffer), m_DatagramSize))
+				{
+					LOG_BINARY_RATE(ELogSeverity::LOG_ERROR, 1, "[PacketTransceiver]: Received a malformed compressed datagram [%s]", sender.ToString().c_str());
+					m_DatagramSize = 0;
+					return false;
+				}
+
+				m_pDatagram = m_pDecompressBuffer;
+			}
+		}
+
+		return true;
 	}
 
 	bool PacketTransceiver::ReceiveEnd(PacketPool* pPacketPool, TArray<NetworkPacket*>& packets, TArray<uint32>& newAcks, NetworkStatistics* pStatistics)
 	{
 		PacketTranscoder::Header header;
-		if (!PacketTranscoder::DecodePackets(m_pReceiveBuffer, (uint16)m_BytesReceived, pPacketPool, packets, &header))
+		if (!PacketTranscoder::DecodePackets(m_pDatagram, m_DatagramSize, pPacketPool, packets, &header))
 			return false;
 
 		if (!ValidateHeaderSalt(&header, pStatistics))
@@ -96,6 +196,7 @@ namespace LambdaEngine
 	void PacketTransceiver::SetSocket(ISocketUDP* pSocket)
 	{
 		m_pSocket = pSocket;
+		m_ConditionSimulator.Reset();
 	}
 
 	void PacketTransceiver::SetSimulateReceivingPacketLoss(float32 lossRatio)
@@ -108,6 +209,43 @@ namespace LambdaEngine
 		m_TransmittingLossRatio = lossRatio;
 	}
 
+	void PacketTransceiver::SetSimulatedConditions(const NetworkConditions& conditions)
+	{
+		m_ConditionSimulator.SetConditions(conditions);
+	}
+
+	NetworkConditions PacketTransceiver::GetSimulatedConditions() const
+	{
+		return m_ConditionSimulator.GetConditions();
+	}
+
+	void PacketTransceiver::RemoveSimulatedLink(const IPEndPoint& ipEndPoint)
+	{
+		m_ConditionSimulator.RemoveLink(ipEndPoint);
+	}
+
+	Timestamp PacketTransceiver::FlushSimulatedDatagrams()
+	{
+#ifndef LAMBDA_CONFIG_PRODUCTION
+		if (m_pSocket && m_ConditionSimulator.IsEnabled())
+		{
+			// Called from the network threads, the frame time would hold datagrams back until the next frame
+			const Timestamp now = EngineLoop::GetPreciseTimeSinceStart();
+
+			// Send errors are ignored, like a datagram lost on the way
+			m_ConditionSimulator.Flush(now, [this](const char* pBuffer, int32 bytes, const IPEndPoint& ipEndPoint)
+			{
+				SendDatagram(pBuffer, bytes, ipEndPoint);
+			});
+
+			Timestamp deliveryTime;
+			if (m_ConditionSimulator.GetNextDeliveryTime(deliveryTime))
+				return Timestamp(std::max<uint64>(deliveryTime.AsNanoSeconds(), now.AsNanoSeconds() + 1) - now.AsNanoSeconds());
+		}
+#endif
+		return Timestamp(0);
+	}
+
 	bool PacketTransceiver::ValidateHeaderSalt(PacketTranscoder::Header* header, NetworkStatistics* pStatistics)
 	{
 		if (header->Salt == 0)
@@ -140,19 +278,12 @@ namespace LambdaEngine
 		if (sequence > lastReceivedSequence)
 		{
 			//New sequence number received so shift everything delta steps
-			int32 delta = sequence - lastReceivedSequence;
-			pStatistics->SetLastReceivedSequenceNr(sequence);
+			uint32 sequenceBits = pStatistics->GetReceivedSequenceBits();
+			uint32 packetsLost = ShiftSequenceBits(sequenceBits, lastReceivedSequence, sequence - lastReceivedSequence);
 
-			for (int i = 0; i < delta; i++)
-			{
-				uint32 sequenceBits = pStatistics->GetReceivedSequenceBits();
-				if (sequenceBits >> (sizeof(uint32) * 8 - 1) & 0)
-				{
-					//The last bit that was removed was never acked.
-					pStatistics->m_PacketsLost++;
-				}
-				pStatistics->SetReceivedSequenceBits(sequenceBits << 1);
-			}
+			pStatistics->SetLastReceivedSequenceNr(sequence);
+			pStatistics->SetReceivedSequenceBits(sequenceBits);
+			pStatistics->RegisterIncomingPacketsLost(packetsLost);
 		}
 		else if(sequence < lastReceivedSequence)
 		{
@@ -178,12 +309,8 @@ namespace LambdaEngine
 		{
 			pStatistics->SetLastReceivedAckNr(ack);
 
-			if (lastReceivedAck > 0)
-			{
-				currentAckBits <<= 1;
-				currentAckBits |= 1;
-				currentAckBits <<= (ack - lastReceivedAck - 1);
-			}
+			//Sent packets that leave the window without being acked are lost
+			pStatistics->RegisterPacketsLost(ShiftSequenceBits(currentAckBits, lastReceivedAck, ack - lastReceivedAck));
 
 			bits = currentAckBits;
 		}
@@ -212,4 +339,35 @@ namespace LambdaEngine
 		if (ack > lastReceivedAck)
 			newAcks.PushBack(ack);
 	}
-}
\ No newline at end of file
+
+	/*
+	* Moves a window of sequence bits, where bit i represents the sequence (latestSequence - 1 - i), delta steps forward.
+	* The previous latest sequence is marked as received on the way.
+	*	return - The number of sequences that left the window without being marked
+	*/
+	uint32 PacketTransceiver::ShiftSequenceBits(uint32& sequenceBits, uint32 latestSequence, uint32 delta)
+	{
+		static constexpr const uint32 WINDOW_SIZE = sizeof(uint32) * 8;
+
+		uint32 sequencesLost = 0;
+		uint32 steps = std::min(delta, WINDOW_SIZE + 1);
+
+		for (uint32 i = 0; i < steps; i++)
+		{
+			//The highest bit represents the sequence (latestSequence - 32 + i), sequences start at 1
+			if (!(sequenceBits >> (WINDOW_SIZE - 1) & 1) && int64(latestSequence) - int64(WINDOW_SIZE) + int64(i) >= 1)
+				sequencesLost++;
+
+			sequenceBits <<= 1;
+
+			if (i == 0 && latestSequence > 0)
+				sequenceBits |= 1;
+		}
+
+		//Everything in between the old and the new window was never received
+		if (delta > steps)
+			sequencesLost += delta - steps;
+
+		return sequencesLost;
+	}
+}
@@ -85,6 +85,67 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool PacketTranscoder::PeekFirstPacket(const char* buffer, uint16 bufferSize, Header* pHeader, NetworkPacket::Header* pPacketHeader, const char** ppPayload)
+	{
+		if (bufferSize < sizeof(Header) + sizeof(NetworkPacket::Header))
+			return false;
+
+		memcpy(pHeader, buffer, sizeof(Header));
+		if (pHeader->Size != bufferSize || pHeader->Packets == 0)
+			return false;
+
+		memcpy(pPacketHeader, buffer + sizeof(Header), sizeof(NetworkPacket::Header));
+		if (pPacketHeader->Size < sizeof(NetworkPacket::Header) || pPacketHeader->Size > bufferSize - sizeof(Header))
+			return false;
+
+		*ppPayload = buffer + sizeof(Header) + sizeof(NetworkPacket::Header);
+		return true;
+	}
+
+	uint16 PacketTranscoder::CompressDatagram(const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize, ECompressionMode mode)
+	{
+		constexpr const uint16 prefixSize = sizeof(Header) + sizeof(uint16);
+		if (sourceSize <= sizeof(Header) || destinationSize <= prefixSize)
+			return 0;
+
+		uint16 payloadSize = PacketCompressor::Compress(mode, pSource + sizeof(Header), sourceSize - sizeof(Header), pDestination + prefixSize, destinationSize - prefixSize);
+		if (payloadSize == 0 || payloadSize + prefixSize >= sourceSize)
+			return 0;
+
+		Header header;
+		memcpy(&header, pSource, sizeof(Header));
+		header.Size			= payloadSize + prefixSize;
+		header.Compression	= mode;
+
+		memcpy(pDestination, &header, sizeof(Header));
+		memcpy(pDestination + sizeof(Header), &sourceSize, sizeof(uint16));
+
+		return header.Size;
+	}
+
+	bool PacketTranscoder::DecompressDatagram(const char* pSource, uint16 sourceSize, char* pDestination, uint16 destinationSize, uint16& bytesWritten)
+	{
+		constexpr const uint16 prefixSize = sizeof(Header) + sizeof(uint16);
+		if (sourceSize < prefixSize)
+			return false;
+
+		Header header;
+		memcpy(&header, pSource, sizeof(Header));
+		memcpy(&bytesWritten, pSource + sizeof(Header), sizeof(uint16));
+
+		if (header.Size != sourceSize || header.Compression >= COMPRESSION_MODE_COUNT || bytesWritten <= sizeof(Header) || bytesWritten > destinationSize)
+			return false;
+
+		if (!PacketCompressor::Decompress(ECompressionMode(header.Compression), pSource + prefixSize, sourceSize - prefixSize, pDestination + sizeof(Header), bytesWritten - sizeof(Header)))
+			return false;
+
+		header.Size			= bytesWritten;
+		header.Compression	= COMPRESSION_MODE_NONE;
+		memcpy(pDestination, &header, sizeof(Header));
+
+		return true;
+	}
+
 	uint16 PacketTranscoder::ReadPacket(const char* buffer, NetworkPacket* pPacket)
 	{
 		NetworkPacket::Header& messageHeader = pPacket->GetHeader();
@@ -0,0 +1,232 @@
+#include "Networking/API/RelevancyManager.h"
+#include "Networking/API/IRelevancyHandler.h"
+#include "Networking/API/IClient.h"
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/PacketTranscoder.h"
+#include "Networking/API/BinaryEncoder.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	constexpr const uint16 UPDATE_HEADER_SIZE		= sizeof(uint32) + sizeof(uint16);
+	constexpr const uint16 UPDATE_PACKET_SIZE		= MAXIMUM_PACKET_SIZE - sizeof(PacketTranscoder::Header) - sizeof(NetworkPacket::Header);
+	constexpr const float32 MAX_BUDGET_SECONDS		= 0.1f;		// Unused budget carried over, limits the burst after an idle period
+	constexpr const float32 MIN_DISTANCE_SCALE		= 0.25f;	// Priority scale of objects at the edge of the view radius
+
+	RelevancyManager::RelevancyManager(IRelevancyHandler* pHandler, const RelevancyManagerDesc& desc) :
+		m_pHandler(pHandler),
+		m_Desc(desc),
+		m_Grid(desc.CellSize)
+	{
+		ASSERT(desc.MaxUpdateSize + UPDATE_HEADER_SIZE <= UPDATE_PACKET_SIZE);
+	}
+
+	uint32 RelevancyManager::RegisterObject(const glm::vec3& position, float32 priority)
+	{
+		uint32 objectID;
+		if (!m_FreeObjectIDs.IsEmpty())
+		{
+			objectID = m_FreeObjectIDs.GetBack();
+			m_FreeObjectIDs.PopBack();
+		}
+		else
+		{
+			objectID = m_Objects.GetSize();
+			m_Objects.PushBack(ReplicatedObject());
+		}
+
+		ReplicatedObject& object = m_Objects[objectID];
+		object.Position		= position;
+		object.Priority		= priority;
+		object.IsRegistered	= true;
+
+		m_Grid.Insert(objectID, position);
+		return objectID;
+	}
+
+	void RelevancyManager::UnregisterObject(uint32 objectID)
+	{
+		if (objectID >= m_Objects.GetSize() || !m_Objects[objectID].IsRegistered)
+			return;
+
+		// Removed from every client now, since the ID may be reused before the next tick
+		for (auto& pair : m_Clients)
+		{
+			TArray<InterestEntry>& interest = pair.second.Interest;
+			InterestEntry* pEnd = interest.GetData() + interest.GetSize();
+			InterestEntry* pEntry = std::lower_bound(interest.GetData(), pEnd, objectID, [](const InterestEntry& entry, uint32 id)
+			{
+				return entry.ObjectID < id;
+			});
+
+			if (pEntry != pEnd && pEntry->ObjectID == objectID)
+			{
+				interest.Erase(TArray<InterestEntry>::Iterator(pEntry));
+				m_pHandler->OnObjectRelevancyChanged(pair.first, objectID, false);
+			}
+		}
+
+		ReplicatedObject& object = m_Objects[objectID];
+		m_Grid.Remove(objectID, object.Position);
+		object.IsRegistered = false;
+		m_FreeObjectIDs.PushBack(objectID);
+	}
+
+	void RelevancyManager::SetObjectPosition(uint32 objectID, const glm::vec3& position)
+	{
+		ReplicatedObject& object = m_Objects[objectID];
+		m_Grid.Move(objectID, object.Position, position);
+		object.Position = position;
+	}
+
+	void RelevancyManager::SetObjectPriority(uint32 objectID, float32 priority)
+	{
+		m_Objects[objectID].Priority = priority;
+	}
+
+	void RelevancyManager::AddClient(IClient* pClient)
+	{
+		ClientInterest& client = m_Clients[pClient];
+		client.ViewRadius = m_Desc.ViewRadius;
+	}
+
+	void RelevancyManager::RemoveClient(IClient* pClient)
+	{
+		m_Clients.erase(pClient);
+	}
+
+	void RelevancyManager::SetClientView(IClient* pClient, const glm::vec3& position, float32 viewRadius)
+	{
+		auto iterator = m_Clients.find(pClient);
+		if (iterator != m_Clients.end())
+		{
+			iterator->second.Position	= position;
+			iterator->second.ViewRadius	= viewRadius;
+		}
+	}
+
+	void RelevancyManager::Tick(Timestamp delta)
+	{
+		m_Delta = delta;
+
+		for (auto& pair : m_Clients)
+		{
+			UpdateInterest(pair.first, pair.second);
+
+			if (pair.first->IsConnected())
+				SendUpdates(pair.first, pair.second);
+		}
+	}
+
+	uint32 RelevancyManager::GetRelevantObjectCount(IClient* pClient) const
+	{
+		auto iterator = m_Clients.find(pClient);
+		return iterator != m_Clients.end() ? iterator->second.Interest.GetSize() : 0;
+	}
+
+	/*
+	* Merges the objects found in the grid with the previous interest set, both sorted by ID, so that accumulated
+	* priorities are kept and the objects that entered or left are found in one pass
+	*/
+	void RelevancyManager::UpdateInterest(IClient* pClient, ClientInterest& client)
+	{
+		m_QueryResult.Clear();
+		m_Grid.Query(client.Position, client.ViewRadius, m_QueryResult);
+		std::sort(m_QueryResult.GetData(), m_QueryResult.GetData() + m_QueryResult.GetSize());
+
+		const float32 seconds		= float32(m_Delta.AsSeconds());
+		const float32 radiusSquared	= client.ViewRadius * client.ViewRadius;
+		const TArray<InterestEntry>& previous = client.Interest;
+		uint32 previousIndex = 0;
+
+		m_NewInterest.Clear();
+		for (uint32 objectID : m_QueryResult)
+		{
+			const ReplicatedObject& object = m_Objects[objectID];
+			const float32 distanceSquared = glm::length2(object.Position - client.Position);
+			if (distanceSquared > radiusSquared)
+				continue;
+
+			for (; previousIndex < previous.GetSize() && previous[previousIndex].ObjectID < objectID; previousIndex++)
+				m_pHandler->OnObjectRelevancyChanged(pClient, previous[previousIndex].ObjectID, false);
+
+			InterestEntry entry;
+			entry.ObjectID = objectID;
+
+			if (previousIndex < previous.GetSize() && previous[previousIndex].ObjectID == objectID)
+			{
+				entry.Accumulated = previous[previousIndex++].Accumulated;
+			}
+			else
+			{
+				// One second of priority up front, so new objects show up before known objects are refreshed
+				m_pHandler->OnObjectRelevancyChanged(pClient, objectID, true);
+				entry.Accumulated = object.Priority;
+			}
+
+			const float32 distanceScale = client.ViewRadius > 0.0f ? 1.0f - (1.0f - MIN_DISTANCE_SCALE) * glm::sqrt(distanceSquared / radiusSquared) : 1.0f;
+			entry.Accumulated += object.Priority * distanceScale * seconds;
+			m_NewInterest.PushBack(entry);
+		}
+
+		for (; previousIndex < previous.GetSize(); previousIndex++)
+			m_pHandler->OnObjectRelevancyChanged(pClient, previous[previousIndex].ObjectID, false);
+
+		std::swap(client.Interest, m_NewInterest);
+	}
+
+	void RelevancyManager::SendUpdates(IClient* pClient, ClientInterest& client)
+	{
+		const float32 bytesPerSecond = float32(m_Desc.BytesPerSecond);
+		client.Budget = std::min(client.Budget + bytesPerSecond * float32(m_Delta.AsSeconds()), bytesPerSecond * MAX_BUDGET_SECONDS + m_Desc.MaxUpdateSize);
+
+		m_SendOrder.Clear();
+		for (InterestEntry& entry : client.Interest)
+		{
+			if (entry.Accumulated > 0.0f)
+				m_SendOrder.PushBack(&entry);
+		}
+
+		std::sort(m_SendOrder.GetData(), m_SendOrder.GetData() + m_SendOrder.GetSize(), [](const InterestEntry* pFirst, const InterestEntry* pSecond)
+		{
+			return pFirst->Accumulated > pSecond->Accumulated;
+		});
+
+		NetworkPacket* pPacket = nullptr;
+		for (InterestEntry* pEntry : m_SendOrder)
+		{
+			if (client.Budget <= 0.0f)
+				break;
+
+			if (pPacket && pPacket->GetBufferSize() + UPDATE_HEADER_SIZE + m_Desc.MaxUpdateSize > UPDATE_PACKET_SIZE)
+			{
+				pClient->SendUnreliable(pPacket);
+				pPacket = nullptr;
+			}
+
+			if (!pPacket)
+			{
+				pPacket = pClient->GetFreePacket(m_Desc.PacketType);
+				client.Budget -= float32(sizeof(NetworkPacket::Header));
+			}
+
+			const uint16 start = pPacket->GetBufferSize();
+
+			BinaryEncoder encoder(pPacket);
+			encoder.WriteUInt32(pEntry->ObjectID);
+			encoder.WriteUInt16(0);
+			m_pHandler->OnWriteObjectUpdate(pClient, pEntry->ObjectID, encoder);
+
+			const uint16 size = pPacket->GetBufferSize() - start - UPDATE_HEADER_SIZE;
+			ASSERT(size <= m_Desc.MaxUpdateSize);
+			memcpy(pPacket->GetBuffer() + start + sizeof(uint32), &size, sizeof(uint16));
+
+			client.Budget -= float32(UPDATE_HEADER_SIZE + size);
+			pEntry->Accumulated = 0.0f;
+		}
+
+		if (pPacket)
+			pClient->SendUnreliable(pPacket);
+	}
+}
@@ -1,29 +1,38 @@
 #include "Networking/API/PlatformNetworkUtils.h"
 #include "Networking/API/ServerUDP.h"
 #include "Networking/API/ISocketUDP.h"
+#include "Networking/API/LoopbackSocketUDP.h"
 #include "Networking/API/ClientUDPRemote.h"
 #include "Networking/API/IServerUDPHandler.h"
 #include "Networking/API/PacketTransceiver.h"
 #include "Networking/API/BinaryEncoder.h"
+#include "Networking/API/NetworkChallenge.h"
 
-#include "Math/Random.h"
+#include "Engine/EngineLoop.h"
 
 #include "Log/Log.h"
 
 namespace LambdaEngine
 {
+	constexpr const uint64 COOKIE_WINDOW_SECONDS = 10;
+
 	std::set<ServerUDP*> ServerUDP::s_Servers;
 	SpinLock ServerUDP::s_Lock;
 
-	ServerUDP::ServerUDP(IServerUDPHandler* pHandler, uint8 maxClients, uint16 packetPerClient, uint8 maximumTries) :
+	ServerUDP::ServerUDP(IServerUDPHandler* pHandler, uint16 maxClients, uint16 packetPerClient, uint8 maximumTries) :
 		m_pHandler(pHandler),
 		m_MaxClients(maxClients),
 		m_PacketsPerClient(packetPerClient),
+		m_PacketArena((uint32(maxClients) + 1) * packetPerClient),
 		m_pSocket(nullptr),
 		m_Accepting(true),
 		m_PacketLoss(0.0f),
-		m_MaxTries(maximumTries)
+		m_MaxTries(maximumTries),
+		m_UseLoopback(false),
+		m_CompressionMode(COMPRESSION_MODE_NONE)
 	{
+		NetworkChallenge::GenerateKey(m_CookieKey);
+
 		std::scoped_lock<SpinLock> lock(s_Lock);
 		s_Servers.insert(this);
 	}
@@ -46,9 +55,10 @@ namespace LambdaEngine
 	{
 		if (!ThreadsAreRunning())
 		{
+			// OnThreadsStarted binds to the end point on the transmitter thread, so it is set before the threads start
+			m_IPEndPoint = ipEndPoint;
 			if (StartThreads())
 			{
-				m_IPEndPoint = ipEndPoint;
 				LOG_WARNING("[ServerUDP]: Starting...");
 				return true;
 			}
@@ -100,9 +110,29 @@ namespace LambdaEngine
 		m_Transciver.SetSimulateTransmittingPacketLoss(lossRatio);
 	}
 
+	void ServerUDP::SetSimulatedConditions(const NetworkConditions& conditions)
+	{
+		m_Transciver.SetSimulatedConditions(conditions);
+	}
+
+	void ServerUDP::SetUseLoopback(bool useLoopback)
+	{
+		m_UseLoopback = useLoopback;
+	}
+
+	void ServerUDP::SetCompressionMode(ECompressionMode mode)
+	{
+		m_CompressionMode = mode;
+	}
+
+	const PacketArena* ServerUDP::GetPacketArena() const
+	{
+		return &m_PacketArena;
+	}
+
 	bool ServerUDP::OnThreadsStarted()
 	{
-		m_pSocket = PlatformNetworkUtils::CreateSocketUDP();
+		m_pSocket = m_UseLoopback ? DBG_NEW LoopbackSocketUDP() : PlatformNetworkUtils::CreateSocketUDP();
 		if (m_pSocket)
 		{
 			if (m_pSocket->Bind(m_IPEndPoint))
@@ -124,11 +154,18 @@ namespace LambdaEngine
 			if (!m_Transciver.ReceiveBegin(sender))
 				continue;
 
-			bool newConnection = false;
-			ClientUDPRemote* pClient = GetOrCreateClient(sender, newConnection);
+			ClientUDPRemote* pClient = GetClient(sender);
 
-			if (newConnection)
+			if (!pClient)
 			{
+				// Nothing is allocated for a sender until it has answered the cookie
+				uint64 salt = 0;
+				if (!VerifyHandshake(sender, salt))
+					continue;
+
+				pClient = DBG_NEW ClientUDPRemote(&m_PacketArena, m_PacketsPerClient, m_MaxTries, sender, salt, this);
+				pClient->GetPacketManager()->SetCompressionMode(m_CompressionMode);
+
 				if (!IsAcceptingConnections())
 				{
 					SendServerNotAccepting(pClient);
@@ -143,6 +180,7 @@ namespace LambdaEngine
 				}
 				else
 				{
+					std::scoped_lock<SpinLock> lock(m_LockClients);
 					m_Clients.insert({ sender, pClient });
 				}
 			}
@@ -153,9 +191,11 @@ namespace LambdaEngine
 
 	void ServerUDP::RunTranmitter()
 	{
+		// Wakes up on Flush, or when the next simulated datagram is due
+		Timestamp timeUntilDelivery = Timestamp(0);
 		while (!ShouldTerminate())
 		{
-			YieldTransmitter();
+			YieldTransmitter(timeUntilDelivery);
 			{
 				std::scoped_lock<SpinLock> lock(m_LockClients);
 				for (auto& tuple : m_Clients)
@@ -163,6 +203,7 @@ namespace LambdaEngine
 					tuple.second->SendPackets(&m_Transciver);
 				}
 			}
+			timeUntilDelivery = m_Transciver.FlushSimulatedDatagrams();
 		}
 	}
 	
@@ -203,20 +244,78 @@ namespace LambdaEngine
 		return m_pHandler->CreateClientUDPHandler();
 	}
 
-	ClientUDPRemote* ServerUDP::GetOrCreateClient(const IPEndPoint& sender, bool& newConnection)
+	ClientUDPRemote* ServerUDP::GetClient(const IPEndPoint& sender)
 	{
 		std::scoped_lock<SpinLock> lock(m_LockClients);
 		auto pIterator = m_Clients.find(sender);
-		if (pIterator != m_Clients.end())
+		return pIterator != m_Clients.end() ? pIterator->second : nullptr;
+	}
+
+	/*
+	* Handles a datagram from an unknown sender without allocating anything.
+	* A connect request is answered with a cookie, a challenge answer is checked against the cookies of the current
+	* and the previous time window. Everything else is dropped.
+	*	salt	- Set to the cookie when the answer is valid, it becomes the salt of the new connection
+	*	return	- True if the sender answered a valid cookie
+	*/
+	bool ServerUDP::VerifyHandshake(const IPEndPoint& sender, uint64& salt)
+	{
+		PacketTranscoder::Header header;
+		NetworkPacket::Header packetHeader;
+		const char* pPayload = nullptr;
+
+		if (!m_Transciver.PeekFirstPacket(header, packetHeader, pPayload) || header.Salt == 0)
+			return false;
+
+		const uint64 timeWindow = (uint64)EngineLoop::GetTimeSinceStart().AsSeconds() / COOKIE_WINDOW_SECONDS;
+
+		if (packetHeader.Type == NetworkPacket::TYPE_CONNNECT)
 		{
-			newConnection = false;
-			return pIterator->second;
+			SendCookie(sender, NetworkChallenge::ComputeCookie(m_CookieKey, sender, header.Salt, timeWindow));
 		}
-		else
+		else if (packetHeader.Type == NetworkPacket::TYPE_CHALLENGE && packetHeader.Size >= sizeof(NetworkPacket::Header) + sizeof(uint64))
 		{
-			newConnection = true;
-			return DBG_NEW ClientUDPRemote(m_PacketsPerClient, m_MaxTries, sender, this);
+			uint64 answer = 0;
+			memcpy(&answer, pPayload, sizeof(answer));
+
+			const uint64 windows[2] = { timeWindow, timeWindow > 0 ? timeWindow - 1 : timeWindow };
+			for (uint64 window : windows)
+			{
+				uint64 cookie = NetworkChallenge::ComputeCookie(m_CookieKey, sender, header.Salt, window);
+				if (answer == NetworkChallenge::Compute(header.Salt, cookie))
+				{
+					salt = cookie;
+					return true;
+				}
+			}
 		}
+
+		return false;
+	}
+
+	/*
+	* Sends a single TYPE_CHALLENGE message with the cookie as salt. The reply is no larger than the connect request
+	* so the server can not be used to amplify traffic
+	*/
+	void ServerUDP::SendCookie(const IPEndPoint& sender, uint64 cookie)
+	{
+		char pBuffer[sizeof(PacketTranscoder::Header) + sizeof(NetworkPacket::Header)];
+
+		PacketTranscoder::Header header;
+		header.Size		= sizeof(pBuffer);
+		header.Salt		= cookie;
+		header.Packets	= 1;
+
+		NetworkPacket::Header packetHeader;
+		packetHeader.Size = sizeof(NetworkPacket::Header);
+		packetHeader.Type = NetworkPacket::TYPE_CHALLENGE;
+
+		memcpy(pBuffer, &header, sizeof(header));
+		memcpy(pBuffer + sizeof(header), &packetHeader, sizeof(packetHeader));
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		if (m_pSocket)
+			m_Transciver.SendDatagram(pBuffer, sizeof(pBuffer), sender);
 	}
 
 	void ServerUDP::OnClientDisconnected(ClientUDPRemote* client, bool sendDisconnectPacket)
@@ -224,6 +323,8 @@ namespace LambdaEngine
 		if(sendDisconnectPacket)
 			SendDisconnect(client);
 
+		m_Transciver.RemoveSimulatedLink(client->GetEndPoint());
+
 		std::scoped_lock<SpinLock> lock(m_LockClients);
 		m_Clients.erase(client->GetEndPoint());
 	}
@@ -256,7 +357,7 @@ namespace LambdaEngine
 		Flush();
 	}
 
-	ServerUDP* ServerUDP::Create(IServerUDPHandler* pHandler, uint8 maxClients, uint16 packetPoolSize, uint8 maximumTries)
+	ServerUDP* ServerUDP::Create(IServerUDPHandler* pHandler, uint16 maxClients, uint16 packetPoolSize, uint8 maximumTries)
 	{
 		return DBG_NEW ServerUDP(pHandler, maxClients, packetPoolSize, maximumTries);
 	}
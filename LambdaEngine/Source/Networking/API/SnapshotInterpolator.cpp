@@ -0,0 +1,265 @@
+#include "Networking/API/SnapshotInterpolator.h"
+#include "Networking/API/NetworkStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <emmintrin.h>
+
+namespace LambdaEngine
+{
+	constexpr const float64 JITTER_SMOOTHING		= 1.0 / 16.0;	// Same gain as RFC 3550
+	constexpr const float64 DELAY_INCREASE_RATE		= 0.2;			// Seconds of delay per second, raised quickly so snapshots stop arriving late
+	constexpr const float64 DELAY_DECREASE_RATE		= 0.05;
+	constexpr const float64 NANOSECONDS				= 1000.0 * 1000.0 * 1000.0;
+
+	/*
+	* Dot product of two four component vectors, the result is in all components
+	*/
+	static FORCEINLINE __m128 Dot4(__m128 a, __m128 b)
+	{
+		__m128 product	= _mm_mul_ps(a, b);
+		__m128 sum		= _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	SnapshotInterpolator::SnapshotInterpolator(const SnapshotInterpolatorDesc& desc) :
+		m_Desc(desc)
+	{
+		Reset();
+	}
+
+	void SnapshotInterpolator::AddSnapshot(uint32 entityID, Timestamp snapshotTime, const NetworkTransform& transform, Timestamp arrivalTime)
+	{
+		const uint64 time = snapshotTime.AsNanoSeconds();
+
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		// Entities in the same snapshot arrive together, only the first of them is a new sample of the transit time
+		if (time != m_LastSnapshotTime)
+		{
+			const int64 transitTime = int64(arrivalTime.AsNanoSeconds()) - int64(time);
+			if (m_LastSnapshotTime != 0)
+			{
+				const float64 difference = std::abs(float64(transitTime - m_LastTransitTime)) / NANOSECONDS;
+				m_Jitter += (difference - m_Jitter) * JITTER_SMOOTHING;
+			}
+
+			m_LastTransitTime	= transitTime;
+			m_LastSnapshotTime	= time;
+		}
+
+		SnapshotBuffer& buffer = m_Entities[entityID];
+
+		// Snapshots older than the oldest one in a full buffer can not be used anymore
+		if (buffer.Count == SNAPSHOT_BUFFER_SIZE)
+		{
+			if (time <= GetSnapshot(buffer, 0).Time)
+				return;
+
+			buffer.Head = (buffer.Head + 1) % SNAPSHOT_BUFFER_SIZE;
+			buffer.Count--;
+		}
+
+		// Usually the snapshot is the newest and the loop does not run, late snapshots are moved into place
+		uint32 index = buffer.Count;
+		while (index > 0 && GetSnapshot(buffer, index - 1).Time >= time)
+		{
+			if (GetSnapshot(buffer, index - 1).Time == time)
+			{
+				// Already received, close the gap that was opened for it
+				for (uint32 i = index; i < buffer.Count; i++)
+					GetSnapshot(buffer, i) = GetSnapshot(buffer, i + 1);
+				return;
+			}
+
+			GetSnapshot(buffer, index) = GetSnapshot(buffer, index - 1);
+			index--;
+		}
+
+		Snapshot& snapshot	= GetSnapshot(buffer, index);
+		snapshot.Time		= time;
+		snapshot.Transform	= transform;
+		buffer.Count++;
+	}
+
+	void SnapshotInterpolator::RemoveEntity(uint32 entityID)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Entities.erase(entityID);
+	}
+
+	void SnapshotInterpolator::Tick(Timestamp delta, Timestamp serverTime, const NetworkStatistics* pStatistics)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		float64 jitter = m_Jitter;
+		if (pStatistics)
+			jitter = std::max(jitter, pStatistics->GetRTTVariance().AsSeconds() / 2.0);
+
+		const float64 interval		= 1.0 / float64(m_Desc.SnapshotRate);
+		const float64 targetDelay	= std::clamp(interval + float64(m_Desc.JitterMultiplier) * jitter, float64(m_Desc.MinDelayMS) / 1000.0, float64(m_Desc.MaxDelayMS) / 1000.0);
+
+		if (m_RenderTime == 0)
+		{
+			m_PlayoutDelay = targetDelay;
+		}
+		else if (targetDelay > m_PlayoutDelay)
+		{
+			m_PlayoutDelay = std::min(m_PlayoutDelay + delta.AsSeconds() * DELAY_INCREASE_RATE, targetDelay);
+		}
+		else
+		{
+			m_PlayoutDelay = std::max(m_PlayoutDelay - delta.AsSeconds() * DELAY_DECREASE_RATE, targetDelay);
+		}
+
+		const uint64 delay		= uint64(m_PlayoutDelay * NANOSECONDS);
+		const uint64 renderTime	= serverTime.AsNanoSeconds() > delay ? serverTime.AsNanoSeconds() - delay : 0;
+
+		// The clock estimate and the delay are both slewed, this only keeps rounding from moving the render time back
+		m_RenderTime = std::max(m_RenderTime, renderTime);
+	}
+
+	bool SnapshotInterpolator::Interpolate(uint32 entityID, NetworkTransform& transform)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		auto entityIt = m_Entities.find(entityID);
+		if (entityIt == m_Entities.end())
+			return false;
+
+		NetworkTransform from;
+		NetworkTransform to;
+		float32 alpha;
+		if (!Sample(entityIt->second, from, to, alpha))
+			return false;
+
+		InterpolateTransforms(&from, &to, &alpha, &transform, 1);
+		return true;
+	}
+
+	void SnapshotInterpolator::InterpolateAll(TArray<uint32>& entityIDs, TArray<NetworkTransform>& transforms)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		entityIDs.Clear();
+		m_From.Resize(uint32(m_Entities.size()));
+		m_To.Resize(uint32(m_Entities.size()));
+		m_Alphas.Resize(uint32(m_Entities.size()));
+
+		uint32 count = 0;
+		for (auto& entity : m_Entities)
+		{
+			if (Sample(entity.second, m_From[count], m_To[count], m_Alphas[count]))
+			{
+				entityIDs.PushBack(entity.first);
+				count++;
+			}
+		}
+
+		transforms.Resize(count);
+		InterpolateTransforms(m_From.GetData(), m_To.GetData(), m_Alphas.GetData(), transforms.GetData(), count);
+	}
+
+	Timestamp SnapshotInterpolator::GetRenderTime() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp(m_RenderTime);
+	}
+
+	Timestamp SnapshotInterpolator::GetPlayoutDelay() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp::Seconds(m_PlayoutDelay);
+	}
+
+	Timestamp SnapshotInterpolator::GetJitter() const
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		return Timestamp::Seconds(m_Jitter);
+	}
+
+	void SnapshotInterpolator::Reset()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_Entities.clear();
+		m_RenderTime		= 0;
+		m_PlayoutDelay		= 1.0 / float64(m_Desc.SnapshotRate);
+		m_Jitter			= 0.0;
+		m_LastTransitTime	= 0;
+		m_LastSnapshotTime	= 0;
+	}
+
+	/*
+	* Finds the snapshots on each side of the render time and drops the ones before them
+	*/
+	bool SnapshotInterpolator::Sample(SnapshotBuffer& buffer, NetworkTransform& from, NetworkTransform& to, float32& alpha)
+	{
+		if (buffer.Count == 0)
+			return false;
+
+		const Snapshot& oldest = GetSnapshot(buffer, 0);
+		if (buffer.Count == 1 || m_RenderTime <= oldest.Time)
+		{
+			from	= oldest.Transform;
+			to		= oldest.Transform;
+			alpha	= 0.0f;
+			return true;
+		}
+
+		uint32 next = 1;
+		while (next < buffer.Count && GetSnapshot(buffer, next).Time <= m_RenderTime)
+			next++;
+
+		uint64 renderTime = m_RenderTime;
+		if (next == buffer.Count)
+		{
+			// Past the newest snapshot, extrapolated from the last two
+			next--;
+			renderTime = std::min(renderTime, GetSnapshot(buffer, next).Time + uint64(float64(m_Desc.MaxExtrapolationMS) * 1000.0 * 1000.0));
+		}
+
+		const uint32 dropCount = next - 1;
+		buffer.Head		= (buffer.Head + dropCount) % SNAPSHOT_BUFFER_SIZE;
+		buffer.Count	-= dropCount;
+
+		const Snapshot& first	= GetSnapshot(buffer, 0);
+		const Snapshot& second	= GetSnapshot(buffer, 1);
+		from	= first.Transform;
+		to		= second.Transform;
+		alpha	= float32(float64(renderTime - first.Time) / float64(second.Time - first.Time));
+		return true;
+	}
+
+	void SnapshotInterpolator::InterpolateTransforms(const NetworkTransform* pFrom, const NetworkTransform* pTo, const float32* pAlphas, NetworkTransform* pResult, uint32 count)
+	{
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 signBit	= _mm_set1_ps(-0.0f);
+		const __m128 epsilon	= _mm_set1_ps(1.0e-12f);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const __m128 alpha = _mm_set1_ps(pAlphas[i]);
+
+			const __m128 fromPosition	= _mm_loadu_ps(&pFrom[i].Position.x);
+			const __m128 toPosition		= _mm_loadu_ps(&pTo[i].Position.x);
+			const __m128 position		= _mm_add_ps(fromPosition, _mm_mul_ps(_mm_sub_ps(toPosition, fromPosition), alpha));
+
+			// q and -q are the same rotation, the one closest to the first rotation gives the shortest path
+			const __m128 fromRotation	= _mm_loadu_ps(reinterpret_cast<const float32*>(&pFrom[i].Rotation));
+			__m128 toRotation			= _mm_loadu_ps(reinterpret_cast<const float32*>(&pTo[i].Rotation));
+			toRotation = _mm_xor_ps(toRotation, _mm_and_ps(_mm_cmplt_ps(Dot4(fromRotation, toRotation), zero), signBit));
+
+			__m128 rotation = _mm_add_ps(fromRotation, _mm_mul_ps(_mm_sub_ps(toRotation, fromRotation), alpha));
+			rotation = _mm_div_ps(rotation, _mm_sqrt_ps(_mm_max_ps(Dot4(rotation, rotation), epsilon)));
+
+			_mm_storeu_ps(&pResult[i].Position.x, position);
+			_mm_storeu_ps(reinterpret_cast<float32*>(&pResult[i].Rotation), rotation);
+		}
+	}
+
+	SnapshotInterpolator::Snapshot& SnapshotInterpolator::GetSnapshot(SnapshotBuffer& buffer, uint32 index)
+	{
+		return buffer.Snapshots[(buffer.Head + index) % SNAPSHOT_BUFFER_SIZE];
+	}
+}
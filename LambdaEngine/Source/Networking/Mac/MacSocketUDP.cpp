@@ -51,6 +51,8 @@ namespace LambdaEngine
 
 			if (IsClosed() && !IsNonBlocking())
 				return false;
+			else if (IsNonBlocking() && (error == EWOULDBLOCK || error == EAGAIN))
+				return false;
 			else if (error == ECONNREFUSED)
 				return true;
 
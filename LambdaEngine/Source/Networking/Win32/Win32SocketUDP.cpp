@@ -42,6 +42,8 @@ namespace LambdaEngine
 		{
 			if (IsClosed() && !IsNonBlocking())
 				return false;
+			else if (IsNonBlocking() && WSAGetLastError() == WSAEWOULDBLOCK)
+				return false;
 			else if (WSAGetLastError() == WSAECONNRESET)
 				return true;
 
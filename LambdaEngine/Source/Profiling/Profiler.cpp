@@ -0,0 +1,354 @@
+#include "Profiling/Profiler.h"
+
+#include "Log/Log.h"
+
+#include "Containers/TArray.h"
+
+#include "Time/API/PlatformTime.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include <atomic>
+#include <thread>
+#include <stdio.h>
+
+namespace LambdaEngine
+{
+#if LAMBDA_ENABLE_PROFILER
+	constexpr const uint32 PROFILER_ZONES_PER_THREAD	= 1 << 16;
+	constexpr const uint32 PROFILER_ZONE_MASK			= PROFILER_ZONES_PER_THREAD - 1;
+
+	struct ProfilerZone
+	{
+		const char*	pName	= nullptr;
+		uint64		Begin	= 0;
+		uint64		End		= 0;
+	};
+
+	/*
+	* Single producer ring buffer, only the owning thread writes zones. The write index is published
+	* with release semantics so that the exporting thread sees complete zones. IsWriting is set while
+	* a zone is written, EndCapture and Release wait for it so that no thread writes during an export
+	*/
+	struct ProfilerThreadBuffer
+	{
+		ProfilerZone			Zones[PROFILER_ZONES_PER_THREAD];
+		std::atomic_uint64_t	WriteIndex		= 0;
+		std::atomic_bool		IsWriting		= false;
+		std::atomic_bool		IsRegistered	= true;		// In g_ProfilerThreadBuffers, cleared by Release
+		bool					IsOwned			= true;		// The thread is alive, cleared when it exits
+		const char*				pThreadName		= nullptr;
+		uint32					ThreadID		= 0;
+	};
+
+	static SpinLock							g_ProfilerLock;
+	static TArray<ProfilerThreadBuffer*>	g_ProfilerThreadBuffers;
+	static std::atomic_bool					g_ProfilerIsCapturing	= false;
+	static std::atomic_uint64_t				g_ProfilerCaptureBegin	= 0;
+	static std::atomic_uint64_t				g_ProfilerCaptureEnd	= 0;
+	static uint32							g_ProfilerThreadCount	= 0;
+
+	/*
+	* Owns the ring buffer of a thread. The buffer is only allocated when the thread records its first zone during a
+	* capture, so threads that are never profiled cost nothing. When the thread exits its buffer is kept until the
+	* next capture begins so that its zones can still be exported, unless the profiler is already released
+	*/
+	struct ProfilerThreadOwner
+	{
+		ProfilerThreadBuffer*	pBuffer		= nullptr;
+		const char*				pThreadName	= nullptr;
+
+		~ProfilerThreadOwner()
+		{
+			if (pBuffer)
+			{
+				std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+				pBuffer->IsOwned = false;
+
+				if (!pBuffer->IsRegistered)
+				{
+					SAFEDELETE(pBuffer);
+				}
+			}
+		}
+	};
+
+	static thread_local ProfilerThreadOwner t_ProfilerThread;
+
+	static ProfilerThreadBuffer* GetThreadBuffer()
+	{
+		ProfilerThreadOwner& owner = t_ProfilerThread;
+		if (owner.pBuffer && owner.pBuffer->IsRegistered.load(std::memory_order_acquire))
+		{
+			return owner.pBuffer;
+		}
+
+		std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+
+		// Release unregisters the buffers of threads that are still alive instead of deleting them
+		if (!owner.pBuffer)
+		{
+			owner.pBuffer = DBG_NEW ProfilerThreadBuffer();
+			owner.pBuffer->ThreadID		= g_ProfilerThreadCount++;
+			owner.pBuffer->pThreadName	= owner.pThreadName;
+		}
+
+		owner.pBuffer->IsRegistered = true;
+		g_ProfilerThreadBuffers.PushBack(owner.pBuffer);
+		return owner.pBuffer;
+	}
+
+	/*
+	* Waits for threads that are writing a zone, called after g_ProfilerIsCapturing is cleared with g_ProfilerLock held
+	*/
+	static void WaitForWriters()
+	{
+		for (ProfilerThreadBuffer* pBuffer : g_ProfilerThreadBuffers)
+		{
+			while (pBuffer->IsWriting.load(std::memory_order_seq_cst))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	static void WriteEscapedString(FILE* pFile, const char* pString)
+	{
+		for (const char* pCurrent = pString; *pCurrent != '\0'; pCurrent++)
+		{
+			if (*pCurrent == '"' || *pCurrent == '\\')
+			{
+				fputc('\\', pFile);
+			}
+
+			fputc(*pCurrent, pFile);
+		}
+	}
+
+	/*
+	* ProfileScope
+	*/
+	ProfileScope::ProfileScope(const char* pName)
+		: m_pName(pName),
+		m_Begin(0)
+	{
+		if (g_ProfilerIsCapturing.load(std::memory_order_relaxed))
+		{
+			m_Begin = PlatformTime::GetPerformanceCounter();
+		}
+	}
+
+	ProfileScope::~ProfileScope()
+	{
+		if (m_Begin != 0)
+		{
+			Profiler::RecordZone(m_pName, m_Begin, PlatformTime::GetPerformanceCounter());
+		}
+	}
+
+	/*
+	* Profiler
+	*/
+	void Profiler::BeginCapture()
+	{
+		{
+			// The buffers of threads that have exited only had to be kept for the export of the last capture
+			std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+			for (uint32 i = 0; i < g_ProfilerThreadBuffers.GetSize();)
+			{
+				ProfilerThreadBuffer* pBuffer = g_ProfilerThreadBuffers[i];
+				if (!pBuffer->IsOwned)
+				{
+					SAFEDELETE(pBuffer);
+					g_ProfilerThreadBuffers.Erase(g_ProfilerThreadBuffers.Begin() + i);
+				}
+				else
+				{
+					i++;
+				}
+			}
+		}
+
+		g_ProfilerCaptureBegin	= PlatformTime::GetPerformanceCounter();
+		g_ProfilerCaptureEnd	= UINT64_MAX;
+		g_ProfilerIsCapturing	= true;
+
+		LOG_INFO("[Profiler]: Capture started");
+	}
+
+	void Profiler::EndCapture()
+	{
+		g_ProfilerIsCapturing	= false;
+		g_ProfilerCaptureEnd	= PlatformTime::GetPerformanceCounter();
+
+		{
+			std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+			WaitForWriters();
+		}
+
+		LOG_INFO("[Profiler]: Capture stopped");
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return g_ProfilerIsCapturing;
+	}
+
+	bool Profiler::ExportChromeTrace(const String& filepath)
+	{
+		if (g_ProfilerIsCapturing)
+		{
+			LOG_WARNING("[Profiler]: Failed to export '%s', the capture has to be ended first", filepath.c_str());
+			return false;
+		}
+
+		FILE* pFile = fopen(filepath.c_str(), "w");
+		if (!pFile)
+		{
+			LOG_ERROR("[Profiler]: Failed to open '%s'", filepath.c_str());
+			return false;
+		}
+
+		const uint64	captureBegin	= g_ProfilerCaptureBegin;
+		const uint64	captureEnd		= g_ProfilerCaptureEnd;
+		const float64	toMicroSeconds	= 1000.0 * 1000.0 / float64(PlatformTime::GetPerformanceFrequency());
+
+		fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", pFile);
+
+		bool	isFirstEvent	= true;
+		uint32	zoneCount		= 0;
+
+		std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+		for (ProfilerThreadBuffer* pBuffer : g_ProfilerThreadBuffers)
+		{
+			if (pBuffer->pThreadName)
+			{
+				fprintf(pFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", isFirstEvent ? "" : ",", pBuffer->ThreadID);
+				WriteEscapedString(pFile, pBuffer->pThreadName);
+				fputs("\"}}", pFile);
+
+				isFirstEvent = false;
+			}
+
+			// Only the newest zones survive when a thread has wrapped around its ring buffer
+			const uint64 writeIndex = pBuffer->WriteIndex.load(std::memory_order_acquire);
+			const uint64 readIndex	= writeIndex > PROFILER_ZONES_PER_THREAD ? writeIndex - PROFILER_ZONES_PER_THREAD : 0;
+			for (uint64 index = readIndex; index < writeIndex; index++)
+			{
+				const ProfilerZone& zone = pBuffer->Zones[index & PROFILER_ZONE_MASK];
+				if (zone.Begin < captureBegin || zone.End > captureEnd)
+				{
+					continue;
+				}
+
+				const float64 timestamp	= float64(zone.Begin - captureBegin) * toMicroSeconds;
+				const float64 duration	= float64(zone.End - zone.Begin) * toMicroSeconds;
+
+				fprintf(pFile, "%s{\"name\":\"", isFirstEvent ? "" : ",");
+				WriteEscapedString(pFile, zone.pName);
+				fprintf(pFile, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", pBuffer->ThreadID, timestamp, duration);
+
+				isFirstEvent = false;
+				zoneCount++;
+			}
+		}
+
+		fputs("]}", pFile);
+		fclose(pFile);
+
+		LOG_INFO("[Profiler]: Exported %u zones to '%s'", zoneCount, filepath.c_str());
+		return true;
+	}
+
+	void Profiler::SetThreadName(const char* pName)
+	{
+		ProfilerThreadOwner& owner = t_ProfilerThread;
+		owner.pThreadName = pName;
+
+		if (owner.pBuffer)
+		{
+			std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+			owner.pBuffer->pThreadName = pName;
+		}
+	}
+
+	void Profiler::RecordZone(const char* pName, uint64 begin, uint64 end)
+	{
+		if (!g_ProfilerIsCapturing.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		ProfilerThreadBuffer* pBuffer = GetThreadBuffer();
+
+		// The flag is set before the capture is checked again, so EndCapture either waits for this zone or it is skipped
+		pBuffer->IsWriting.store(true, std::memory_order_seq_cst);
+		if (g_ProfilerIsCapturing.load(std::memory_order_seq_cst))
+		{
+			const uint64 writeIndex = pBuffer->WriteIndex.load(std::memory_order_relaxed);
+			ProfilerZone& zone = pBuffer->Zones[writeIndex & PROFILER_ZONE_MASK];
+			zone.pName	= pName;
+			zone.Begin	= begin;
+			zone.End	= end;
+
+			pBuffer->WriteIndex.store(writeIndex + 1, std::memory_order_release);
+		}
+		pBuffer->IsWriting.store(false, std::memory_order_release);
+	}
+
+	void Profiler::Release()
+	{
+		g_ProfilerIsCapturing = false;
+
+		std::scoped_lock<SpinLock> lock(g_ProfilerLock);
+		WaitForWriters();
+
+		// Threads that are still alive keep their buffer and delete it when they exit
+		for (ProfilerThreadBuffer* pBuffer : g_ProfilerThreadBuffers)
+		{
+			pBuffer->IsRegistered = false;
+			if (!pBuffer->IsOwned)
+			{
+				SAFEDELETE(pBuffer);
+			}
+		}
+
+		g_ProfilerThreadBuffers.Clear();
+	}
+#else
+	void Profiler::BeginCapture()
+	{
+	}
+
+	void Profiler::EndCapture()
+	{
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return false;
+	}
+
+	bool Profiler::ExportChromeTrace(const String& filepath)
+	{
+		UNREFERENCED_VARIABLE(filepath);
+		return false;
+	}
+
+	void Profiler::SetThreadName(const char* pName)
+	{
+		UNREFERENCED_VARIABLE(pName);
+	}
+
+	void Profiler::RecordZone(const char* pName, uint64 begin, uint64 end)
+	{
+		UNREFERENCED_VARIABLE(pName);
+		UNREFERENCED_VARIABLE(begin);
+		UNREFERENCED_VARIABLE(end);
+	}
+
+	void Profiler::Release()
+	{
+	}
+#endif
+}
@@ -286,6 +286,8 @@ namespace LambdaEngine
 		uint32 windowWidth	= window->GetWidth();
 		uint32 windowHeight = window->GetHeight();
 
+		m_InputMutex.lock();
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.DeltaTime = float32(delta.AsSeconds());
 
@@ -301,6 +303,8 @@ namespace LambdaEngine
 
 		ImGui::EndFrame();
 		ImGui::Render();
+
+		m_InputMutex.unlock();
 	}
 
 	void ImGuiRenderer::Render(CommandAllocator* pCommandAllocator, CommandList* pCommandList, uint32 modFrameIndex, uint32 backBufferIndex, CommandList** ppExecutionStage)
@@ -527,6 +531,8 @@ namespace LambdaEngine
 
 	void ImGuiRenderer::OnMouseMoved(int32 x, int32 y)
 	{
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.MousePos = ImVec2(float32(x), float32(y));
 	}
@@ -535,18 +541,24 @@ namespace LambdaEngine
 	{
 		UNREFERENCED_VARIABLE(modifierMask);
 
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.MouseDown[button - 1] = true;
 	}
 
 	void ImGuiRenderer::OnButtonReleased(EMouseButton button)
 	{
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.MouseDown[button - 1] = false;
 	}
 
 	void ImGuiRenderer::OnMouseScrolled(int32 deltaX, int32 deltaY)
 	{
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.MouseWheelH	+= (float32)deltaX;
 		io.MouseWheel	+= (float32)deltaY;
@@ -557,6 +569,8 @@ namespace LambdaEngine
 		UNREFERENCED_VARIABLE(isRepeat);
 		UNREFERENCED_VARIABLE(modifierMask);
 
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.KeysDown[key] = true;
 		io.KeyCtrl	= io.KeysDown[EKey::KEY_LEFT_CONTROL]	|| io.KeysDown[EKey::KEY_RIGHT_CONTROL];
@@ -567,6 +581,8 @@ namespace LambdaEngine
 
 	void ImGuiRenderer::OnKeyReleased(EKey key)
 	{
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.KeysDown[key] = false;
 		io.KeyCtrl	= io.KeysDown[EKey::KEY_LEFT_CONTROL]	|| io.KeysDown[EKey::KEY_RIGHT_CONTROL];
@@ -577,6 +593,8 @@ namespace LambdaEngine
 
 	void ImGuiRenderer::OnKeyTyped(uint32 character)
 	{
+		std::scoped_lock<std::mutex> lock(m_InputMutex);
+
 		ImGuiIO& io = ImGui::GetIO();
 		io.AddInputCharacter(character);
 	}
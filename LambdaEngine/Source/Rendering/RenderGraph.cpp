@@ -19,6 +19,7 @@
 #include "Rendering/Core/API/Shader.h"
 
 #include "Rendering/RenderSystem.h"
+#include "Rendering/RenderThread.h"
 #include "Rendering/PipelineStateManager.h"
 
 #include "Game/Scene.h"
@@ -751,6 +752,18 @@ namespace LambdaEngine
 	}
 
 	void RenderGraph::OnWindowResized(TSharedRef<Window> window, uint16 width, uint16 height, EResizeType type)
+	{
+		UNREFERENCED_VARIABLE(window);
+		UNREFERENCED_VARIABLE(type);
+
+		// The render thread may be executing the graph, the size reaches it through the frame packet instead
+		if (!RenderThread::IsRunning())
+		{
+			SetWindowSize(width, height);
+		}
+	}
+
+	void RenderGraph::SetWindowSize(uint16 width, uint16 height)
 	{
 		m_WindowWidth	= (float32)width;
 		m_WindowHeight	= (float32)height;
@@ -0,0 +1,170 @@
+#include "Rendering/RenderThread.h"
+
+#include "Log/Log.h"
+
+#include "Profiling/Profiler.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace LambdaEngine
+{
+	static std::thread				g_Thread;
+	static std::mutex				g_Mutex;
+	static std::condition_variable	g_Condition;
+	static RenderFunc				g_RenderFunc;
+	static FramePacket				g_Packets[2];
+	static uint32					g_GamePacketIndex	= 0;
+	static bool						g_PacketSubmitted	= false;
+	static bool						g_IsRendering		= false;
+	static bool						g_ShouldExit		= false;
+	static bool						g_IsRunning			= false;
+
+	static void RunRenderThread()
+	{
+		PROFILE_THREAD("Render Thread");
+
+		for (;;)
+		{
+			uint32 renderPacketIndex = 0;
+			{
+				std::unique_lock<std::mutex> lock(g_Mutex);
+				g_Condition.wait(lock, [] { return g_PacketSubmitted || g_ShouldExit; });
+
+				if (!g_PacketSubmitted)
+				{
+					break;
+				}
+
+				renderPacketIndex	= g_GamePacketIndex ^ 1;
+				g_PacketSubmitted	= false;
+				g_IsRendering		= true;
+			}
+
+			{
+				PROFILE_SCOPE("RenderThread::Render");
+				g_RenderFunc(g_Packets[renderPacketIndex]);
+			}
+
+			{
+				std::scoped_lock<std::mutex> lock(g_Mutex);
+				g_IsRendering = false;
+			}
+
+			g_Condition.notify_all();
+		}
+	}
+
+	/*
+	* FramePacket
+	*/
+	void FramePacket::ApplyToScene(Scene* pScene) const
+	{
+		pScene->UpdateCamera(Camera);
+
+		if (HasDirectionalLight)
+		{
+			pScene->SetDirectionalLight(DirectionalLight);
+		}
+
+		for (const FramePacketTransform& transform : DirtyTransforms)
+		{
+			pScene->UpdateTransform(transform.InstanceIndex, transform.Transform);
+		}
+	}
+
+	void FramePacket::Reset()
+	{
+		HasDirectionalLight	= false;
+		HasWindowSize		= false;
+		DirtyTransforms.Clear();
+	}
+
+	/*
+	* RenderThread
+	*/
+	bool RenderThread::Init(const RenderFunc& renderFunc)
+	{
+		VALIDATE(!g_IsRunning);
+
+		g_RenderFunc		= renderFunc;
+		g_GamePacketIndex	= 0;
+		g_PacketSubmitted	= false;
+		g_IsRendering		= false;
+		g_ShouldExit		= false;
+		g_Packets[0].Reset();
+		g_Packets[1].Reset();
+
+		g_Thread	= std::thread(RunRenderThread);
+		g_IsRunning	= true;
+
+		LOG_INFO("[RenderThread]: Started");
+		return true;
+	}
+
+	void RenderThread::Release()
+	{
+		if (!g_IsRunning)
+		{
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(g_Mutex);
+			g_Condition.wait(lock, [] { return !g_PacketSubmitted && !g_IsRendering; });
+			g_ShouldExit = true;
+		}
+
+		g_Condition.notify_all();
+		g_Thread.join();
+
+		g_RenderFunc	= nullptr;
+		g_IsRunning		= false;
+	}
+
+	void RenderThread::Submit(Timestamp delta)
+	{
+		VALIDATE(g_IsRunning);
+
+		PROFILE_FUNCTION();
+
+		{
+			// The render thread is still using the other packet until it is done with the previous frame
+			std::unique_lock<std::mutex> lock(g_Mutex);
+			g_Condition.wait(lock, [] { return !g_PacketSubmitted && !g_IsRendering; });
+
+			FramePacket& submittedPacket	= g_Packets[g_GamePacketIndex];
+			submittedPacket.Delta			= delta;
+
+			FramePacket& nextPacket	= g_Packets[g_GamePacketIndex ^ 1];
+			nextPacket.Reset();
+			nextPacket.Camera		= submittedPacket.Camera;
+			nextPacket.FrameIndex	= submittedPacket.FrameIndex + 1;
+
+			g_GamePacketIndex	^= 1;
+			g_PacketSubmitted	= true;
+		}
+
+		g_Condition.notify_all();
+	}
+
+	void RenderThread::Flush()
+	{
+		if (g_IsRunning)
+		{
+			std::unique_lock<std::mutex> lock(g_Mutex);
+			g_Condition.wait(lock, [] { return !g_PacketSubmitted && !g_IsRendering; });
+		}
+	}
+
+	FramePacket& RenderThread::GetGamePacket()
+	{
+		return g_Packets[g_GamePacketIndex];
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return g_IsRunning;
+	}
+}
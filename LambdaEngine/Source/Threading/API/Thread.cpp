@@ -21,13 +21,16 @@ namespace LambdaEngine
 
 	}
 
-	void Thread::Wait()
+	void Thread::Wait(Timestamp timeout)
 	{
 		if (m_Thread.get_id() == std::this_thread::get_id())
 		{
 			m_ShouldYeild = true;
 			std::unique_lock<std::mutex> lock(m_Mutex);
-			m_Condition.wait(lock, [this]{ return !m_ShouldYeild.load(); });
+			if (timeout.AsNanoSeconds() == 0)
+				m_Condition.wait(lock, [this]{ return !m_ShouldYeild.load(); });
+			else
+				m_Condition.wait_for(lock, std::chrono::nanoseconds(timeout.AsNanoSeconds()), [this]{ return !m_ShouldYeild.load(); });
 		}
 	}
 
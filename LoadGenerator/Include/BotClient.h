@@ -0,0 +1,105 @@
+#pragma once
+
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+#include "Threading/API/SpinLock.h"
+
+#include "Time/API/Timestamp.h"
+
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/IPacketListener.h"
+#include "Networking/API/IClientUDPHandler.h"
+#include "Networking/API/NetworkConditionSimulator.h"
+
+#include <atomic>
+#include <unordered_map>
+
+namespace LambdaEngine
+{
+	class ClientUDP;
+	class NetworkStatistics;
+}
+
+/*
+* What a bot sends every second once it is connected
+*/
+struct LoadPattern
+{
+	float32	MessagesPerSecond	= 20.0f;
+	float32	ReliableRatio		= 0.2f;	// Share of the messages that are sent reliable
+	uint32	BurstSize			= 0;	// Extra messages sent at once every BurstInterval, 0 disables bursts
+	float32	BurstInterval		= 5.0f;	// Seconds
+	uint16	PayloadSize			= 64;	// Bytes
+};
+
+/*
+* BotClient
+*	A ClientUDP without window or rendering that sends messages according to a LoadPattern. All bots are ticked
+*	from the game thread, and the time from sending a reliable message until it is acked is recorded. The clients are
+*	polled, so the bots share a few worker threads instead of two threads per bot, see LoadGenerator.
+*/
+class BotClient :
+	public LambdaEngine::IClientUDPHandler,
+	public LambdaEngine::IPacketListener
+{
+public:
+	BotClient(uint32 id, const LoadPattern& pattern, bool useLoopback, const LambdaEngine::NetworkConditions& conditions);
+	~BotClient();
+
+	bool Connect(const LambdaEngine::IPEndPoint& ipEndPoint);
+	void Disconnect();
+
+	/*
+	* Sends the messages that are due according to the pattern
+	*/
+	void FixedTick(LambdaEngine::Timestamp delta);
+
+	/*
+	* Receives and sends datagrams, called from a worker thread of the LoadGenerator
+	*	return - True if a datagram was received
+	*/
+	bool Poll();
+
+	bool IsConnected() const;
+	bool IsDisconnected() const;
+	const LambdaEngine::NetworkStatistics* GetStatistics() const;
+
+	uint32 GetMessagesSent() const;
+	uint32 GetReliableMessagesLost() const;
+
+	/*
+	* Moves the delivery times in milliseconds recorded since the last call into latencies
+	*/
+	void TakeDeliveryLatencies(LambdaEngine::TArray<float64>& latencies);
+
+	virtual void OnConnectingUDP(LambdaEngine::IClientUDP* pClient) override;
+	virtual void OnConnectedUDP(LambdaEngine::IClientUDP* pClient) override;
+	virtual void OnDisconnectingUDP(LambdaEngine::IClientUDP* pClient) override;
+	virtual void OnDisconnectedUDP(LambdaEngine::IClientUDP* pClient) override;
+	virtual void OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, LambdaEngine::NetworkPacket* pPacket) override;
+	virtual void OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size) override;
+	virtual void OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType) override;
+	virtual void OnServerFullUDP(LambdaEngine::IClientUDP* pClient) override;
+
+	virtual void OnPacketDelivered(LambdaEngine::NetworkPacket* pPacket) override;
+	virtual void OnPacketResent(LambdaEngine::NetworkPacket* pPacket, uint8 tries) override;
+	virtual void OnPacketMaxTriesReached(LambdaEngine::NetworkPacket* pPacket, uint8 tries) override;
+
+private:
+	void SendLoadMessage(bool reliable);
+
+private:
+	LambdaEngine::ClientUDP* m_pClient;
+	LoadPattern m_Pattern;
+	uint32 m_ID;
+	float64 m_SendAccumulator;
+	float64 m_TimeSinceBurst;
+	std::atomic_uint32_t m_MessagesSent;
+	std::atomic_uint32_t m_ReliableMessagesLost;
+
+	LambdaEngine::SpinLock m_Lock;
+	std::unordered_map<uint32, LambdaEngine::Timestamp> m_ReliableSendTimes;
+	LambdaEngine::TArray<float64> m_DeliveryLatencies;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Game/Game.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+#include "Networking/API/IPEndPoint.h"
+#include "Networking/API/IServerUDPHandler.h"
+
+#include "BotClient.h"
+
+#include <atomic>
+#include <thread>
+
+namespace LambdaEngine
+{
+	class ServerUDP;
+}
+
+/*
+* LoadGenerator
+*	Headless game that connects a number of BotClients to a server and reports RTT, loss and throughput once per
+*	second. With --loopback the server runs in the same process on loopback sockets. The bots are split between a few
+*	worker threads that poll their sockets, so the number of threads does not grow with the number of bots.
+*
+*	Command line:
+*		--clients <count>			Number of bots (Default 100)
+*		--address <ip>				Server address (Default 127.0.0.1)
+*		--port <port>				Server port (Default 4444)
+*		--duration <seconds>		Time to run before the report is written (Default 30)
+*		--connect-rate <count>		Bots that start connecting per second (Default 200)
+*		--bot-threads <count>		Worker threads that poll the bots (Default 2)
+*		--rate <messages>			Messages per second per bot (Default 20)
+*		--reliable <ratio>			Share of reliable messages (Default 0.2)
+*		--burst <count>				Extra messages per burst, 0 disables bursts (Default 0)
+*		--burst-interval <seconds>	Time between bursts (Default 5)
+*		--payload <bytes>			Payload size of every message (Default 64)
+*		--latency <ms> --jitter <ms> --loss <ratio>		Simulated conditions on the bots outgoing traffic
+*		--loopback					Run the server in process on loopback sockets
+*		--json <file>				Where the final report is written (Default loadgen_report.json)
+*/
+class LoadGenerator :
+	public LambdaEngine::Game,
+	public LambdaEngine::IServerUDPHandler
+{
+public:
+	LoadGenerator();
+	~LoadGenerator();
+
+	// Inherited via Game
+	virtual void Tick(LambdaEngine::Timestamp delta)		override;
+	virtual void FixedTick(LambdaEngine::Timestamp delta)	override;
+
+	// Inherited via IServerUDPHandler, used when the server runs in process
+	virtual void OnClientConnected(LambdaEngine::IClientUDP* pClient) override;
+	virtual LambdaEngine::IClientUDPRemoteHandler* CreateClientUDPHandler() override;
+
+private:
+	void ConnectBots(LambdaEngine::Timestamp delta);
+	void RunBotThread(uint32 threadIndex, uint32 threadCount);
+	void StopBotThreads();
+	void Report(bool isFinal);
+	bool WriteJSON(const char* pFilepath) const;
+
+private:
+	LambdaEngine::ServerUDP* m_pServer;
+	LambdaEngine::TArray<BotClient*> m_Bots;
+	LambdaEngine::TArray<std::thread> m_BotThreads;
+	std::atomic_bool m_BotThreadsRunning;
+	LambdaEngine::IPEndPoint m_ServerEndPoint;
+	LambdaEngine::String m_JSONPath;
+	float64 m_Duration;
+	float64 m_ConnectRate;
+	float64 m_ConnectAccumulator;
+	uint32 m_BotsStarted;
+	float64 m_ElapsedTime;
+	float64 m_TimeSinceReport;
+	bool m_IsDone;
+
+	// Totals at the last report, used to calculate the rates of the last interval
+	uint64 m_LastMessagesSent;
+	uint64 m_LastBytesSent;
+	uint64 m_LastBytesReceived;
+
+	// Collected over the whole run for the final report
+	LambdaEngine::TArray<float64> m_AllDeliveryLatencies;
+	LambdaEngine::TArray<float64> m_AllPings;
+	LambdaEngine::TArray<float64> m_MessageRates;
+};
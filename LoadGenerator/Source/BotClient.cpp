@@ -0,0 +1,226 @@
+#include "BotClient.h"
+
+#include "Engine/EngineLoop.h"
+
+#include "Math/Random.h"
+
+#include "Networking/API/ClientUDP.h"
+#include "Networking/API/NetworkPacket.h"
+#include "Networking/API/BinaryEncoder.h"
+#include "Networking/API/NetworkStatistics.h"
+
+#include "Log/Log.h"
+
+constexpr const uint16 BOT_PACKET_TYPE		= 1;
+constexpr const uint16 BOT_PACKET_POOL_SIZE	= 512;
+constexpr const uint8 BOT_MAXIMUM_TRIES		= 10;
+
+BotClient::BotClient(uint32 id, const LoadPattern& pattern, bool useLoopback, const LambdaEngine::NetworkConditions& conditions) :
+	m_pClient(nullptr),
+	m_Pattern(pattern),
+	m_ID(id),
+	m_SendAccumulator(0.0),
+	m_TimeSinceBurst(0.0),
+	m_MessagesSent(0),
+	m_ReliableMessagesLost(0)
+{
+	using namespace LambdaEngine;
+
+	m_pClient = ClientUDP::Create(this, BOT_PACKET_POOL_SIZE, BOT_MAXIMUM_TRIES);
+	m_pClient->SetUseLoopback(useLoopback);
+	m_pClient->SetPolled(true);
+	m_pClient->SetSimulatedConditions(conditions);
+
+	// Spread the bursts of the bots over the interval
+	m_TimeSinceBurst = Random::Float32(0.0f, m_Pattern.BurstInterval);
+}
+
+BotClient::~BotClient()
+{
+	m_pClient->Release();
+}
+
+bool BotClient::Connect(const LambdaEngine::IPEndPoint& ipEndPoint)
+{
+	return m_pClient->Connect(ipEndPoint);
+}
+
+void BotClient::Disconnect()
+{
+	m_pClient->Disconnect();
+}
+
+void BotClient::FixedTick(LambdaEngine::Timestamp delta)
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	const float64 seconds = delta.AsSeconds();
+
+	m_SendAccumulator += seconds * m_Pattern.MessagesPerSecond;
+	while (m_SendAccumulator >= 1.0)
+	{
+		SendLoadMessage(LambdaEngine::Random::Float32() < m_Pattern.ReliableRatio);
+		m_SendAccumulator -= 1.0;
+	}
+
+	if (m_Pattern.BurstSize > 0)
+	{
+		m_TimeSinceBurst += seconds;
+		if (m_TimeSinceBurst >= m_Pattern.BurstInterval)
+		{
+			for (uint32 i = 0; i < m_Pattern.BurstSize; i++)
+			{
+				SendLoadMessage(LambdaEngine::Random::Float32() < m_Pattern.ReliableRatio);
+			}
+			m_TimeSinceBurst = 0.0;
+		}
+	}
+}
+
+bool BotClient::Poll()
+{
+	return m_pClient->Poll();
+}
+
+bool BotClient::IsConnected() const
+{
+	return m_pClient->GetState() == LambdaEngine::STATE_CONNECTED;
+}
+
+bool BotClient::IsDisconnected() const
+{
+	return m_pClient->GetState() == LambdaEngine::STATE_DISCONNECTED;
+}
+
+const LambdaEngine::NetworkStatistics* BotClient::GetStatistics() const
+{
+	return m_pClient->GetStatistics();
+}
+
+uint32 BotClient::GetMessagesSent() const
+{
+	return m_MessagesSent;
+}
+
+uint32 BotClient::GetReliableMessagesLost() const
+{
+	return m_ReliableMessagesLost;
+}
+
+void BotClient::TakeDeliveryLatencies(LambdaEngine::TArray<float64>& latencies)
+{
+	std::scoped_lock<LambdaEngine::SpinLock> lock(m_Lock);
+	for (float64 latency : m_DeliveryLatencies)
+	{
+		latencies.PushBack(latency);
+	}
+	m_DeliveryLatencies.Clear();
+}
+
+void BotClient::SendLoadMessage(bool reliable)
+{
+	using namespace LambdaEngine;
+
+	static const char s_Payload[MAXIMUM_PACKET_SIZE] = { };
+
+	NetworkPacket* pPacket = m_pClient->GetFreePacket(BOT_PACKET_TYPE);
+	BinaryEncoder encoder(pPacket);
+	encoder.WriteUInt32(m_ID);
+	encoder.WriteBuffer(s_Payload, m_Pattern.PayloadSize);
+
+	if (reliable)
+	{
+		// The lock keeps the ack from being handled before the send time is stored
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		if (m_pClient->SendReliable(pPacket, this))
+		{
+			m_ReliableSendTimes[pPacket->GetHeader().UID] = EngineLoop::GetPreciseTimeSinceStart();
+		}
+	}
+	else
+	{
+		m_pClient->SendUnreliable(pPacket);
+	}
+
+	m_MessagesSent++;
+}
+
+void BotClient::OnConnectingUDP(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+}
+
+void BotClient::OnConnectedUDP(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+}
+
+void BotClient::OnDisconnectingUDP(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+}
+
+void BotClient::OnDisconnectedUDP(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+}
+
+void BotClient::OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, LambdaEngine::NetworkPacket* pPacket)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	UNREFERENCED_VARIABLE(pPacket);
+}
+
+void BotClient::OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	UNREFERENCED_VARIABLE(packetType);
+	UNREFERENCED_VARIABLE(pData);
+	UNREFERENCED_VARIABLE(size);
+}
+
+void BotClient::OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	UNREFERENCED_VARIABLE(packetType);
+}
+
+void BotClient::OnServerFullUDP(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	LOG_WARNING("[BotClient]: Bot %u was rejected, the server is full", m_ID);
+}
+
+void BotClient::OnPacketDelivered(LambdaEngine::NetworkPacket* pPacket)
+{
+	using namespace LambdaEngine;
+
+	// Called from a worker thread, where the frame time is not precise enough
+	const Timestamp now = EngineLoop::GetPreciseTimeSinceStart();
+
+	std::scoped_lock<SpinLock> lock(m_Lock);
+	auto iterator = m_ReliableSendTimes.find(pPacket->GetHeader().UID);
+	if (iterator != m_ReliableSendTimes.end())
+	{
+		m_DeliveryLatencies.PushBack((now - iterator->second).AsMilliSeconds());
+		m_ReliableSendTimes.erase(iterator);
+	}
+}
+
+void BotClient::OnPacketResent(LambdaEngine::NetworkPacket* pPacket, uint8 tries)
+{
+	UNREFERENCED_VARIABLE(pPacket);
+	UNREFERENCED_VARIABLE(tries);
+}
+
+void BotClient::OnPacketMaxTriesReached(LambdaEngine::NetworkPacket* pPacket, uint8 tries)
+{
+	UNREFERENCED_VARIABLE(tries);
+
+	std::scoped_lock<LambdaEngine::SpinLock> lock(m_Lock);
+	m_ReliableSendTimes.erase(pPacket->GetHeader().UID);
+	m_ReliableMessagesLost++;
+}
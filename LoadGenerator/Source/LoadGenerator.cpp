@@ -0,0 +1,441 @@
+#include "LoadGenerator.h"
+
+#include "Engine/EngineLoop.h"
+#include "Engine/CommandLine.h"
+
+#include "Log/Log.h"
+
+#include "Threading/API/Thread.h"
+
+#include "Networking/API/ServerUDP.h"
+#include "Networking/API/IPAddress.h"
+#include "Networking/API/IClientUDP.h"
+#include "Networking/API/NetworkStatistics.h"
+#include "Networking/API/IClientUDPRemoteHandler.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+constexpr const uint16 LOAD_SERVER_PACKETS_PER_CLIENT	= 512;
+constexpr const uint8 LOAD_SERVER_MAXIMUM_TRIES			= 10;
+constexpr const float64 LOAD_REPORT_INTERVAL			= 1.0;
+constexpr const float64 LOAD_DISCONNECT_TIMEOUT			= 5.0;
+
+/*
+* Server side handler for the in process server, releases the remote client when it disconnects
+*/
+class LoadRemoteClientHandler : public LambdaEngine::IClientUDPRemoteHandler
+{
+public:
+	virtual void OnConnectingUDP(LambdaEngine::IClientUDP* pClient) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+	}
+
+	virtual void OnConnectedUDP(LambdaEngine::IClientUDP* pClient) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+	}
+
+	virtual void OnDisconnectingUDP(LambdaEngine::IClientUDP* pClient) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+	}
+
+	virtual void OnDisconnectedUDP(LambdaEngine::IClientUDP* pClient) override
+	{
+		pClient->Release();
+		delete this;
+	}
+
+	virtual void OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, LambdaEngine::NetworkPacket* pPacket) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+		UNREFERENCED_VARIABLE(pPacket);
+	}
+
+	virtual void OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+		UNREFERENCED_VARIABLE(packetType);
+		UNREFERENCED_VARIABLE(pData);
+		UNREFERENCED_VARIABLE(size);
+	}
+
+	virtual void OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType) override
+	{
+		UNREFERENCED_VARIABLE(pClient);
+		UNREFERENCED_VARIABLE(packetType);
+	}
+};
+
+struct Percentiles
+{
+	float64 P50 = 0.0;
+	float64 P95 = 0.0;
+	float64 P99 = 0.0;
+	float64 Max = 0.0;
+};
+
+/*
+* Sorts values and picks the percentiles with the nearest rank method
+*/
+static Percentiles CalculatePercentiles(LambdaEngine::TArray<float64>& values)
+{
+	Percentiles percentiles;
+	if (values.IsEmpty())
+	{
+		return percentiles;
+	}
+
+	float64* pBegin = values.GetData();
+	std::sort(pBegin, pBegin + values.GetSize());
+
+	const uint32 count = uint32(values.GetSize());
+	auto rank = [&](float64 percentile)
+	{
+		const uint32 index = uint32(percentile * float64(count - 1) + 0.5);
+		return values[index];
+	};
+
+	percentiles.P50 = rank(0.50);
+	percentiles.P95 = rank(0.95);
+	percentiles.P99 = rank(0.99);
+	percentiles.Max = values[count - 1];
+	return percentiles;
+}
+
+LoadGenerator::LoadGenerator() :
+	m_pServer(nullptr),
+	m_BotThreadsRunning(false),
+	m_ConnectAccumulator(0.0),
+	m_BotsStarted(0),
+	m_ElapsedTime(0.0),
+	m_TimeSinceReport(0.0),
+	m_IsDone(false),
+	m_LastMessagesSent(0),
+	m_LastBytesSent(0),
+	m_LastBytesReceived(0)
+{
+	using namespace LambdaEngine;
+
+	const uint32 clientCount	= uint32(std::max(CommandLine::GetInt32("clients", 100), 1));
+	const bool useLoopback		= CommandLine::HasOption("loopback");
+	const uint16 port			= uint16(CommandLine::GetInt32("port", 4444));
+	const uint32 botThreadCount	= uint32(std::clamp(CommandLine::GetInt32("bot-threads", 2), 1, int32(clientCount)));
+
+	m_Duration		= CommandLine::GetFloat32("duration", 30.0f);
+	m_ConnectRate	= CommandLine::GetFloat32("connect-rate", 200.0f);
+	m_JSONPath		= CommandLine::GetString("json", "loadgen_report.json");
+
+	constexpr const int32 maxPayloadSize = MAXIMUM_PACKET_SIZE - 64;
+
+	LoadPattern pattern;
+	pattern.MessagesPerSecond	= CommandLine::GetFloat32("rate", pattern.MessagesPerSecond);
+	pattern.ReliableRatio		= CommandLine::GetFloat32("reliable", pattern.ReliableRatio);
+	pattern.BurstSize			= uint32(std::max(CommandLine::GetInt32("burst", 0), 0));
+	pattern.BurstInterval		= CommandLine::GetFloat32("burst-interval", pattern.BurstInterval);
+	pattern.PayloadSize			= uint16(std::clamp(CommandLine::GetInt32("payload", pattern.PayloadSize), 0, maxPayloadSize));
+
+	NetworkConditions conditions;
+	conditions.LatencyMS	= CommandLine::GetFloat32("latency", 0.0f);
+	conditions.JitterMS		= CommandLine::GetFloat32("jitter", 0.0f);
+	conditions.LossRatio	= CommandLine::GetFloat32("loss", 0.0f);
+
+	if (useLoopback)
+	{
+		m_pServer = ServerUDP::Create(this, uint16(std::min(clientCount, uint32(UINT16_MAX))), LOAD_SERVER_PACKETS_PER_CLIENT, LOAD_SERVER_MAXIMUM_TRIES);
+		m_pServer->SetUseLoopback(true);
+		m_pServer->Start(IPEndPoint(IPAddress::ANY, port));
+
+		m_ServerEndPoint = IPEndPoint(IPAddress::LOOPBACK, port);
+	}
+	else
+	{
+		m_ServerEndPoint = IPEndPoint(IPAddress::Get(CommandLine::GetString("address", "127.0.0.1")), port);
+	}
+
+	m_Bots.Reserve(clientCount);
+	for (uint32 i = 0; i < clientCount; i++)
+	{
+		m_Bots.PushBack(DBG_NEW BotClient(i, pattern, useLoopback, conditions));
+	}
+
+	m_BotThreadsRunning = true;
+	m_BotThreads.Reserve(botThreadCount);
+	for (uint32 i = 0; i < botThreadCount; i++)
+	{
+		m_BotThreads.EmplaceBack(&LoadGenerator::RunBotThread, this, i, botThreadCount);
+	}
+
+	LOG_INFO("[LoadGenerator]: %u bots on %u threads, %.1f msg/s each, %.0f%% reliable, %u byte payload, server %s%s",
+		clientCount, botThreadCount, pattern.MessagesPerSecond, pattern.ReliableRatio * 100.0f, pattern.PayloadSize,
+		m_ServerEndPoint.ToString().c_str(), useLoopback ? " (loopback)" : "");
+}
+
+LoadGenerator::~LoadGenerator()
+{
+	using namespace LambdaEngine;
+
+	for (BotClient* pBot : m_Bots)
+	{
+		pBot->Disconnect();
+	}
+
+	// The bots are listeners of their own packets, so they must outlive the network threads. The frame time does not
+	// advance outside of EngineLoop::Run, so the deadline uses the precise time
+	const Timestamp deadline = EngineLoop::GetPreciseTimeSinceStart() + Timestamp::Seconds(LOAD_DISCONNECT_TIMEOUT);
+	for (BotClient* pBot : m_Bots)
+	{
+		while (!pBot->IsDisconnected() && EngineLoop::GetPreciseTimeSinceStart() < deadline)
+		{
+			Thread::Sleep(1);
+		}
+	}
+
+	// Bots that did not finish disconnecting in time are terminated by Release once nothing polls them
+	StopBotThreads();
+
+	for (BotClient* pBot : m_Bots)
+	{
+		SAFEDELETE(pBot);
+	}
+	m_Bots.Clear();
+
+	if (m_pServer)
+	{
+		m_pServer->Release();
+		m_pServer = nullptr;
+	}
+}
+
+void LoadGenerator::Tick(LambdaEngine::Timestamp delta)
+{
+	UNREFERENCED_VARIABLE(delta);
+}
+
+void LoadGenerator::FixedTick(LambdaEngine::Timestamp delta)
+{
+	using namespace LambdaEngine;
+
+	if (m_IsDone)
+	{
+		return;
+	}
+
+	ConnectBots(delta);
+
+	for (BotClient* pBot : m_Bots)
+	{
+		pBot->FixedTick(delta);
+	}
+
+	m_ElapsedTime		+= delta.AsSeconds();
+	m_TimeSinceReport	+= delta.AsSeconds();
+	if (m_TimeSinceReport >= LOAD_REPORT_INTERVAL)
+	{
+		Report(false);
+	}
+
+	if (m_ElapsedTime >= m_Duration)
+	{
+		Report(true);
+		WriteJSON(m_JSONPath.c_str());
+
+		m_IsDone = true;
+		EngineLoop::RequestExit();
+	}
+}
+
+void LoadGenerator::OnClientConnected(LambdaEngine::IClientUDP* pClient)
+{
+	UNREFERENCED_VARIABLE(pClient);
+}
+
+LambdaEngine::IClientUDPRemoteHandler* LoadGenerator::CreateClientUDPHandler()
+{
+	return DBG_NEW LoadRemoteClientHandler();
+}
+
+/*
+* Every worker polls every threadCount:th bot, and sleeps for a millisecond when none of them received anything
+*/
+void LoadGenerator::RunBotThread(uint32 threadIndex, uint32 threadCount)
+{
+	using namespace LambdaEngine;
+
+	while (m_BotThreadsRunning)
+	{
+		bool hasReceived = false;
+		for (uint32 i = threadIndex; i < m_Bots.GetSize(); i += threadCount)
+		{
+			hasReceived |= m_Bots[i]->Poll();
+		}
+
+		if (!hasReceived)
+		{
+			Thread::Sleep(1);
+		}
+	}
+}
+
+void LoadGenerator::StopBotThreads()
+{
+	m_BotThreadsRunning = false;
+	for (std::thread& thread : m_BotThreads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_BotThreads.Clear();
+}
+
+/*
+* Connecting all bots at once would only measure how the server handles a connection storm
+*/
+void LoadGenerator::ConnectBots(LambdaEngine::Timestamp delta)
+{
+	if (m_BotsStarted >= m_Bots.GetSize())
+	{
+		return;
+	}
+
+	m_ConnectAccumulator += delta.AsSeconds() * m_ConnectRate;
+	while (m_ConnectAccumulator >= 1.0 && m_BotsStarted < m_Bots.GetSize())
+	{
+		BotClient* pBot = m_Bots[m_BotsStarted++];
+		if (!pBot->Connect(m_ServerEndPoint))
+		{
+			LOG_ERROR("[LoadGenerator]: Bot %u failed to connect", m_BotsStarted - 1);
+		}
+
+		m_ConnectAccumulator -= 1.0;
+	}
+}
+
+void LoadGenerator::Report(bool isFinal)
+{
+	using namespace LambdaEngine;
+
+	uint32 connectedCount		= 0;
+	uint64 messagesSent			= 0;
+	uint64 bytesSent			= 0;
+	uint64 bytesReceived		= 0;
+	uint64 reliableLost			= 0;
+	float64 lossRateSum			= 0.0;
+
+	TArray<float64> pings;
+	TArray<float64> deliveryLatencies;
+	pings.Reserve(m_Bots.GetSize());
+
+	for (BotClient* pBot : m_Bots)
+	{
+		const NetworkStatistics* pStatistics = pBot->GetStatistics();
+		messagesSent	+= pBot->GetMessagesSent();
+		reliableLost	+= pBot->GetReliableMessagesLost();
+		bytesSent		+= pStatistics->GetBytesSent();
+		bytesReceived	+= pStatistics->GetBytesReceived();
+
+		pBot->TakeDeliveryLatencies(deliveryLatencies);
+
+		if (pBot->IsConnected())
+		{
+			connectedCount++;
+			pings.PushBack(pStatistics->GetPing().AsMilliSeconds());
+			lossRateSum += pStatistics->GetPacketLossRate();
+		}
+	}
+
+	for (float64 latency : deliveryLatencies)
+	{
+		m_AllDeliveryLatencies.PushBack(latency);
+	}
+
+	for (float64 ping : pings)
+	{
+		m_AllPings.PushBack(ping);
+	}
+
+	const float64 interval		= std::max(m_TimeSinceReport, 0.001);
+	const float64 messageRate	= float64(messagesSent - m_LastMessagesSent) / interval;
+	const float64 sendRate		= float64(bytesSent - m_LastBytesSent) / interval / 1024.0;
+	const float64 receiveRate	= float64(bytesReceived - m_LastBytesReceived) / interval / 1024.0;
+	const float64 averageLoss	= connectedCount > 0 ? lossRateSum / float64(connectedCount) : 0.0;
+
+	if (m_TimeSinceReport > 0.0)
+	{
+		m_MessageRates.PushBack(messageRate);
+	}
+
+	const Percentiles pingPercentiles		= CalculatePercentiles(pings);
+	const Percentiles deliveryPercentiles	= CalculatePercentiles(deliveryLatencies);
+
+	LOG_INFO("[LoadGenerator]: %s%.0fs | Connected %u/%u | %.0f msg/s | Up %.1f KiB/s Down %.1f KiB/s | RTT p50 %.1f p95 %.1f p99 %.1f ms | Reliable p50 %.1f p95 %.1f p99 %.1f ms | Loss %.2f%% | Reliable lost %llu",
+		isFinal ? "Final " : "", m_ElapsedTime, connectedCount, uint32(m_Bots.GetSize()), messageRate, sendRate, receiveRate,
+		pingPercentiles.P50, pingPercentiles.P95, pingPercentiles.P99,
+		deliveryPercentiles.P50, deliveryPercentiles.P95, deliveryPercentiles.P99,
+		averageLoss, reliableLost);
+
+	m_LastMessagesSent	= messagesSent;
+	m_LastBytesSent		= bytesSent;
+	m_LastBytesReceived	= bytesReceived;
+	m_TimeSinceReport	= 0.0;
+}
+
+bool LoadGenerator::WriteJSON(const char* pFilepath) const
+{
+	using namespace LambdaEngine;
+
+	FILE* pFile = fopen(pFilepath, "w");
+	if (!pFile)
+	{
+		LOG_ERROR("[LoadGenerator]: Failed to open '%s'", pFilepath);
+		return false;
+	}
+
+	TArray<float64> deliveryLatencies	= m_AllDeliveryLatencies;
+	TArray<float64> pings				= m_AllPings;
+	TArray<float64> messageRates		= m_MessageRates;
+
+	const Percentiles deliveryPercentiles	= CalculatePercentiles(deliveryLatencies);
+	const Percentiles pingPercentiles		= CalculatePercentiles(pings);
+	const Percentiles ratePercentiles		= CalculatePercentiles(messageRates);
+
+	uint64 messagesSent = 0;
+	uint64 reliableLost = 0;
+	for (BotClient* pBot : m_Bots)
+	{
+		messagesSent += pBot->GetMessagesSent();
+		reliableLost += pBot->GetReliableMessagesLost();
+	}
+
+	fprintf(pFile, "{\n");
+	fprintf(pFile, "\t\"clients\": %u,\n", uint32(m_Bots.GetSize()));
+	fprintf(pFile, "\t\"duration_s\": %.3f,\n", m_ElapsedTime);
+	fprintf(pFile, "\t\"messages_sent\": %llu,\n", messagesSent);
+	fprintf(pFile, "\t\"reliable_lost\": %llu,\n", reliableLost);
+	fprintf(pFile, "\t\"reliable_delivered\": %u,\n", uint32(deliveryLatencies.GetSize()));
+	fprintf(pFile, "\t\"rtt_ms\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+		pingPercentiles.P50, pingPercentiles.P95, pingPercentiles.P99, pingPercentiles.Max);
+	fprintf(pFile, "\t\"reliable_delivery_ms\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+		deliveryPercentiles.P50, deliveryPercentiles.P95, deliveryPercentiles.P99, deliveryPercentiles.Max);
+	fprintf(pFile, "\t\"messages_per_second\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f }\n",
+		ratePercentiles.P50, ratePercentiles.P95, ratePercentiles.P99, ratePercentiles.Max);
+	fprintf(pFile, "}\n");
+
+	fclose(pFile);
+
+	LOG_INFO("[LoadGenerator]: Wrote report to '%s'", pFilepath);
+	return true;
+}
+
+namespace LambdaEngine
+{
+	Game* CreateGame()
+	{
+		LoadGenerator* pLoadGenerator = DBG_NEW LoadGenerator();
+		return pLoadGenerator;
+	}
+}
@@ -0,0 +1,326 @@
+#include "Log/BinaryLogFormat.h"
+
+#include "Containers/String.h"
+#include "Containers/THashTable.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+using namespace LambdaEngine;
+
+/*
+* LogDecoder
+*	Renders a binary log written by LambdaEngine::BinaryLog as text.
+*	Usage: LogDecoder <input.blog> [output.txt]
+*/
+
+struct CallSite
+{
+	uint8	Severity	= 0;
+	uint32	Line		= 0;
+	String	File;
+	String	Format;
+};
+
+struct Argument
+{
+	EBinaryLogArgument	Type	= EBinaryLogArgument::ARGUMENT_INT64;
+	int64				Int		= 0;
+	uint64				UInt	= 0;
+	float64				Float	= 0.0;
+	String				Str;
+};
+
+static const char* GetSeverityString(uint8 severity)
+{
+	static const char* SEVERITIES[] = { "MESSAGE", "INFO", "WARNING", "ERROR" };
+	return severity < 4 ? SEVERITIES[severity] : "UNKNOWN";
+}
+
+static bool ReadBytes(FILE* pFile, void* pData, size_t size)
+{
+	return fread(pData, 1, size, pFile) == size;
+}
+
+static std::vector<Argument> DecodeArguments(const uint8* pData, uint16 size)
+{
+	std::vector<Argument> arguments;
+
+	uint32 offset = 0;
+	while (offset < size)
+	{
+		Argument argument;
+		argument.Type = EBinaryLogArgument(pData[offset++]);
+
+		if (argument.Type == EBinaryLogArgument::ARGUMENT_STRING)
+		{
+			uint16 length = 0;
+			if (offset + sizeof(length) > size)
+			{
+				break;
+			}
+
+			memcpy(&length, pData + offset, sizeof(length));
+			offset += sizeof(length);
+
+			// The string may have been cut when the entry was written
+			const uint32 available = size - offset;
+			length = uint16(length < available ? length : available);
+
+			argument.Str.assign(reinterpret_cast<const char*>(pData + offset), length);
+			offset += length;
+		}
+		else
+		{
+			if (offset + sizeof(uint64) > size)
+			{
+				break;
+			}
+
+			memcpy(&argument.UInt, pData + offset, sizeof(uint64));
+			memcpy(&argument.Int, pData + offset, sizeof(int64));
+			memcpy(&argument.Float, pData + offset, sizeof(float64));
+			offset += sizeof(uint64);
+		}
+
+		arguments.push_back(argument);
+	}
+
+	return arguments;
+}
+
+static int64 GetArgumentAsInt(const Argument& argument)
+{
+	switch (argument.Type)
+	{
+	case EBinaryLogArgument::ARGUMENT_INT64:	return argument.Int;
+	case EBinaryLogArgument::ARGUMENT_FLOAT64:	return int64(argument.Float);
+	case EBinaryLogArgument::ARGUMENT_STRING:	return 0;
+	default:									return int64(argument.UInt);
+	}
+}
+
+static String FormatMessage(const String& format, const std::vector<Argument>& arguments)
+{
+	String	message;
+	char	buffer[512];
+	size_t	argumentIndex = 0;
+
+	for (size_t i = 0; i < format.size(); i++)
+	{
+		if (format[i] != '%')
+		{
+			message += format[i];
+			continue;
+		}
+
+		if (i + 1 < format.size() && format[i + 1] == '%')
+		{
+			message += '%';
+			i++;
+			continue;
+		}
+
+		// Collect flags, width and precision, length modifiers are dropped since every argument is 8 bytes
+		String specifier = "%";
+		size_t j = i + 1;
+		for (; j < format.size(); j++)
+		{
+			const char c = format[j];
+			if (strchr("-+ #0123456789.", c))
+			{
+				specifier += c;
+			}
+			else if (c == '*')
+			{
+				const int64 value = argumentIndex < arguments.size() ? GetArgumentAsInt(arguments[argumentIndex++]) : 0;
+				specifier += std::to_string(value);
+			}
+			else if (!strchr("hljztLqI", c))
+			{
+				break;
+			}
+		}
+
+		if (j >= format.size())
+		{
+			message += format.substr(i);
+			break;
+		}
+
+		const char conversion = format[j];
+		i = j;
+
+		if (argumentIndex >= arguments.size())
+		{
+			message += "<missing>";
+			continue;
+		}
+
+		const Argument& argument = arguments[argumentIndex++];
+		if (conversion == 's')
+		{
+			if (argument.Type == EBinaryLogArgument::ARGUMENT_STRING)
+			{
+				snprintf(buffer, sizeof(buffer), (specifier + "s").c_str(), argument.Str.c_str());
+			}
+			else
+			{
+				snprintf(buffer, sizeof(buffer), "%lld", (long long)GetArgumentAsInt(argument));
+			}
+		}
+		else if (strchr("fFeEgGaA", conversion))
+		{
+			const float64 value = argument.Type == EBinaryLogArgument::ARGUMENT_FLOAT64 ? argument.Float : float64(GetArgumentAsInt(argument));
+			snprintf(buffer, sizeof(buffer), (specifier + conversion).c_str(), value);
+		}
+		else if (conversion == 'p')
+		{
+			snprintf(buffer, sizeof(buffer), "0x%016llx", (unsigned long long)argument.UInt);
+		}
+		else if (strchr("diouxXc", conversion))
+		{
+			if (argument.Type == EBinaryLogArgument::ARGUMENT_STRING)
+			{
+				snprintf(buffer, sizeof(buffer), "%s", argument.Str.c_str());
+			}
+			else
+			{
+				const String lengthSpecifier = conversion == 'c' ? String(1, conversion) : String("ll") + conversion;
+				snprintf(buffer, sizeof(buffer), (specifier + lengthSpecifier).c_str(), (long long)GetArgumentAsInt(argument));
+			}
+		}
+		else
+		{
+			snprintf(buffer, sizeof(buffer), "<unknown '%c'>", conversion);
+		}
+
+		message += buffer;
+	}
+
+	return message;
+}
+
+int main(int argc, const char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: LogDecoder <input.blog> [output.txt]\n");
+		return 1;
+	}
+
+	FILE* pInput = fopen(argv[1], "rb");
+	if (!pInput)
+	{
+		printf("Failed to open '%s'\n", argv[1]);
+		return 1;
+	}
+
+	FILE* pOutput = stdout;
+	if (argc > 2)
+	{
+		pOutput = fopen(argv[2], "w");
+		if (!pOutput)
+		{
+			printf("Failed to open '%s'\n", argv[2]);
+			fclose(pInput);
+			return 1;
+		}
+	}
+
+	BinaryLogFileHeader fileHeader = {};
+	if (!ReadBytes(pInput, &fileHeader, sizeof(fileHeader)) || fileHeader.Magic != BINARY_LOG_MAGIC)
+	{
+		printf("'%s' is not a binary log\n", argv[1]);
+		return 1;
+	}
+
+	if (fileHeader.Version != BINARY_LOG_VERSION)
+	{
+		printf("'%s' has version %u, this decoder reads version %u\n", argv[1], uint32(fileHeader.Version), uint32(BINARY_LOG_VERSION));
+		return 1;
+	}
+
+	const float64 frequency = fileHeader.TimerFrequency > 0 ? float64(fileHeader.TimerFrequency) : 1.0;
+
+	THashTable<uint32, CallSite> callSites;
+	uint64	firstTimestamp	= 0;
+	uint32	entryCount		= 0;
+	uint8	block			= 0;
+	uint8	arguments[UINT16_MAX];
+
+	while (ReadBytes(pInput, &block, sizeof(block)))
+	{
+		if (block == uint8(EBinaryLogBlock::BLOCK_CALL_SITE))
+		{
+			BinaryLogCallSiteHeader header = {};
+			if (!ReadBytes(pInput, &header, sizeof(header)))
+			{
+				break;
+			}
+
+			CallSite callSite;
+			callSite.Severity	= header.Severity;
+			callSite.Line		= header.Line;
+			callSite.File.resize(header.FileLength);
+			callSite.Format.resize(header.FormatLength);
+
+			if (!ReadBytes(pInput, callSite.File.data(), header.FileLength) || !ReadBytes(pInput, callSite.Format.data(), header.FormatLength))
+			{
+				break;
+			}
+
+			callSites[header.ID] = callSite;
+		}
+		else if (block == uint8(EBinaryLogBlock::BLOCK_ENTRY))
+		{
+			BinaryLogEntryHeader header = {};
+			if (!ReadBytes(pInput, &header, sizeof(header)) || !ReadBytes(pInput, arguments, header.ArgumentSize))
+			{
+				break;
+			}
+
+			if (entryCount == 0)
+			{
+				firstTimestamp = header.Timestamp;
+			}
+
+			entryCount++;
+
+			const float64 seconds = float64(header.Timestamp - firstTimestamp) / frequency;
+
+			auto callSiteIt = callSites.find(header.ID);
+			if (callSiteIt == callSites.end())
+			{
+				fprintf(pOutput, "[%10.4f][Thread %u][UNKNOWN] <unknown call site %08x>\n", seconds, header.ThreadID, header.ID);
+				continue;
+			}
+
+			const CallSite& callSite = callSiteIt->second;
+			const String message = FormatMessage(callSite.Format, DecodeArguments(arguments, header.ArgumentSize));
+			fprintf(pOutput, "[%10.4f][Thread %u][%s] %s", seconds, header.ThreadID, GetSeverityString(callSite.Severity), message.c_str());
+
+			if (header.Suppressed > 0)
+			{
+				fprintf(pOutput, " (%u suppressed)", header.Suppressed);
+			}
+
+			fprintf(pOutput, " (%s:%u)\n", callSite.File.c_str(), callSite.Line);
+		}
+		else
+		{
+			printf("Unknown block type %u, the file is corrupt\n", uint32(block));
+			break;
+		}
+	}
+
+	fclose(pInput);
+	if (pOutput != stdout)
+	{
+		fclose(pOutput);
+	}
+
+	printf("Decoded %u entries from %u call sites\n", entryCount, uint32(callSites.size()));
+	return 0;
+}
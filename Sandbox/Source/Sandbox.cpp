@@ -16,6 +16,7 @@
 #include "Rendering/PipelineStateManager.h"
 #include "Rendering/RenderGraphEditor.h"
 #include "Rendering/RenderGraph.h"
+#include "Rendering/RenderThread.h"
 #include "Rendering/Core/API/TextureView.h"
 #include "Rendering/Core/API/Sampler.h"
 #include "Rendering/Core/API/CommandQueue.h"
@@ -36,6 +37,10 @@
 
 #include "Threading/API/Thread.h"
 
+#include "Profiling/Profiler.h"
+
+#include "Engine/FrameStatistics.h"
+
 #include <imgui.h>
 
 constexpr const uint32 BACK_BUFFER_COUNT = 3;
@@ -50,6 +55,7 @@ constexpr const bool SVGF_ENABLED				= false;
 
 constexpr const bool RENDER_GRAPH_IMGUI_ENABLED	= true;
 constexpr const bool RENDERING_DEBUG_ENABLED	= false;
+constexpr const bool RENDER_THREAD_ENABLED		= true;
 
 constexpr const float DEFAULT_DIR_LIGHT_R			= 1.0f;
 constexpr const float DEFAULT_DIR_LIGHT_G			= 1.0f;
@@ -363,12 +369,30 @@ Sandbox::Sandbox()
 		m_pRenderGraphEditor->InitGUI();	//Must Be called after Renderer is initialized
 	}
 
+	// The scene, renderer and ImGui belong to the render thread from here on, the game thread only writes frame packets
+	if (RENDER_THREAD_ENABLED)
+	{
+		RenderThread::Init([this](const FramePacket& packet)
+		{
+			packet.ApplyToScene(m_pScene);
+
+			if (packet.HasWindowSize)
+			{
+				m_pRenderGraph->SetWindowSize(packet.WindowWidth, packet.WindowHeight);
+			}
+
+			Render(packet.Delta);
+		});
+	}
+
 	return;
 }
 
 Sandbox::~Sandbox()
 {
 	LambdaEngine::CommonApplication::Get()->RemoveEventHandler(this);
+
+	LambdaEngine::RenderThread::Release();
 	
 	SAFEDELETE(m_pAudioGeometry);
 
@@ -494,10 +518,18 @@ void Sandbox::OnWindowMoved(LambdaEngine::TSharedRef<LambdaEngine::Window> windo
 
 void Sandbox::OnWindowResized(LambdaEngine::TSharedRef<LambdaEngine::Window> window, uint16 width, uint16 height, LambdaEngine::EResizeType type)
 {
+	using namespace LambdaEngine;
+
 	UNREFERENCED_VARIABLE(window);
 	UNREFERENCED_VARIABLE(type);
 	
 	//LOG_MESSAGE("Window Resized: width=%u, height=%u, type=%u", width, height, uint32(type));
+
+	// The RenderGraph ignores the event while the render thread runs, it is resized with the next frame instead
+	if (RenderThread::IsRunning())
+	{
+		RenderThread::GetGamePacket().SetWindowSize(width, height);
+	}
 }
 
 void Sandbox::OnWindowClosed(LambdaEngine::TSharedRef<LambdaEngine::Window> window)
@@ -576,11 +608,30 @@ void Sandbox::OnKeyPressed(LambdaEngine::EKey key, uint32 modifierMask, bool isR
 
 	if (key == EKey::KEY_KEYPAD_5)
 	{
+		RenderThread::Flush();
 		RenderSystem::GetGraphicsQueue()->Flush();
 		RenderSystem::GetComputeQueue()->Flush();
 		ResourceManager::ReloadAllShaders();
 		PipelineStateManager::ReloadPipelineStates();
 	}
+	if (key == EKey::KEY_F9)
+	{
+		if (Profiler::IsCapturing())
+		{
+			Profiler::EndCapture();
+			Profiler::ExportChromeTrace("profiler_capture.json");
+		}
+		else
+		{
+			Profiler::BeginCapture();
+		}
+	}
+
+	if (key == EKey::KEY_F10)
+	{
+		FrameStatistics::ExportFramesCSV("frame_statistics.csv");
+		FrameStatistics::AppendSummaryCSV("frame_statistics_summary.csv", "Sandbox");
+	}
 	/*if (key == EKey::KEY_KEYPAD_1)
 	{
 		m_pToneSoundInstance->Toggle();
@@ -686,7 +737,14 @@ void Sandbox::Tick(LambdaEngine::Timestamp delta)
 {
 	using namespace LambdaEngine;
 
-	Render(delta);
+	if (RenderThread::IsRunning())
+	{
+		RenderThread::Submit(delta);
+	}
+	else
+	{
+		Render(delta);
+	}
 }
 
 void Sandbox::FixedTick(LambdaEngine::Timestamp delta)
@@ -767,7 +825,14 @@ void Sandbox::FixedTick(LambdaEngine::Timestamp delta)
 	}
 
 	m_pCamera->Update();
-	m_pScene->UpdateCamera(m_pCamera);
+	if (RenderThread::IsRunning())
+	{
+		RenderThread::GetGamePacket().Camera = m_pCamera->GetData();
+	}
+	else
+	{
+		m_pScene->UpdateCamera(m_pCamera);
+	}
 
 	AudioListenerDesc listenerDesc = {};
 	listenerDesc.Position = m_pCamera->GetPosition();
@@ -799,6 +864,8 @@ void Sandbox::Render(LambdaEngine::Timestamp delta)
 
 		ImGui::ShowDemoWindow();
 
+		FrameStatistics::RenderStatisticsWithImGUI();
+
 		ImGui::SetNextWindowSize(ImVec2(430, 450), ImGuiCond_FirstUseEver);
 		if (ImGui::Begin("Debugging Window", NULL))
 		{
@@ -55,3 +55,16 @@ void ClientUDPHandler::OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, La
 	counter++;
 	LOG_MESSAGE("%d", value);*/
 }
+
+void ClientUDPHandler::OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	UNREFERENCED_VARIABLE(pData);
+	LOG_MESSAGE("OnLargePacketReceivedUDP(%u, %u bytes)", packetType, size);
+}
+
+void ClientUDPHandler::OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType)
+{
+	UNREFERENCED_VARIABLE(pClient);
+	LOG_WARNING("OnLargePacketFailedUDP(%u)", packetType);
+}
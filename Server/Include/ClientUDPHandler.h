@@ -21,6 +21,8 @@ public:
 	virtual void OnDisconnectingUDP(LambdaEngine::IClientUDP* pClient) override;
 	virtual void OnDisconnectedUDP(LambdaEngine::IClientUDP* pClient) override;
 	virtual void OnPacketReceivedUDP(LambdaEngine::IClientUDP* pClient, LambdaEngine::NetworkPacket* pPacket) override;
+	virtual void OnLargePacketReceivedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType, const char* pData, uint32 size) override;
+	virtual void OnLargePacketFailedUDP(LambdaEngine::IClientUDP* pClient, uint16 packetType) override;
 
 private:
 	int counter = 0;
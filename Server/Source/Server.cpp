@@ -18,6 +18,10 @@
 #include "Networking/API/BinaryEncoder.h"
 #include "Networking/API/BinaryDecoder.h"
 
+#include "Metrics/MetricsRegistry.h"
+
+#include "Engine/EngineLoop.h"
+
 #include "ClientUDPHandler.h"
 
 #include "Math/Random.h"
@@ -26,7 +30,15 @@
 Server::Server()
 {
 	using namespace LambdaEngine;
-	CommonApplication::Get()->AddEventHandler(this);
+
+	// There is no window to receive input from when running headless
+	if (!EngineLoop::IsHeadless())
+	{
+		CommonApplication::Get()->AddEventHandler(this);
+	}
+
+	MetricsRegistry::SetPrometheusExportPath("server_metrics.prom");
+	MetricsRegistry::SetCSVExportPath("server_metrics.csv");
 
 	m_pServer = ServerUDP::Create(this, 100, 1024, 10);
 	m_pServer->Start(IPEndPoint(IPAddress::ANY, 4444));
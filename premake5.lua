@@ -308,6 +308,7 @@ workspace "LambdaEngine"
 			{
                 "vulkan-1",
 				"fmodL_vc.lib",
+				"winmm",
 			}
 			
 			libdirs
@@ -421,6 +422,8 @@ workspace "LambdaEngine"
 		--		("{COPY} \"../FMODProgrammersAPI/api/core/lib/libfmodL.dylib\" \"../Build/bin/" .. outputdir .. "/Sandbox/\""),
 		--		("{COPY} \"../FMODProgrammersAPI/api/core/lib/libfmodL.dylib\" \"../Build/bin/" .. outputdir .. "/Client/\""),
 		--		("{COPY} \"../FMODProgrammersAPI/api/core/lib/libfmodL.dylib\" \"../Build/bin/" .. outputdir .. "/Server/\""),
+		--		("{COPY} \"../FMODProgrammersAPI/api/core/lib/libfmodL.dylib\" \"../Build/bin/" .. outputdir .. "/Benchmarks/\""),
+		--		("{COPY} \"../FMODProgrammersAPI/api/core/lib/libfmodL.dylib\" \"../Build/bin/" .. outputdir .. "/LoadGenerator/\""),
 		--	}
 
 		-- Copy DLL into correct folder for windows builds
@@ -431,6 +434,8 @@ workspace "LambdaEngine"
 				("{COPY} \"D:/FMOD Studio API Windows/api/core/lib/x64/fmodL.dll\" \"../Build/bin/" .. outputdir .. "/Sandbox/\""),
 				("{COPY} \"D:/FMOD Studio API Windows/api/core/lib/x64/fmodL.dll\" \"../Build/bin/" .. outputdir .. "/Client/\""),
 				("{COPY} \"D:/FMOD Studio API Windows/api/core/lib/x64/fmodL.dll\" \"../Build/bin/" .. outputdir .. "/Server/\""),
+				("{COPY} \"D:/FMOD Studio API Windows/api/core/lib/x64/fmodL.dll\" \"../Build/bin/" .. outputdir .. "/Benchmarks/\""),
+				("{COPY} \"D:/FMOD Studio API Windows/api/core/lib/x64/fmodL.dll\" \"../Build/bin/" .. outputdir .. "/LoadGenerator/\""),
 			}
 		-- LambdaEngine
         filter { "system:windows", "platforms:x64_SharedLib" }
@@ -439,6 +444,8 @@ workspace "LambdaEngine"
                 ("{COPY} %{cfg.buildtarget.relpath} \"../Build/bin/" .. outputdir .. "/Sandbox/\""),
                 ("{COPY} %{cfg.buildtarget.relpath} \"../Build/bin/" .. outputdir .. "/Client/\""),
                 ("{COPY} %{cfg.buildtarget.relpath} \"../Build/bin/" .. outputdir .. "/Server/\""),
+                ("{COPY} %{cfg.buildtarget.relpath} \"../Build/bin/" .. outputdir .. "/Benchmarks/\""),
+                ("{COPY} %{cfg.buildtarget.relpath} \"../Build/bin/" .. outputdir .. "/LoadGenerator/\""),
 			}
 		-- Portaudio
 		filter { "system:windows", "configurations:Debug"}
@@ -447,6 +454,8 @@ workspace "LambdaEngine"
 				("{COPY} \"../Dependencies/portaudio/dll/debug/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Sandbox/\""),
 				("{COPY} \"../Dependencies/portaudio/dll/debug/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Client/\""),
 				("{COPY} \"../Dependencies/portaudio/dll/debug/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Server/\""),
+				("{COPY} \"../Dependencies/portaudio/dll/debug/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Benchmarks/\""),
+				("{COPY} \"../Dependencies/portaudio/dll/debug/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/LoadGenerator/\""),
 			}
 		filter { "system:windows", "configurations:Release or Production"}
 			postbuildcommands
@@ -454,6 +463,8 @@ workspace "LambdaEngine"
 				("{COPY} \"../Dependencies/portaudio/dll/release/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Sandbox/\""),
 				("{COPY} \"../Dependencies/portaudio/dll/release/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Client/\""),
 				("{COPY} \"../Dependencies/portaudio/dll/release/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Server/\""),
+				("{COPY} \"../Dependencies/portaudio/dll/release/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/Benchmarks/\""),
+				("{COPY} \"../Dependencies/portaudio/dll/release/portaudio_x64.dll\" \"../Build/bin/" .. outputdir .. "/LoadGenerator/\""),
 			}
 		filter {}
     project "*"
@@ -562,7 +573,7 @@ workspace "LambdaEngine"
 
     -- Server Project
     project "Server"
-        kind "WindowedApp"
+        kind "ConsoleApp"
         language "C++"
 		cppdialect "C++17"
 		systemversion "latest"
@@ -572,6 +583,12 @@ workspace "LambdaEngine"
 		targetdir ("Build/bin/" .. outputdir .. "/%{prj.name}")
 		objdir ("Build/bin-int/" .. outputdir .. "/%{prj.name}")
 		
+		-- Dedicated server runs without window, renderer and audio
+		defines
+		{
+			"LAMBDA_HEADLESS",
+		}
+		
 		--Includes
 		includedirs
 		{
@@ -608,4 +625,114 @@ workspace "LambdaEngine"
 			"LambdaEngine",
 			"ImGui",
 		}
+    project "*"
+    -- LogDecoder Project
+    project "LogDecoder"
+        kind "ConsoleApp"
+        language "C++"
+		cppdialect "C++17"
+		systemversion "latest"
+        location "LogDecoder"
+        
+        -- Targets
+		targetdir ("Build/bin/" .. outputdir .. "/%{prj.name}")
+		objdir ("Build/bin-int/" .. outputdir .. "/%{prj.name}")
+		
+		--Includes, only header-only parts of the engine are used so the engine is not linked
+		includedirs
+		{
+            "LambdaEngine/Include",
+		}
+        
+        -- Files
+		files 
+		{
+			"%{prj.name}/**.h",
+			"%{prj.name}/**.cpp",
+		}
+    project "*"
+    -- Benchmarks Project
+    project "Benchmarks"
+        kind "ConsoleApp"
+        language "C++"
+		cppdialect "C++17"
+		systemversion "latest"
+        location "Benchmarks"
+        
+        -- Targets
+		targetdir ("Build/bin/" .. outputdir .. "/%{prj.name}")
+		objdir ("Build/bin-int/" .. outputdir .. "/%{prj.name}")
+		
+		--Includes
+		includedirs
+		{
+            "LambdaEngine/Include",
+            "%{prj.name}/Include",
+		}
+		
+		sysincludedirs
+		{
+			"Dependencies/glm",
+			"Dependencies/imgui",
+			"Dependencies/ordered-map/include",
+		}
+        
+        -- Files
+		files 
+		{
+			"%{prj.name}/**.h",
+			"%{prj.name}/**.cpp",
+		}
+		-- Linking
+		links 
+		{ 
+			"LambdaEngine",
+			"ImGui",
+		}
+    project "*"
+    -- LoadGenerator Project
+    project "LoadGenerator"
+        kind "ConsoleApp"
+        language "C++"
+		cppdialect "C++17"
+		systemversion "latest"
+        location "LoadGenerator"
+        
+        -- Targets
+		targetdir ("Build/bin/" .. outputdir .. "/%{prj.name}")
+		objdir ("Build/bin-int/" .. outputdir .. "/%{prj.name}")
+		
+		-- Bots run without window, renderer and audio
+		defines
+		{
+			"LAMBDA_HEADLESS",
+		}
+		
+		--Includes
+		includedirs
+		{
+            "LambdaEngine/Include",
+            "%{prj.name}/Include",
+		}
+		
+		sysincludedirs
+		{
+			"Dependencies/glm",
+			"Dependencies/imgui",
+			"Dependencies/ordered-map/include",
+		}
+        
+        -- Files
+		files 
+		{
+            "LambdaEngine/Source/Launch/**",
+			"%{prj.name}/**.h",
+			"%{prj.name}/**.cpp",
+		}
+		-- Linking
+		links 
+		{ 
+			"LambdaEngine",
+			"ImGui",
+		}
     project "*"
\ No newline at end of file